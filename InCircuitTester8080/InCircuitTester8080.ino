@@ -25,6 +25,7 @@
 #include <LiquidCrystal.h>
 #include <DFR_Key.h>
 #include <zutil.h>
+#include <EEPROM.h>
 
 #include <main.h>
 
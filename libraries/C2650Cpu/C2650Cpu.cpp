@@ -26,6 +26,7 @@
 #include "Error.h"
 #include "C2650Cpu.h"
 #include "PinMap.h"
+#include "CPinShortCheck.h"
 
 
 //
@@ -267,6 +268,19 @@ static const CONNECTION s_DBUS_iot[] = { {33, "DBUS0" },
                                          {27, "DBUS6" },
                                          {26, "DBUS7" } }; // 8 bits.
 
+//
+// The CPU output and bus pins checked for pin to pin shorts.
+// Power, clock and input pins driven by the board are excluded.
+//
+static const CONNECTION_GROUP s_pinShortCheck[] = { {&s_M_IO_o,     1},
+                                                    {&s_WRP_o,      1},
+                                                    {&s__RW_o,      1},
+                                                    {&s_OPREQ_o,    1},
+                                                    {&s_INTACK_o,   1},
+                                                    {&s_RUN_WAIT_o, 1},
+                                                    {s_ADR_ot,      ARRAYSIZE(s_ADR_ot)},
+                                                    {s_DBUS_iot,    ARRAYSIZE(s_DBUS_iot)} };
+
 
 C2650Cpu::C2650Cpu(
 ) : m_busADR(g_pinMap40DIL, s_ADR_ot, ARRAYSIZE(s_ADR_ot)),
@@ -371,6 +385,21 @@ C2650Cpu::check(
     // The data bus should be uncontended and pulled high.
     CHECK_BUS_VALUE_UINT8_EXIT(error, m_busDBUS, s_DBUS_iot, 0xFF);
 
+    // Look for pin to pin shorts on the probe socket.
+    {
+        CPinShortCheck pinShortCheck(g_pinMap40DIL, s_pinShortCheck, ARRAYSIZE(s_pinShortCheck));
+
+        error = pinShortCheck.check();
+
+        // The short check leaves the pins released so restore the idle state.
+        idle();
+
+        if (FAILED(error))
+        {
+            goto Exit;
+        }
+    }
+
     // Loop to detect a clock by sampling and detecting both high and lows.
     {
         UINT16 hiCount = 0;
@@ -464,6 +493,47 @@ C2650Cpu::memoryWrite(
 }
 
 
+//
+// Read with the data bus pre-charged high and then pre-charged low with the
+// pullups disabled. A bit that follows the pre-charge isn't being driven.
+//
+PERROR
+C2650Cpu::memoryReadFloating(
+    UINT32 address,
+    UINT16 *data,
+    UINT16 *floating
+)
+{
+    PERROR error = errorSuccess;
+    UINT16 dataLo = 0;
+
+    m_busDBUS.pinMode(OUTPUT);
+    m_busDBUS.digitalWrite(0xFF);
+    m_busDBUS.pinMode(INPUT);
+
+    error = memoryRead(address, data);
+
+    if (SUCCESS(error))
+    {
+        m_busDBUS.pinMode(OUTPUT);
+        m_busDBUS.digitalWrite(0x00);
+        m_busDBUS.pinMode(INPUT);
+
+        error = memoryRead(address, &dataLo);
+    }
+
+    // Return to the idle pulled high state.
+    m_busDBUS.pinMode(INPUT_PULLUP);
+
+    if (SUCCESS(error))
+    {
+        *floating = (*data ^ dataLo) & 0xFF;
+    }
+
+    return error;
+}
+
+
 //
 // This is the internal function that does a read cycle. The caller is expected
 // to set the M_IO pin to reflect the actual space being accessed.
@@ -840,3 +910,27 @@ C2650Cpu::acknowledgeInterrupt(
     return read(0, response);
 }
 
+
+//
+// Returns the probe connection for the logical address or data bus bit.
+//
+const CONNECTION *
+C2650Cpu::busConnection(
+    Bus   bus,
+    UINT8 bit
+)
+{
+    const CONNECTION *connection = (const CONNECTION *) NULL;
+
+    if ((bus == ADDRESS) && (bit < ARRAYSIZE(s_ADR_ot)))
+    {
+        connection = &s_ADR_ot[bit];
+    }
+    else if ((bus == DATA) && (bit < ARRAYSIZE(s_DBUS_iot)))
+    {
+        connection = &s_DBUS_iot[bit];
+    }
+
+    return connection;
+}
+
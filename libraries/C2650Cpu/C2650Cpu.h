@@ -94,6 +94,14 @@ class C2650Cpu : public ICpu
             UINT16 data
         );
 
+        virtual
+        PERROR
+        memoryReadFloating(
+            UINT32 address,
+            UINT16 *data,
+            UINT16 *floating
+        );
+
         virtual
         PERROR
         waitForInterrupt(
@@ -108,6 +116,13 @@ class C2650Cpu : public ICpu
             UINT16 *response
         );
 
+        virtual
+        const CONNECTION *
+        busConnection(
+            Bus   bus,
+            UINT8 bit
+        );
+
         //
         // C2650Cpu Interface
         //
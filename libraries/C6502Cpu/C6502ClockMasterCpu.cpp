@@ -27,12 +27,24 @@
 #include "C6502ClockMasterCpu.h"
 #include "PinMap.h"
 #include "6502PinDescription.h"
+#include "CPinShortCheck.h"
 
 //
 // External master clock on J14 AUX pin 8 (next to the 2-pin GND pin).
 //
 static const CONNECTION s_Clock_o    = {  8, "Clock"    };
 
+//
+// The CPU output and bus pins checked for pin to pin shorts.
+// Power, clock and input pins driven by the board are excluded. R/W is a
+// strobe so a write is never seen while phi2 is high.
+// The data bus is last so that it can be left out when not pulled high.
+//
+static const CONNECTION_GROUP s_pinShortCheck[] = { {&s_SYNC_o, 1},
+                                                    {&s_R_W_o,  1, true},
+                                                    {s_A_ot,    ARRAYSIZE(s_A_ot)},
+                                                    {s_D_iot,   ARRAYSIZE(s_D_iot)} };
+
 
 C6502ClockMasterCpu::C6502ClockMasterCpu(
     bool dataBusCheck
@@ -45,7 +57,10 @@ C6502ClockMasterCpu::C6502ClockMasterCpu(
     m_pinRDY(g_pinMap40DIL, &s_RDY_i),
     m_pinClock(g_pinMap8Aux, &s_Clock_o),
     m_valueCLK1o(-1), // Force initial state matching
-    m_valueCLK2o(-1)  // Force initial state matching
+    m_valueCLK2o(-1), // Force initial state matching
+    m_sampler(NULL),
+    m_burstPulses(0),
+    m_burstUs(0)
 {
 };
 
@@ -123,6 +138,22 @@ C6502ClockMasterCpu::check(
         CHECK_BUS_VALUE_UINT8_EXIT(error, m_busD, s_D_iot, 0xFF);
     }
 
+    // Look for pin to pin shorts on the probe socket.
+    {
+        UINT8 groupCount = ARRAYSIZE(s_pinShortCheck) - (m_dataBusCheck ? 0 : 1);
+        CPinShortCheck pinShortCheck(g_pinMap40DIL, s_pinShortCheck, groupCount);
+
+        error = pinShortCheck.check();
+
+        // The short check leaves the pins released so restore the idle state.
+        idle();
+
+        if (FAILED(error))
+        {
+            goto Exit;
+        }
+    }
+
     // Loop to detect that reset clears
     // On exit the reset pin should be high (no reset).
     //
@@ -370,6 +401,47 @@ C6502ClockMasterCpu::memoryWrite(
 }
 
 
+//
+// Read with the data bus pre-charged high and then pre-charged low with the
+// pullups disabled. A bit that follows the pre-charge isn't being driven.
+//
+PERROR
+C6502ClockMasterCpu::memoryReadFloating(
+    UINT32 address,
+    UINT16 *data,
+    UINT16 *floating
+)
+{
+    PERROR error = errorSuccess;
+    UINT16 dataLo = 0;
+
+    m_busD.pinMode(OUTPUT);
+    m_busD.digitalWrite(0xFF);
+    m_busD.pinMode(INPUT);
+
+    error = memoryRead(address, data);
+
+    if (SUCCESS(error))
+    {
+        m_busD.pinMode(OUTPUT);
+        m_busD.digitalWrite(0x00);
+        m_busD.pinMode(INPUT);
+
+        error = memoryRead(address, &dataLo);
+    }
+
+    // Return to the idle pulled high state.
+    m_busD.pinMode(INPUT_PULLUP);
+
+    if (SUCCESS(error))
+    {
+        *floating = (*data ^ dataLo) & 0xFF;
+    }
+
+    return error;
+}
+
+
 PERROR
 C6502ClockMasterCpu::waitForInterrupt(
     Interrupt interrupt,
@@ -393,6 +465,30 @@ C6502ClockMasterCpu::acknowledgeInterrupt(
 }
 
 
+//
+// Returns the probe connection for the logical address or data bus bit.
+//
+const CONNECTION *
+C6502ClockMasterCpu::busConnection(
+    Bus   bus,
+    UINT8 bit
+)
+{
+    const CONNECTION *connection = (const CONNECTION *) NULL;
+
+    if ((bus == ADDRESS) && (bit < ARRAYSIZE(s_A_ot)))
+    {
+        connection = &s_A_ot[bit];
+    }
+    else if ((bus == DATA) && (bit < ARRAYSIZE(s_D_iot)))
+    {
+        connection = &s_D_iot[bit];
+    }
+
+    return connection;
+}
+
+
 //
 // Pulse the clock pin high.
 // The 6502 outputs CLK1 & CLK2 based on the transition on the CLK0 input.
@@ -436,5 +532,109 @@ C6502ClockMasterCpu::clockPulse(
             m_pinCLK1o.digitalWrite(m_valueCLK1o);
         }
     }
+
+    if (m_sampler != NULL)
+    {
+        m_sampler->sample();
+    }
+}
+
+
+//
+// A single pulse of the burst, unrolled in clockBurst. It's the same as
+// clockPulse except the outputs are written on every pulse rather than only
+// on a change, which is quicker than tracking the state.
+//
+#define BURST_PULSE()                           \
+    m_pinClock.digitalWriteHIGH();              \
+    m_pinClock.digitalWriteLOW();               \
+    clk0 = m_pinCLK0i.digitalRead();            \
+    if (clk0 == HIGH)                           \
+    {                                           \
+        m_pinCLK1o.digitalWriteLOW();           \
+        m_pinCLK2o.digitalWriteHIGH();          \
+    }                                           \
+    else                                        \
+    {                                           \
+        m_pinCLK2o.digitalWriteLOW();           \
+        m_pinCLK1o.digitalWriteHIGH();          \
+    }
+
+void
+C6502ClockMasterCpu::clockBurst(
+    UINT16 count
+)
+{
+    UINT32 startUs = micros();
+
+    // Park the bus on a read of 0xFFFF.
+    m_busD.pinMode(INPUT);
+    digitalWrite(g_pinMap40DIL[s_R_W_o.pin], HIGH);
+    m_busA.pinMode(OUTPUT);
+    m_busA.digitalWrite(0xFFFF);
+
+    if (m_sampler != NULL)
+    {
+        for (UINT16 pulse = 0 ; pulse < count ; pulse++)
+        {
+            clockPulse();
+        }
+    }
+    else if (count != 0)
+    {
+        UINT16 blocks = count / 8;
+        int clk0 = LOW;
+
+        noInterrupts();
+
+        while (blocks-- != 0)
+        {
+            BURST_PULSE();
+            BURST_PULSE();
+            BURST_PULSE();
+            BURST_PULSE();
+            BURST_PULSE();
+            BURST_PULSE();
+            BURST_PULSE();
+            BURST_PULSE();
+        }
+
+        for (UINT8 pulse = (count % 8) ; pulse != 0 ; pulse--)
+        {
+            BURST_PULSE();
+        }
+
+        interrupts();
+
+        // Bring the internal state back in line with the outputs.
+        m_valueCLK1o = (clk0 == HIGH) ? LOW  : HIGH;
+        m_valueCLK2o = (clk0 == HIGH) ? HIGH : LOW;
+    }
+
+    m_burstPulses += count;
+    m_burstUs     += micros() - startUs;
+}
+
+
+UINT32
+C6502ClockMasterCpu::clockBurstKHz(
+)
+{
+    UINT32 ms = m_burstUs / 1000;
+    UINT32 kHz = (ms != 0) ? (m_burstPulses / ms) : 0;
+
+    m_burstPulses = 0;
+    m_burstUs = 0;
+
+    return kHz;
+}
+
+
+void
+C6502ClockMasterCpu::setSampler(
+    ISampler *sampler
+)
+{
+    m_sampler = sampler;
 }
 
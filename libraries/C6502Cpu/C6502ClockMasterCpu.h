@@ -30,6 +30,7 @@
 #include "CBus.h"
 #include "CFast8BitBus.h"
 #include "CFastPin.h"
+#include "ISampler.h"
 
 
 class C6502ClockMasterCpu : public ICpu
@@ -90,6 +91,14 @@ class C6502ClockMasterCpu : public ICpu
             UINT16 data
         );
 
+        virtual
+        PERROR
+        memoryReadFloating(
+            UINT32 address,
+            UINT16 *data,
+            UINT16 *floating
+        );
+
         virtual
         PERROR
         waitForInterrupt(
@@ -104,6 +113,13 @@ class C6502ClockMasterCpu : public ICpu
             UINT16 *response
         );
 
+        virtual
+        const CONNECTION *
+        busConnection(
+            Bus   bus,
+            UINT8 bit
+        );
+
         //
         // C6502ClockMasterCpu Interface
         //
@@ -112,6 +128,35 @@ class C6502ClockMasterCpu : public ICpu
         clockPulse(
         );
 
+        //
+        // Run the clock for count pulses as fast as possible with interrupts
+        // disabled and the bus parked on a read of 0xFFFF, following CLK0 with
+        // CLK1 & CLK2 as clockPulse() does. Any attached sampler is called
+        // once per pulse, as for clockPulse().
+        // Keep bursts well under 1ms so that millis() doesn't lose ticks.
+        //
+        void
+        clockBurst(
+            UINT16 count
+        );
+
+        //
+        // The average clock rate achieved by clockBurst() since the last
+        // call, in kHz.
+        //
+        UINT32
+        clockBurstKHz(
+        );
+
+        //
+        // When a sampler is attached (e.g. a capture or signature) it's
+        // called once per clockPulse(). Supply NULL to detach.
+        //
+        void
+        setSampler(
+            ISampler *sampler
+        );
+
     private:
 
         PERROR
@@ -139,6 +184,11 @@ class C6502ClockMasterCpu : public ICpu
         int           m_valueCLK1o;
         int           m_valueCLK2o;
 
+        ISampler     *m_sampler;
+
+        UINT32        m_burstPulses;
+        UINT32        m_burstUs;
+
 };
 
 #endif
@@ -27,6 +27,19 @@
 #include "C6502Cpu.h"
 #include "PinMap.h"
 #include "6502PinDescription.h"
+#include "CPinShortCheck.h"
+
+
+//
+// The CPU output and bus pins checked for pin to pin shorts.
+// Power, clock and input pins driven by the board are excluded. R/W is a
+// strobe so a write is never seen while phi2 is high.
+// The data bus is last so that it can be left out when not pulled high.
+//
+static const CONNECTION_GROUP s_pinShortCheck[] = { {&s_SYNC_o, 1},
+                                                    {&s_R_W_o,  1, true},
+                                                    {s_A_ot,    ARRAYSIZE(s_A_ot)},
+                                                    {s_D_iot,   ARRAYSIZE(s_D_iot)} };
 
 
 C6502Cpu::C6502Cpu(
@@ -118,6 +131,22 @@ C6502Cpu::check(
         CHECK_BUS_VALUE_UINT8_EXIT(error, m_busD, s_D_iot, 0xFF);
     }
 
+    // Look for pin to pin shorts on the probe socket.
+    {
+        UINT8 groupCount = ARRAYSIZE(s_pinShortCheck) - (m_dataBusCheck ? 0 : 1);
+        CPinShortCheck pinShortCheck(g_pinMap40DIL, s_pinShortCheck, groupCount);
+
+        error = pinShortCheck.check();
+
+        // The short check leaves the pins released so restore the idle state.
+        idle();
+
+        if (FAILED(error))
+        {
+            goto Exit;
+        }
+    }
+
     // Loop to detect a clock by sampling and detecting both high and lows.
     {
         UINT16 hiCount = 0;
@@ -259,6 +288,47 @@ Exit:
 }
 
 
+//
+// Read with the data bus pre-charged high and then pre-charged low with the
+// pullups disabled. A bit that follows the pre-charge isn't being driven.
+//
+PERROR
+C6502Cpu::memoryReadFloating(
+    UINT32 address,
+    UINT16 *data,
+    UINT16 *floating
+)
+{
+    PERROR error = errorSuccess;
+    UINT16 dataLo = 0;
+
+    m_busD.pinMode(OUTPUT);
+    m_busD.digitalWrite(0xFF);
+    m_busD.pinMode(INPUT);
+
+    error = memoryRead(address, data);
+
+    if (SUCCESS(error))
+    {
+        m_busD.pinMode(OUTPUT);
+        m_busD.digitalWrite(0x00);
+        m_busD.pinMode(INPUT);
+
+        error = memoryRead(address, &dataLo);
+    }
+
+    // Return to the idle pulled high state.
+    m_busD.pinMode(INPUT_PULLUP);
+
+    if (SUCCESS(error))
+    {
+        *floating = (*data ^ dataLo) & 0xFF;
+    }
+
+    return error;
+}
+
+
 
 PERROR
 C6502Cpu::waitForInterrupt(
@@ -311,3 +381,27 @@ C6502Cpu::acknowledgeInterrupt(
     return error;
 }
 
+
+//
+// Returns the probe connection for the logical address or data bus bit.
+//
+const CONNECTION *
+C6502Cpu::busConnection(
+    Bus   bus,
+    UINT8 bit
+)
+{
+    const CONNECTION *connection = (const CONNECTION *) NULL;
+
+    if ((bus == ADDRESS) && (bit < ARRAYSIZE(s_A_ot)))
+    {
+        connection = &s_A_ot[bit];
+    }
+    else if ((bus == DATA) && (bit < ARRAYSIZE(s_D_iot)))
+    {
+        connection = &s_D_iot[bit];
+    }
+
+    return connection;
+}
+
@@ -87,6 +87,14 @@ class C6502Cpu : public ICpu
             UINT16 data
         );
 
+        virtual
+        PERROR
+        memoryReadFloating(
+            UINT32 address,
+            UINT16 *data,
+            UINT16 *floating
+        );
+
         virtual
         PERROR
         waitForInterrupt(
@@ -101,6 +109,13 @@ class C6502Cpu : public ICpu
             UINT16 *response
         );
 
+        virtual
+        const CONNECTION *
+        busConnection(
+            Bus   bus,
+            UINT8 bit
+        );
+
         //
         // C6502Cpu Interface
         //
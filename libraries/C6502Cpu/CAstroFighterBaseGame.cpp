@@ -196,10 +196,7 @@ PERROR CAstroFighterBaseGame::delayFunction(
     // This *should* be aligned
     while (millis() < endTime)
     {
-        for (int x = 0 ; x < 64 ; x++)
-        {
-            cpu->clockPulse();
-        }
+        cpu->clockBurst(64);
     }
 
     // This is to bring clock alignment back to the start of a cycle
@@ -84,7 +84,10 @@ static const OUTPUT_REGION s_outputRegion[] PROGMEM = { //
 //
 // Custom functions implemented for this game.
 //
-static const CUSTOM_FUNCTION s_customFunction[] PROGMEM = {{NO_CUSTOM_FUNCTION}}; // end of list
+static const CUSTOM_FUNCTION s_customFunction[] PROGMEM = { //                                          "0123456789"
+                                                            {CVanguardBaseGame::testSignature,          "Signature "},
+                                                            {CVanguardBaseGame::testSignatureChannel,   "Sig Chan  "},
+                                                            {NO_CUSTOM_FUNCTION}}; // end of list
 
 //
 // Notes
@@ -107,7 +110,8 @@ CVanguardBaseGame::CVanguardBaseGame(
            s_inputRegion,
            s_outputRegion,
            s_customFunction,
-           CVanguardBaseGame::delayFunction)
+           CVanguardBaseGame::delayFunction),
+    m_signatureChannel(1)
 {
     m_cpu = new C6502ClockMasterCpu(false);
 
@@ -149,10 +153,7 @@ PERROR CVanguardBaseGame::delayFunction(
     // This *should* be aligned
     while (millis() < endTime)
     {
-        for (int x = 0 ; x < 64 ; x++)
-        {
-            cpu->clockPulse();
-        }
+        cpu->clockBurst(64);
     }
 
     // This is to bring clock alignment back to the start of a cycle
@@ -161,3 +162,49 @@ PERROR CVanguardBaseGame::delayFunction(
     return error;
 }
 
+
+//
+// Signature window in clocks.
+//
+static const UINT32 s_signatureClocks = 4096;
+
+//
+// Clock the board through the window and fold every aux pin into a signature.
+// Aux pin 1 is displayed, use "Sig Chan" to step through the others.
+//
+PERROR CVanguardBaseGame::testSignature(
+    void *context
+)
+{
+    CVanguardBaseGame *thisGame = (CVanguardBaseGame *) context;
+    C6502ClockMasterCpu *cpu = (C6502ClockMasterCpu *) thisGame->m_cpu;
+    CSignature *signature = &thisGame->m_signature;
+
+    // Aux pin 8 is the master clock output so isn't made an input.
+    signature->begin(0x7F, 0, true);
+    cpu->setSampler(signature);
+
+    for (UINT32 clock = 0 ; clock < s_signatureClocks ; clock++)
+    {
+        cpu->clockPulse();
+    }
+
+    cpu->setSampler(NULL);
+
+    thisGame->m_signatureChannel = 1;
+
+    return signature->result(thisGame->m_signatureChannel);
+}
+
+
+PERROR CVanguardBaseGame::testSignatureChannel(
+    void *context
+)
+{
+    CVanguardBaseGame *thisGame = (CVanguardBaseGame *) context;
+
+    thisGame->m_signatureChannel = (thisGame->m_signatureChannel % 7) + 1;
+
+    return thisGame->m_signature.result(thisGame->m_signatureChannel);
+}
+
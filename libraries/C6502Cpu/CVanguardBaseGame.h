@@ -26,6 +26,7 @@
 #define CVanguardBaseGame_h
 
 #include "CGame.h"
+#include "CSignature.h"
 
 
 class CVanguardBaseGame : public CGame
@@ -41,6 +42,14 @@ class CVanguardBaseGame : public CGame
             unsigned long ms
         );
 
+        static PERROR testSignature(
+            void *context
+        );
+
+        static PERROR testSignatureChannel(
+            void *context
+        );
+
     protected:
 
         CVanguardBaseGame(
@@ -50,6 +59,11 @@ class CVanguardBaseGame : public CGame
         ~CVanguardBaseGame(
         );
 
+    private:
+
+        CSignature m_signature;
+        UINT8      m_signatureChannel;
+
 };
 
 #endif
@@ -65,6 +65,26 @@ static const CONNECTION s__IPL2_i    = { 23, "_IPL2"    };
 static const CONNECTION s__IPL1_i    = { 24, "_IPL1"    };
 static const CONNECTION s__IPL0_i    = { 25, "_IPL0"    };
 
+//
+// Bus pins - only used for naming as the data bus is driven via the ports.
+//
+static const CONNECTION s_D_iot[] = { { 5, "D0"  },
+                                      { 4, "D1"  },
+                                      { 3, "D2"  },
+                                      { 2, "D3"  },
+                                      { 1, "D4"  },
+                                      {64, "D5"  },
+                                      {63, "D6"  },
+                                      {62, "D7"  },
+                                      {61, "D8"  },
+                                      {60, "D9"  },
+                                      {59, "D10" },
+                                      {58, "D11" },
+                                      {57, "D12" },
+                                      {56, "D13" },
+                                      {55, "D14" },
+                                      {54, "D15" } }; // 16 bits.
+
 //
 // Definitions for the processor function codes
 //
@@ -102,21 +122,35 @@ static const UINT32 s_vpaAddress = 0x04000000;
         }                                  \
     }                                      \
 
+//
+// Poll DTACK once, 2 instructions, 125ns.
+//
+#define POLL_DTACK(r1)                     \
+    {                                      \
+        r1 = *g_portInControlIn;           \
+                                           \
+        if (!(r1 & s_BIT_IN_DTACK))        \
+        {                                  \
+            break;                         \
+        }                                  \
+    }                                      \
+
 //
 // Wait for DTACK low.
-// This loop is 2 instructions total, 125ns.
-// Note that the system will hang here if DTACK is stuck.
+// The 2 instruction poll is unrolled 4 times per count of the 16-bit
+// count n so the count is only paid for once every 4 polls.
+// n is 0 if DTACK was never asserted. The 1024 poll (~150us) limit is far
+// beyond any board's wait states so it only guards against a hang if
+// DTACK is stuck.
 //
-#define WAIT_FOR_DTACK(x,r1,r2)            \
+#define WAIT_FOR_DTACK(x,r1,n)             \
     {                                      \
-        while(1)                           \
+        for (n = 256 ; n > 0 ; n--)        \
         {                                  \
-            r1 = *g_portInControlIn;       \
-                                           \
-            if (!(r1 & s_BIT_IN_DTACK))    \
-            {                              \
-                break;                     \
-            }                              \
+            POLL_DTACK(r1);                \
+            POLL_DTACK(r1);                \
+            POLL_DTACK(r1);                \
+            POLL_DTACK(r1);                \
         }                                  \
     }                                      \
 
@@ -365,6 +399,21 @@ C68000DedicatedCpu::memoryRead(
     UINT32 address,
     UINT16 *data
 )
+{
+    return readCycle(address, data, (const UINT8 *) NULL);
+}
+
+
+//
+// The address is latched through the lower data port so the pre-charge
+// can only be done after it.
+//
+PERROR
+C68000DedicatedCpu::readCycle(
+    UINT32      address,
+    UINT16      *data,
+    const UINT8 *precharge
+)
 {
     PERROR error = errorSuccess;
     bool   lo    = (address & 1) ? true : false;
@@ -383,6 +432,14 @@ C68000DedicatedCpu::memoryRead(
     {
         *g_dirDataLo = s_DIR_BYTE_INPUT;
 
+        if (precharge != NULL)
+        {
+            *g_portOutDataLo = *precharge;
+            *g_dirDataLo     = s_DIR_BYTE_OUTPUT;
+            *g_dirDataLo     = s_DIR_BYTE_INPUT;
+            *g_portOutDataLo = 0x00;
+        }
+
         if (vpa)
         {
             error = readWriteLoVPA(data);
@@ -396,6 +453,14 @@ C68000DedicatedCpu::memoryRead(
     {
         *g_dirDataHi = s_DIR_BYTE_INPUT;
 
+        if (precharge != NULL)
+        {
+            *g_portOutDataHi = *precharge;
+            *g_dirDataHi     = s_DIR_BYTE_OUTPUT;
+            *g_dirDataHi     = s_DIR_BYTE_INPUT;
+            *g_portOutDataHi = 0x00;
+        }
+
         if (vpa)
         {
             error = readWriteHiVPA(data);
@@ -479,6 +544,44 @@ Exit:
 }
 
 
+//
+// Read with the data bus pre-charged high and then pre-charged low with the
+// pullups disabled. A bit that follows the pre-charge isn't being driven.
+//
+PERROR
+C68000DedicatedCpu::memoryReadFloating(
+    UINT32 address,
+    UINT16 *data,
+    UINT16 *floating
+)
+{
+    PERROR error = errorSuccess;
+    UINT16 dataLo = 0;
+    bool   lo     = (address & 1) ? true : false;
+
+    volatile UINT8 *portOutData = lo ? g_portOutDataLo : g_portOutDataHi;
+    const UINT8    high         = 0xFF;
+    const UINT8    low          = 0x00;
+
+    error = readCycle(address, data, &high);
+
+    if (SUCCESS(error))
+    {
+        error = readCycle(address, &dataLo, &low);
+    }
+
+    // Return to the idle pulled high state.
+    *portOutData = s_PORT_BYTE_PULLUP;
+
+    if (SUCCESS(error))
+    {
+        *floating = (*data ^ dataLo) & 0xFF;
+    }
+
+    return error;
+}
+
+
 PERROR
 C68000DedicatedCpu::waitForInterrupt(
     Interrupt interrupt,
@@ -507,6 +610,29 @@ C68000DedicatedCpu::acknowledgeInterrupt(
 }
 
 
+//
+// Returns the probe connection for the logical address or data bus bit.
+//
+const CONNECTION *
+C68000DedicatedCpu::busConnection(
+    Bus   bus,
+    UINT8 bit
+)
+{
+    const CONNECTION *connection = (const CONNECTION *) NULL;
+
+    //
+    // The address bus is driven via latches and so is not on the probe.
+    //
+    if ((bus == DATA) && (bit < ARRAYSIZE(s_D_iot)))
+    {
+        connection = &s_D_iot[bit];
+    }
+
+    return connection;
+}
+
+
 PERROR
 C68000DedicatedCpu::readWriteLoDTACK(
     UINT16 *data
@@ -523,6 +649,8 @@ C68000DedicatedCpu::readWriteLoDTACK(
     register UINT8 r1;
     register UINT8 r2;
 
+    register UINT16 n;
+
     // Wait for the clock edge
     WAIT_FOR_CLK_EDGE(x,r1,r2);
 
@@ -531,7 +659,7 @@ C68000DedicatedCpu::readWriteLoDTACK(
     *g_portOutControlOutD = s_BYTE_OUT_IDLE_D ^ (s_BIT_OUT_AS | s_BIT_OUT_LDS); // Wait state
 
     // Wait for DTACK to be asserted
-    WAIT_FOR_DTACK(x,r1,r2);
+    WAIT_FOR_DTACK(x,r1,n);
 
     // Read in the data
     r1 = *g_portInDataLo;
@@ -540,7 +668,7 @@ C68000DedicatedCpu::readWriteLoDTACK(
     *g_portOutControlOutD = s_BYTE_OUT_IDLE_D;
 
     // Check for timeout
-    if (x == 0)
+    if ((x == 0) || (n == 0))
     {
         error = errorTimeout;
         goto Exit;
@@ -571,6 +699,8 @@ C68000DedicatedCpu::readWriteHiDTACK(
     register UINT8 r1;
     register UINT8 r2;
 
+    register UINT16 n;
+
     // Wait for the clock edge
     WAIT_FOR_CLK_EDGE(x,r1,r2);
 
@@ -579,7 +709,7 @@ C68000DedicatedCpu::readWriteHiDTACK(
     *g_portOutControlOutD = s_BYTE_OUT_IDLE_D ^ (s_BIT_OUT_AS | s_BIT_OUT_UDS); // Wait state
 
     // Wait for DTACK to be asserted
-    WAIT_FOR_DTACK(x,r1,r2);
+    WAIT_FOR_DTACK(x,r1,n);
 
     // Read in the data
     r1 = *g_portInDataHi;
@@ -588,7 +718,7 @@ C68000DedicatedCpu::readWriteHiDTACK(
     *g_portOutControlOutD = s_BYTE_OUT_IDLE_D;
 
     // Check for timeout
-    if (x == 0)
+    if ((x == 0) || (n == 0))
     {
         error = errorTimeout;
         goto Exit;
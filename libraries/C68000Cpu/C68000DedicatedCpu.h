@@ -77,6 +77,12 @@ class C68000DedicatedCpu : public ICpu
             UINT16 data
         );
 
+        virtual PERROR memoryReadFloating(
+            UINT32 address,
+            UINT16 *data,
+            UINT16 *floating
+        );
+
         virtual
         PERROR
         waitForInterrupt(
@@ -91,12 +97,30 @@ class C68000DedicatedCpu : public ICpu
             UINT16 *response
         );
 
+        virtual
+        const CONNECTION *
+        busConnection(
+            Bus   bus,
+            UINT8 bit
+        );
+
         //
         // C68000DedicatedCpu Interface
         //
 
     private:
 
+        //
+        // A read with the data lane optionally pre-charged (to the supplied
+        // level, with the pullups then disabled) once the address is latched.
+        //
+        PERROR
+        readCycle(
+            UINT32      address,
+            UINT16      *data,
+            const UINT8 *precharge
+        );
+
         PERROR
         outputAddress(
             UINT32 address,
@@ -27,6 +27,7 @@
 #include "C6809EClockMasterCpu.h"
 #include "C6809EPinOut.h"
 #include "PinMap.h"
+#include "CPinShortCheck.h"
 
 
 //
@@ -49,7 +50,10 @@ C6809EClockMasterCpu::C6809EClockMasterCpu(const C6809EPinOut *pinOut
     m_pinRW(g_pinMap40DIL, &pinOut->m_RW_o),
     m_pinE(g_pinMap40DIL, &pinOut->m_E_i),
     m_pinQ(g_pinMap40DIL, &pinOut->m_Q_i),
-    m_pinClock(g_pinMap8Aux, &s_Clock_o)
+    m_pinClock(g_pinMap8Aux, &s_Clock_o),
+    m_sampler(NULL),
+    m_burstPulses(0),
+    m_burstUs(0)
 {
 };
 
@@ -165,6 +169,31 @@ C6809EClockMasterCpu::check(
     //
     // CHECK_BUS_VALUE_UINT8_EXIT(error, m_busD, s_D_iot, 0xFF);
 
+    // Look for pin to pin shorts on the probe socket.
+    // The data bus is left out for the same reason as above.
+    // R/W is a strobe so a write is never seen while E is high.
+    {
+        const CONNECTION_GROUP groups[] = { {&m_pinOut->m_BS_o,   1},
+                                            {&m_pinOut->m_BA_o,   1},
+                                            {&m_pinOut->m_RW_o,   1, true},
+                                            {&m_pinOut->m_BUSY_o, 1},
+                                            {&m_pinOut->m_AVMA_o, 1},
+                                            {&m_pinOut->m_LIC_o,  1},
+                                            {m_pinOut->m_A_ot,    ARRAYSIZE(m_pinOut->m_A_ot)} };
+
+        CPinShortCheck pinShortCheck(g_pinMap40DIL, groups, ARRAYSIZE(groups));
+
+        error = pinShortCheck.check();
+
+        // The short check leaves the pins released so restore the idle state.
+        idle();
+
+        if (FAILED(error))
+        {
+            goto Exit;
+        }
+    }
+
     // Loop to detect that reset clears
     // On Star Wars this ~0x40000 (262,144) clocks.
     // On exit the reset pin should be high (no reset).
@@ -471,6 +500,47 @@ C6809EClockMasterCpu::memoryWrite(
 }
 
 
+//
+// Read with the data bus pre-charged high and then pre-charged low with the
+// pullups disabled. A bit that follows the pre-charge isn't being driven.
+//
+PERROR
+C6809EClockMasterCpu::memoryReadFloating(
+    UINT32 address,
+    UINT16 *data,
+    UINT16 *floating
+)
+{
+    PERROR error = errorSuccess;
+    UINT16 dataLo = 0;
+
+    m_busD.pinMode(OUTPUT);
+    m_busD.digitalWrite(0xFF);
+    m_busD.pinMode(INPUT);
+
+    error = memoryRead(address, data);
+
+    if (SUCCESS(error))
+    {
+        m_busD.pinMode(OUTPUT);
+        m_busD.digitalWrite(0x00);
+        m_busD.pinMode(INPUT);
+
+        error = memoryRead(address, &dataLo);
+    }
+
+    // Return to the idle pulled high state.
+    m_busD.pinMode(INPUT_PULLUP);
+
+    if (SUCCESS(error))
+    {
+        *floating = (*data ^ dataLo) & 0xFF;
+    }
+
+    return error;
+}
+
+
 PERROR
 C6809EClockMasterCpu::waitForInterrupt(
     Interrupt interrupt,
@@ -537,6 +607,30 @@ C6809EClockMasterCpu::acknowledgeInterrupt(
     return errorNotImplemented;
 }
 
+
+//
+// Returns the probe connection for the logical address or data bus bit.
+//
+const CONNECTION *
+C6809EClockMasterCpu::busConnection(
+    Bus   bus,
+    UINT8 bit
+)
+{
+    const CONNECTION *connection = (const CONNECTION *) NULL;
+
+    if ((bus == ADDRESS) && (bit < ARRAYSIZE(m_pinOut->m_A_ot)))
+    {
+        connection = &m_pinOut->m_A_ot[bit];
+    }
+    else if ((bus == DATA) && (bit < ARRAYSIZE(m_pinOut->m_D_iot)))
+    {
+        connection = &m_pinOut->m_D_iot[bit];
+    }
+
+    return connection;
+}
+
 //
 // Pulse the clock pin high.
 //
@@ -546,6 +640,93 @@ C6809EClockMasterCpu::clockPulse(
 {
     m_pinClock.digitalWriteHIGH();
     m_pinClock.digitalWriteLOW();
+
+    if (m_sampler != NULL)
+    {
+        m_sampler->sample();
+    }
+}
+
+
+//
+// A single pulse of the burst, unrolled in clockBurst.
+//
+#define BURST_PULSE() \
+    m_pinClock.digitalWriteHIGH(); \
+    m_pinClock.digitalWriteLOW();
+
+void
+C6809EClockMasterCpu::clockBurst(
+    UINT16 count
+)
+{
+    UINT32 startUs = micros();
+
+    // Park the bus on a read of 0xFFFF.
+    m_busD.pinMode(INPUT);
+    m_pinRW.digitalWriteHIGH();
+    m_pinBA.digitalWriteHIGH();
+    m_busA.pinMode(OUTPUT);
+    m_busA.digitalWrite(0xFFFF);
+
+    if (m_sampler != NULL)
+    {
+        for (UINT16 pulse = 0 ; pulse < count ; pulse++)
+        {
+            clockPulse();
+        }
+    }
+    else
+    {
+        UINT16 blocks = count / 8;
+
+        noInterrupts();
+
+        while (blocks-- != 0)
+        {
+            BURST_PULSE();
+            BURST_PULSE();
+            BURST_PULSE();
+            BURST_PULSE();
+            BURST_PULSE();
+            BURST_PULSE();
+            BURST_PULSE();
+            BURST_PULSE();
+        }
+
+        for (UINT8 pulse = (count % 8) ; pulse != 0 ; pulse--)
+        {
+            BURST_PULSE();
+        }
+
+        interrupts();
+    }
+
+    m_burstPulses += count;
+    m_burstUs     += micros() - startUs;
+}
+
+
+UINT32
+C6809EClockMasterCpu::clockBurstKHz(
+)
+{
+    UINT32 ms = m_burstUs / 1000;
+    UINT32 kHz = (ms != 0) ? (m_burstPulses / ms) : 0;
+
+    m_burstPulses = 0;
+    m_burstUs = 0;
+
+    return kHz;
+}
+
+
+void
+C6809EClockMasterCpu::setSampler(
+    ISampler *sampler
+)
+{
+    m_sampler = sampler;
 }
 
 
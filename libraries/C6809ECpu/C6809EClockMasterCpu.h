@@ -30,6 +30,7 @@
 #include "CFastBus.h"
 #include "CFast8BitBus.h"
 #include "CFastPin.h"
+#include "ISampler.h"
 #include "C6809EPinOut.h"
 
 
@@ -88,6 +89,14 @@ class C6809EClockMasterCpu : public ICpu
             UINT16 data
         );
 
+        virtual
+        PERROR
+        memoryReadFloating(
+            UINT32 address,
+            UINT16 *data,
+            UINT16 *floating
+        );
+
         virtual
         PERROR
         waitForInterrupt(
@@ -102,6 +111,13 @@ class C6809EClockMasterCpu : public ICpu
             UINT16 *response
         );
 
+        virtual
+        const CONNECTION *
+        busConnection(
+            Bus   bus,
+            UINT8 bit
+        );
+
         //
         // C6809EClockMasterCpu Interface
         //
@@ -110,6 +126,35 @@ class C6809EClockMasterCpu : public ICpu
         clockPulse(
         );
 
+        //
+        // Run the clock for count pulses as fast as possible with interrupts
+        // disabled and the bus parked on a read of 0xFFFF. E & Q are left
+        // to free-run so the next bus cycle re-aligns to them. Any attached
+        // sampler is called once per pulse, as for clockPulse().
+        // Keep bursts well under 1ms so that millis() doesn't lose ticks.
+        //
+        void
+        clockBurst(
+            UINT16 count
+        );
+
+        //
+        // The average clock rate achieved by clockBurst() since the last
+        // call, in kHz.
+        //
+        UINT32
+        clockBurstKHz(
+        );
+
+        //
+        // When a sampler is attached (e.g. a capture or signature) it's
+        // called once per clockPulse(). Supply NULL to detach.
+        //
+        void
+        setSampler(
+            ISampler *sampler
+        );
+
     private:
 
         PERROR
@@ -133,6 +178,11 @@ class C6809EClockMasterCpu : public ICpu
 
         CFastPin      m_pinClock;
 
+        ISampler     *m_sampler;
+
+        UINT32        m_burstPulses;
+        UINT32        m_burstUs;
+
 };
 
 #endif
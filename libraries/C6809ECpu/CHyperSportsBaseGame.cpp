@@ -236,6 +236,12 @@ CHyperSportsBaseGame::interruptCheck(
 }
 
 
+//
+// Clock pulses per burst, short enough to keep millis() ticking.
+//
+static const UINT16 s_delayBurstPulses = 256;
+
+
 // Note that this takes an ICpu as context
 static PERROR CHyperSportsBaseGame::delayFunction(
     void *context,
@@ -244,15 +250,20 @@ static PERROR CHyperSportsBaseGame::delayFunction(
 {
     C6809EClockMasterCpu *cpu = (C6809EClockMasterCpu *) context;
     PERROR error = errorSuccess;
-    UINT16 data;
 
     unsigned long startTime = millis();
     unsigned long endTime   = startTime + ms;
 
-    // Dummy read to run the clock
+    // Run the clock with the bus parked, until a key press aborts it.
     while (millis() < endTime)
     {
-        error = cpu->memoryRead(0xFFFF, &data);
+        if (g_abortRequested)
+        {
+            error = errorAborted;
+            break;
+        }
+
+        cpu->clockBurst(s_delayBurstPulses);
     }
 
     return error;
@@ -324,8 +335,22 @@ CHyperSportsBaseGame::runClock1m(
 )
 {
     CHyperSportsBaseGame *thisGame  = (CHyperSportsBaseGame *) cHyperSportsBaseGame;
-    ICpu                 *cpu       = (ICpu *) thisGame->m_cpu;
+    C6809EClockMasterCpu *cpu       = (C6809EClockMasterCpu *) thisGame->m_cpu;
+    PERROR error = errorSuccess;
+
+    cpu->clockBurstKHz();
+
+    error = delayFunction(cpu, 60 * 1000UL);
+
+    if (SUCCESS(error))
+    {
+        error = errorCustom;
+        error->code = ERROR_SUCCESS;
+        error->description = "OK:Clk ";
+        error->description += cpu->clockBurstKHz();
+        error->description += "kHz";
+    }
 
-    return delayFunction(cpu, 60 * 1000UL);
+    return error;
 }
 
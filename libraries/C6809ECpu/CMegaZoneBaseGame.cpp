@@ -218,6 +218,12 @@ CMegaZoneBaseGame::interruptCheck(
 }
 
 
+//
+// Clock pulses per burst, short enough to keep millis() ticking.
+//
+static const UINT16 s_delayBurstPulses = 256;
+
+
 // Note that this takes an ICpu as context
 static PERROR CMegaZoneBaseGame::delayFunction(
     void *context,
@@ -226,15 +232,20 @@ static PERROR CMegaZoneBaseGame::delayFunction(
 {
     C6809EClockMasterCpu *cpu = (C6809EClockMasterCpu *) context;
     PERROR error = errorSuccess;
-    UINT16 data;
 
     unsigned long startTime = millis();
     unsigned long endTime   = startTime + ms;
 
-    // Dummy read to run the clock
+    // Run the clock with the bus parked, until a key press aborts it.
     while (millis() < endTime)
     {
-        error = cpu->memoryRead(0xFFFF, &data);
+        if (g_abortRequested)
+        {
+            error = errorAborted;
+            break;
+        }
+
+        cpu->clockBurst(s_delayBurstPulses);
     }
 
     return error;
@@ -248,8 +259,22 @@ CMegaZoneBaseGame::runClock1m(
 )
 {
     CMegaZoneBaseGame *thisGame  = (CMegaZoneBaseGame *) cMegaZoneBaseGame;
-    ICpu                 *cpu       = (ICpu *) thisGame->m_cpu;
+    C6809EClockMasterCpu *cpu       = (C6809EClockMasterCpu *) thisGame->m_cpu;
+    PERROR error = errorSuccess;
+
+    cpu->clockBurstKHz();
 
-    return delayFunction(cpu, 60 * 1000UL);
+    error = delayFunction(cpu, 60 * 1000UL);
+
+    if (SUCCESS(error))
+    {
+        error = errorCustom;
+        error->code = ERROR_SUCCESS;
+        error->description = "OK:Clk ";
+        error->description += cpu->clockBurstKHz();
+        error->description += "kHz";
+    }
+
+    return error;
 }
 
@@ -24,6 +24,7 @@
 //
 #include "CStarWarsAvgBaseGame.h"
 #include "C6809EClockMasterCpu.h"
+#include "CStarWarsAvgModel.h"
 
 //
 // Notes
@@ -45,6 +46,9 @@ static const UINT32 c_AVG_RST_A   = 0x4620;
 static const UINT32 c_AVG_HALT_A  = 0x4320;
 static const UINT32 c_AVG_HALT_D  = 0x40;
 
+// Vector RAM base address
+static const UINT32 c_AVG_VRAM_A  = 0x0000;
+
 
 //
 // RAM region is the same for all versions.
@@ -85,6 +89,7 @@ static const RAM_REGION s_ramRegionWriteOnly[] PROGMEM = { {0} }; // end of list
 // Custom functions implemented for this game.
 //
 static const CUSTOM_FUNCTION s_customFunction[] PROGMEM = { //                                               "0123456789"
+                                                            {CStarWarsAvgBaseGame::testDisplayList,          "AVG Lists "},
                                                             {NO_CUSTOM_FUNCTION}}; // end of list
 
 
@@ -117,3 +122,279 @@ CStarWarsAvgBaseGame::~CStarWarsAvgBaseGame(
 }
 
 
+//
+// Longest display list used by the test, in words.
+//
+static const UINT16 s_maxListWords = 72;
+
+//
+// Limit on the words fetched by the model for a list that doesn't halt.
+//
+static const UINT16 s_maxListFetches = 256;
+
+//
+// Number of HALT polls before the AVG is considered hung. Each poll is
+// a single E cycle, about the same as one AVG state machine clock.
+//
+static const UINT16 s_haltTimeoutReads = 4096;
+
+//
+// Time spent running the display lists for the throughput figure.
+//
+static const unsigned long s_listTestMs = 1000;
+
+//
+// The test display lists. The first two are used for calibration.
+//
+typedef enum {
+    LIST_HALT,       // HALT
+    LIST_STAT,       // 64 x STAT/SCAL, HALT
+    LIST_JMP,        // JMP over 64 x STAT to HALT
+    LIST_JSR,        // JSR x 2 to 32 x STAT, RTS
+    LIST_NEST,       // JSR -> JSR -> 16 x STAT, RTS, RTS
+    LIST_COUNT
+} DisplayList;
+
+static const char *s_listName[] = {"HLT", "STA", "JMP", "JSR", "NST"};
+
+static UINT16
+buildList(
+    DisplayList  displayList,
+    UINT16       *list
+)
+{
+    UINT16 length = 0;
+
+    switch (displayList)
+    {
+        case LIST_HALT :
+        {
+            list[length++] = CStarWarsAvgModel::s_opHALT;
+            break;
+        }
+
+        case LIST_STAT :
+        case LIST_JMP :
+        {
+            if (displayList == LIST_JMP)
+            {
+                list[length++] = CStarWarsAvgModel::s_opJMP | 65;
+            }
+
+            for (int x = 0 ; x < 64 ; x++)
+            {
+                // Alternate STAT & SCAL, both decode as opcode 011.
+                list[length++] = (x & 1) ? 0x7000 : (CStarWarsAvgModel::s_opSTAT | 0x0080);
+            }
+
+            list[length++] = CStarWarsAvgModel::s_opHALT;
+            break;
+        }
+
+        case LIST_JSR :
+        {
+            list[length++] = CStarWarsAvgModel::s_opJSR | 4;
+            list[length++] = CStarWarsAvgModel::s_opJSR | 4;
+            list[length++] = CStarWarsAvgModel::s_opHALT;
+            list[length++] = CStarWarsAvgModel::s_opHALT;
+
+            for (int x = 0 ; x < 32 ; x++)
+            {
+                list[length++] = CStarWarsAvgModel::s_opSTAT | 0x0080;
+            }
+
+            list[length++] = CStarWarsAvgModel::s_opRTS;
+            break;
+        }
+
+        case LIST_NEST :
+        {
+            list[length++] = CStarWarsAvgModel::s_opJSR | 3;
+            list[length++] = CStarWarsAvgModel::s_opHALT;
+            list[length++] = CStarWarsAvgModel::s_opHALT;
+            list[length++] = CStarWarsAvgModel::s_opJSR | 6;
+            list[length++] = CStarWarsAvgModel::s_opRTS;
+            list[length++] = CStarWarsAvgModel::s_opHALT;
+
+            for (int x = 0 ; x < 16 ; x++)
+            {
+                list[length++] = CStarWarsAvgModel::s_opSTAT | 0x0080;
+            }
+
+            list[length++] = CStarWarsAvgModel::s_opRTS;
+            break;
+        }
+
+        default :
+        {
+            break;
+        }
+    }
+
+    return length;
+}
+
+
+//
+// Reset the AVG, load the list into vector RAM (big endian as written by the
+// 6809) and GO. The time to HALT is returned as the number of HALT polls.
+//
+PERROR
+CStarWarsAvgBaseGame::runList(
+    const UINT16 *list,
+    UINT16       length,
+    UINT16       *reads
+)
+{
+    PERROR error = errorSuccess;
+    UINT16 recData = 0;
+
+    *reads = 0;
+
+    CHECK_CPU_WRITE_EXIT(error, m_cpu, c_AVG_RST_A, 0);
+
+    for (UINT16 x = 0 ; x < length ; x++)
+    {
+        CHECK_CPU_WRITE_EXIT(error, m_cpu, c_AVG_VRAM_A + (x << 1) + 0, (list[x] >> 8) & 0xFF);
+        CHECK_CPU_WRITE_EXIT(error, m_cpu, c_AVG_VRAM_A + (x << 1) + 1, (list[x] >> 0) & 0xFF);
+    }
+
+    CHECK_CPU_WRITE_EXIT(error, m_cpu, c_AVG_GO_A, 0);
+
+    for (*reads = 1 ; *reads <= s_haltTimeoutReads ; (*reads)++)
+    {
+        CHECK_CPU_READ_EXIT(error, m_cpu, c_AVG_HALT_A, &recData);
+
+        if (recData & c_AVG_HALT_D)
+        {
+            break;
+        }
+    }
+
+    if (!(recData & c_AVG_HALT_D))
+    {
+        error = errorCustom;
+        error->code = ERROR_FAILED;
+        error->description = "E:AVG No HALT";
+    }
+
+Exit:
+    return error;
+}
+
+
+//
+// AVG Display List Test
+// ---------------------
+// Each list is run from GO to HALT and the time compared to the model. The
+// HALT only and STAT lists calibrate the GO to HALT latency and the time per
+// word fetched so the other lists check JMP, JSR & RTS decode and the return
+// stack. A decode fault changes the words fetched by a large margin, e.g. a
+// JMP that isn't taken fetches 64 extra words.
+//
+// 0123456789abcdef
+// OK:AVG 12/s        - All lists passed, 12 lists per second.
+// E:JMP 0005 0047    - JMP list expected 5 polls, took 0x47.
+// E:Cal 0002 0003    - HALT & STAT lists took 2 & 3 polls (AVG not running).
+// E:AVG No HALT      - The list didn't halt.
+//
+
+PERROR
+CStarWarsAvgBaseGame::testDisplayList(
+    void   *context
+)
+{
+    CStarWarsAvgBaseGame *thisGame = (CStarWarsAvgBaseGame *) context;
+    PERROR error = errorSuccess;
+    UINT16 list[s_maxListWords];
+    UINT16 length;
+    UINT16 haltReads;
+    UINT16 haltFetches;
+    UINT16 statReads;
+    UINT16 statFetches;
+    UINT16 wordReads16;
+    UINT32 lists = 0;
+    unsigned long startTime;
+
+    // Calibrate the GO to HALT latency & the time per word.
+    length = buildList(LIST_HALT, list);
+    haltFetches = CStarWarsAvgModel::fetches(list, length, s_maxListFetches);
+
+    error = thisGame->runList(list, length, &haltReads);
+    if (FAILED(error))
+    {
+        goto Exit;
+    }
+
+    length = buildList(LIST_STAT, list);
+    statFetches = CStarWarsAvgModel::fetches(list, length, s_maxListFetches);
+
+    error = thisGame->runList(list, length, &statReads);
+    if (FAILED(error))
+    {
+        goto Exit;
+    }
+
+    // Time per word in 1/16 polls. Expect a few AVG clocks per word.
+    wordReads16 = ((statReads - haltReads) * 16) / (statFetches - haltFetches);
+
+    if ((statReads <= haltReads) || (wordReads16 < 16) || (wordReads16 > (16 * 16)))
+    {
+        error = errorCustom;
+        error->code = ERROR_FAILED;
+        error->description = "E:Cal";
+        STRING_UINT16_HEX(error->description, haltReads);
+        STRING_UINT16_HEX(error->description, statReads);
+        goto Exit;
+    }
+
+    startTime = millis();
+
+    do
+    {
+        for (int displayList = LIST_JMP ; displayList < LIST_COUNT ; displayList++)
+        {
+            UINT16 fetches;
+            UINT16 expReads;
+            UINT16 recReads;
+            UINT16 tolerance;
+
+            length   = buildList((DisplayList) displayList, list);
+            fetches  = CStarWarsAvgModel::fetches(list, length, s_maxListFetches);
+            expReads = haltReads + (((fetches - haltFetches) * wordReads16) + 8) / 16;
+
+            // Allows for control flow words taking a few more clocks than STAT.
+            tolerance = (expReads / 8) + ((3 * wordReads16) / 16) + 2;
+
+            error = thisGame->runList(list, length, &recReads);
+            if (FAILED(error))
+            {
+                goto Exit;
+            }
+
+            if ((recReads + tolerance < expReads) || (recReads > expReads + tolerance))
+            {
+                error = errorCustom;
+                error->code = ERROR_FAILED;
+                error->description = "E:";
+                error->description += s_listName[displayList];
+                STRING_UINT16_HEX(error->description, expReads);
+                STRING_UINT16_HEX(error->description, recReads);
+                goto Exit;
+            }
+
+            lists++;
+        }
+    }
+    while ((millis() - startTime) < s_listTestMs);
+
+    error = errorCustom;
+    error->code = ERROR_SUCCESS;
+    error->description = "OK:AVG ";
+    error->description += (lists * 1000) / (millis() - startTime);
+    error->description += "/s";
+
+Exit:
+    return error;
+}
+
@@ -36,6 +36,10 @@ class CStarWarsAvgBaseGame : public CGame
         // CStarWarsAvgBaseGame
         //
 
+        static PERROR testDisplayList(
+            void   *context
+        );
+
     protected:
 
         CStarWarsAvgBaseGame(
@@ -47,6 +51,12 @@ class CStarWarsAvgBaseGame : public CGame
 
     private:
 
+        PERROR runList(
+            const UINT16 *list,
+            UINT16       length,
+            UINT16       *reads
+        );
+
 };
 
 #endif
@@ -0,0 +1,105 @@
+//
+// Copyright (c) 2021, Paul R. Swan
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+// OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR
+// TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+// EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+#include "CStarWarsAvgModel.h"
+
+
+UINT16
+CStarWarsAvgModel::fetches(
+    const UINT16 *list,
+    UINT16       length,
+    UINT16       maxFetches
+)
+{
+    UINT16 stack[s_stackDepth];
+    UINT16 stackPointer = 0;
+    UINT16 pc = 0;
+    UINT16 count = 0;
+
+    while (count < maxFetches)
+    {
+        UINT16 word;
+
+        if (pc >= length)
+        {
+            break;
+        }
+
+        word = list[pc++];
+        count++;
+
+        switch (word & s_opMask)
+        {
+            case s_opHALT :
+            {
+                return count;
+            }
+
+            case s_opVCTR :
+            {
+                // Long vector is 2 words.
+                pc++;
+                count++;
+                break;
+            }
+
+            case s_opJSR :
+            {
+                if (stackPointer >= s_stackDepth)
+                {
+                    return 0;
+                }
+
+                stack[stackPointer++] = pc;
+                pc = word & s_addressMask;
+                break;
+            }
+
+            case s_opRTS :
+            {
+                if (stackPointer == 0)
+                {
+                    return 0;
+                }
+
+                pc = stack[--stackPointer];
+                break;
+            }
+
+            case s_opJMP :
+            {
+                pc = word & s_addressMask;
+                break;
+            }
+
+            default :
+            {
+                // SVEC, STAT & CNTR are single words.
+                break;
+            }
+        }
+    }
+
+    return 0;
+}
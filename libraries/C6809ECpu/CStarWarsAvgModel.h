@@ -0,0 +1,84 @@
+//
+// Copyright (c) 2021, Paul R. Swan
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+// OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR
+// TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+// EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+#ifndef CStarWarsAvgModel_h
+#define CStarWarsAvgModel_h
+
+//
+// Plain C++ so the model can be built on a host for cross checking as well as
+// on the tester.
+//
+#ifdef ARDUINO
+#include "Types.h"
+#else
+typedef unsigned short UINT16;
+#endif
+
+//
+// Software model of the Star Wars AVG (analog vector generator) display list
+// execution used to generate the expected run time of a test list.
+//
+// Display list words are 16-bit with the opcode in the top 3 bits and jump
+// targets as word addresses from the start of vector RAM.
+//
+// The model follows the control flow of the list (JMP, JSR, RTS & HALT with the
+// 4 level AVG return stack) and counts the words fetched. Execution time is then
+// the GO to HALT latency plus a fixed time per word fetched, both calibrated on
+// the board. Vector drawing time depends on the analog ramp so VCTR & SVEC are
+// not used in test lists.
+//
+class CStarWarsAvgModel
+{
+    public:
+
+        static const UINT16 s_opVCTR = 0x0000;
+        static const UINT16 s_opHALT = 0x2000;
+        static const UINT16 s_opSVEC = 0x4000;
+        static const UINT16 s_opSTAT = 0x6000;
+        static const UINT16 s_opCNTR = 0x8000;
+        static const UINT16 s_opJSR  = 0xA000;
+        static const UINT16 s_opRTS  = 0xC000;
+        static const UINT16 s_opJMP  = 0xE000;
+
+        static const UINT16 s_opMask      = 0xE000;
+        static const UINT16 s_addressMask = 0x1FFF;
+
+        static const UINT16 s_stackDepth = 4;
+
+        //
+        // Run the list from word 0 to HALT and return the number of words
+        // fetched, including the HALT. Returns 0 if the list runs off the end,
+        // overflows the stack or doesn't halt within maxFetches.
+        //
+        static
+        UINT16
+        fetches(
+            const UINT16 *list,
+            UINT16       length,
+            UINT16       maxFetches
+        );
+
+};
+
+#endif
@@ -24,6 +24,7 @@
 //
 #include "CStarWarsBaseGame.h"
 #include "C6809EClockMasterCpu.h"
+#include "CStarWarsMathModel.h"
 
 //
 // Notes
@@ -145,10 +146,16 @@ static const CUSTOM_FUNCTION s_customFunction[] PROGMEM = { //
                                                             {CStarWarsBaseGame::test23,                      "DV Test 23"},
                                                             {CStarWarsBaseGame::test24,                      "DV Test 24"},
                                                             {CStarWarsBaseGame::test25,                      "DV Test 25"},
+                                                            {CStarWarsBaseGame::testMatrixRandom,            "MX Random "},
+                                                            {CStarWarsBaseGame::testDividerRandom,           "DV Random "},
                                                             {CStarWarsBaseGame::testRepeatLastMatrixProgram, "Repeat MX "},
                                                             {CStarWarsBaseGame::testRepeatLastDividerProgram,"Repeat DV "},
                                                             {CStarWarsBaseGame::testClockPulse,              "Clk Pulse "},
                                                             {CStarWarsBaseGame::testCapture,                 "Capture   "},
+                                                            {CStarWarsBaseGame::testCaptureVcd,              "Capture VC"},
+                                                            {CStarWarsBaseGame::testSignature,               "Signature "},
+                                                            {CStarWarsBaseGame::testSignatureGated,          "Sig Gated "},
+                                                            {CStarWarsBaseGame::testSignatureChannel,        "Sig Chan  "},
                                                             {NO_CUSTOM_FUNCTION}}; // end of list
 
 
@@ -164,7 +171,8 @@ CStarWarsBaseGame::CStarWarsBaseGame(
     m_clockPulseCount(0),
     m_lastMatrixProgramAddress(0),
     m_lastDivisorDataHi(0),
-    m_lastDivisorDataLo(0)
+    m_lastDivisorDataLo(0),
+    m_signatureChannel(1)
 {
     m_cpu = new C6809EClockMasterCpu();
     m_cpu->idle();
@@ -254,26 +262,23 @@ Exit:
 }
 
 
+//
+// Load the source words, preset the result words and run the matrix program to completion.
+//
 PERROR
-CStarWarsBaseGame::testMatrix(
-    void   *context,
+CStarWarsBaseGame::runMatrix(
     int    srcDataLength,
     UINT32 *srcDataAddress,
     UINT16 *srcData,
     int    expDataLength,
     UINT32 *expDataAddress,
-    UINT16 *expData,
     UINT16 programAddress
 )
 {
-    CStarWarsBaseGame *thisGame = (CStarWarsBaseGame *) context;
-    ICpu *cpu = thisGame->m_cpu;
     PERROR error = errorSuccess;
-    UINT16 recData;
-    UINT16 recResult = 0;
 
     // Make sure the matrix processor is idle
-    error = thisGame->waitForMathRunLo();
+    error = waitForMathRunLo();
     if (FAILED(error))
     {
         goto Exit;
@@ -282,24 +287,73 @@ CStarWarsBaseGame::testMatrix(
     // Load the source data words
     for (int x = 0 ; x < srcDataLength ; x++)
     {
-        CHECK_CPU_WRITE_EXIT(error, cpu, c_MBRAM_A + (srcDataAddress[x] << 1) | 0, (srcData[x] >> 8) & 0xFF);
-        CHECK_CPU_WRITE_EXIT(error, cpu, c_MBRAM_A + (srcDataAddress[x] << 1) | 1, (srcData[x] >> 0) & 0xFF);
+        CHECK_CPU_WRITE_EXIT(error, m_cpu, c_MBRAM_A + (srcDataAddress[x] << 1) | 0, (srcData[x] >> 8) & 0xFF);
+        CHECK_CPU_WRITE_EXIT(error, m_cpu, c_MBRAM_A + (srcDataAddress[x] << 1) | 1, (srcData[x] >> 0) & 0xFF);
     }
 
     // Make sure the result words are set to something so we know something happened
     for (int x = 0 ; x < expDataLength ; x++)
     {
-        CHECK_CPU_WRITE_EXIT(error, cpu, c_MBRAM_A + (expDataAddress[x] << 1) | 0, 0x12);
-        CHECK_CPU_WRITE_EXIT(error, cpu, c_MBRAM_A + (expDataAddress[x] << 1) | 1, 0x34);
+        CHECK_CPU_WRITE_EXIT(error, m_cpu, c_MBRAM_A + (expDataAddress[x] << 1) | 0, 0x12);
+        CHECK_CPU_WRITE_EXIT(error, m_cpu, c_MBRAM_A + (expDataAddress[x] << 1) | 1, 0x34);
     }
 
     // Write the program address to start
-    CHECK_CPU_WRITE_EXIT(error, cpu, c_MW0_A, (programAddress >> 2) & 0xFF);
-    thisGame->m_lastMatrixProgramAddress = programAddress;
-    thisGame->m_clockPulseCount = 0;
+    CHECK_CPU_WRITE_EXIT(error, m_cpu, c_MW0_A, (programAddress >> 2) & 0xFF);
+    m_lastMatrixProgramAddress = programAddress;
+    m_clockPulseCount = 0;
 
     // Wait for the matrix processor to become idle again.
-    error = thisGame->waitForMathRunLo();
+    error = waitForMathRunLo();
+
+Exit:
+    return error;
+}
+
+
+PERROR
+CStarWarsBaseGame::readMatrixWord(
+    UINT32 address,
+    UINT16 *data
+)
+{
+    PERROR error = errorSuccess;
+    UINT16 recData;
+
+    *data = 0;
+
+    CHECK_CPU_READ_EXIT(error, m_cpu, c_MBRAM_A + (address << 1) | 0, &recData);
+    *data |= (recData << 8);
+    CHECK_CPU_READ_EXIT(error, m_cpu, c_MBRAM_A + (address << 1) | 1, &recData);
+    *data |= (recData << 0);
+
+Exit:
+    return error;
+}
+
+
+PERROR
+CStarWarsBaseGame::testMatrix(
+    void   *context,
+    int    srcDataLength,
+    UINT32 *srcDataAddress,
+    UINT16 *srcData,
+    int    expDataLength,
+    UINT32 *expDataAddress,
+    UINT16 *expData,
+    UINT16 programAddress
+)
+{
+    CStarWarsBaseGame *thisGame = (CStarWarsBaseGame *) context;
+    PERROR error = errorSuccess;
+    UINT16 recResult = 0;
+
+    error = thisGame->runMatrix(srcDataLength,
+                                srcDataAddress,
+                                srcData,
+                                expDataLength,
+                                expDataAddress,
+                                programAddress);
     if (FAILED(error))
     {
         goto Exit;
@@ -308,12 +362,11 @@ CStarWarsBaseGame::testMatrix(
     // Check all the result words
     for (int x = 0 ; x < expDataLength ; x++)
     {
-        recResult = 0;
-
-        CHECK_CPU_READ_EXIT(error, cpu, c_MBRAM_A + (expDataAddress[x] << 1) | 0, &recData);
-        recResult |= (recData << 8);
-        CHECK_CPU_READ_EXIT(error, cpu, c_MBRAM_A + (expDataAddress[x] << 1) | 1, &recData);
-        recResult |= (recData << 0);
+        error = thisGame->readMatrixWord(expDataAddress[x], &recResult);
+        if (FAILED(error))
+        {
+            goto Exit;
+        }
 
         CHECK_UINT16_VALUE_EXIT(error, "MX", recResult, expData[x]);
     }
@@ -323,33 +376,34 @@ Exit:
 }
 
 
+//
+// Load the dividend & divisor to start the divider and read back the quotient.
+//
 PERROR
-CStarWarsBaseGame::testDivider(
-    void   *context,
+CStarWarsBaseGame::runDivider(
     UINT16 dividend,
     UINT16 divisor,
-    UINT16 quotient
+    UINT16 *quotient
 )
 {
-    CStarWarsBaseGame *thisGame = (CStarWarsBaseGame *) context;
-    ICpu *cpu = thisGame->m_cpu;
     PERROR error = errorSuccess;
     UINT16 recData;
-    UINT16 recQuotient = 0;
+
+    *quotient = 0;
 
     // Load dividend
-    CHECK_CPU_WRITE_EXIT(error, cpu, c_DVDDH_A, (dividend >> 8) & 0xFF);
-    CHECK_CPU_WRITE_EXIT(error, cpu, c_DVDDL_A, (dividend >> 0) & 0xFF);
+    CHECK_CPU_WRITE_EXIT(error, m_cpu, c_DVDDH_A, (dividend >> 8) & 0xFF);
+    CHECK_CPU_WRITE_EXIT(error, m_cpu, c_DVDDL_A, (dividend >> 0) & 0xFF);
 
     // Load divisor
-    CHECK_CPU_WRITE_EXIT(error, cpu, c_DVSRH_A, (divisor >> 8) & 0xFF);
-    CHECK_CPU_WRITE_EXIT(error, cpu, c_DVSRL_A, (divisor >> 0) & 0xFF);
+    CHECK_CPU_WRITE_EXIT(error, m_cpu, c_DVSRH_A, (divisor >> 8) & 0xFF);
+    CHECK_CPU_WRITE_EXIT(error, m_cpu, c_DVSRL_A, (divisor >> 0) & 0xFF);
 
     // Keep the trigger information for step & capture testing
-    thisGame->m_lastDivisorDataHi = (divisor >> 8) & 0xFF;
-    thisGame->m_lastDivisorDataLo = (divisor >> 0) & 0xFF;
+    m_lastDivisorDataHi = (divisor >> 8) & 0xFF;
+    m_lastDivisorDataLo = (divisor >> 0) & 0xFF;
 
-    thisGame->m_clockPulseCount = 0;
+    m_clockPulseCount = 0;
 
     // Wait for a few clocks.
     // There is no indication to the CPU that the divide is actually complete,
@@ -361,14 +415,37 @@ CStarWarsBaseGame::testDivider(
     //
     for (int x = 0 ; x < 16 ; x++)
     {
-        CHECK_CPU_READ_EXIT(error, cpu, 0xFFFF, &recData);
+        CHECK_CPU_READ_EXIT(error, m_cpu, 0xFFFF, &recData);
     }
 
     // Read quotient
-    CHECK_CPU_READ_EXIT(error, cpu, c_REH_A, &recData);
-    recQuotient |= (recData << 8);
-    CHECK_CPU_READ_EXIT(error, cpu, c_REL_A, &recData);
-    recQuotient |= (recData << 0);
+    CHECK_CPU_READ_EXIT(error, m_cpu, c_REH_A, &recData);
+    *quotient |= (recData << 8);
+    CHECK_CPU_READ_EXIT(error, m_cpu, c_REL_A, &recData);
+    *quotient |= (recData << 0);
+
+Exit:
+    return error;
+}
+
+
+PERROR
+CStarWarsBaseGame::testDivider(
+    void   *context,
+    UINT16 dividend,
+    UINT16 divisor,
+    UINT16 quotient
+)
+{
+    CStarWarsBaseGame *thisGame = (CStarWarsBaseGame *) context;
+    PERROR error = errorSuccess;
+    UINT16 recQuotient = 0;
+
+    error = thisGame->runDivider(dividend, divisor, &recQuotient);
+    if (FAILED(error))
+    {
+        goto Exit;
+    }
 
     // Check the result is what we expect
     CHECK_UINT16_VALUE_EXIT(error, "DV", recQuotient, quotient);
@@ -400,10 +477,7 @@ CStarWarsBaseGame::testADC(
         //  12MHz === 83.33ns
         //  116us/83.33ns = 1,392 clock pulses.
         //
-        for (int x = 0 ; x < 1392 ; x++)
-        {
-            cpu->clockPulse();
-        }
+        cpu->clockBurst(1392);
 
         CHECK_CPU_READ_EXIT(error, cpu, c_ADC_A, &data[channel]);
     }
@@ -628,6 +702,184 @@ CStarWarsBaseGame::test25(
 }
 
 
+//
+// Time spent running random vectors for each press.
+//
+static const unsigned long s_randomTestMs = 2000;
+
+//
+// Random Matrix Test
+// ------------------
+// Random source words are run through the copy and subtract/multiply matrix
+// programs and checked against the model. The operands are limited to +/-0.5
+// and the multiplier to +/-1.33 (0x5555) so no word is larger than those of
+// the fixed vectors, which the model reproduces (see test/).
+//
+// 0123456789abcdef
+// OK:MX 123/s        - All passed, 123 vectors per second.
+// E:MX CP 1234       - First failing copy source word.
+// E:1234-5678*c000   - First failing (1234 - 5678) * c000 operands.
+//
+
+PERROR
+CStarWarsBaseGame::testMatrixRandom(
+    void   *context
+)
+{
+    CStarWarsBaseGame *thisGame = (CStarWarsBaseGame *) context;
+    PERROR error = errorSuccess;
+    unsigned long startTime = millis();
+    UINT32 vectors = 0;
+
+    randomSeed(micros());
+
+    while ((millis() - startTime) < s_randomTestMs)
+    {
+        UINT32 srcAddress[] = {0x00,   0x0C,   0x0D,   0x0E  };
+        UINT16 srcData[]    = {0x0000, 0x0000, 0x0000, 0x0000};
+        UINT32 expAddress[] = {0x01  };
+        UINT16 expData      = 0;
+        UINT16 recData      = 0;
+
+        // Copy, word 0x00 -> 0x01
+        srcData[0] = (UINT16) random(0x10000);
+        expData    = CStarWarsMathModel::copy(srcData[0]);
+
+        error = thisGame->runMatrix(1, &srcAddress[0], &srcData[0],
+                                    1, &expAddress[0],
+                                    CStarWarsMathModel::s_programCopy);
+        if (FAILED(error))
+        {
+            goto Exit;
+        }
+
+        error = thisGame->readMatrixWord(expAddress[0], &recData);
+        if (FAILED(error))
+        {
+            goto Exit;
+        }
+
+        if (recData != expData)
+        {
+            error = errorCustom;
+            error->code = ERROR_FAILED;
+            error->description = "E:MX CP";
+            STRING_UINT16_HEX(error->description, srcData[0]);
+            goto Exit;
+        }
+
+        // Subtract & multiply, (word 0x0C - word 0x0D) * word 0x0E -> 0x00
+        srcData[1] = (UINT16) random(-0x2000, 0x2000);
+        srcData[2] = (UINT16) random(-0x2000, 0x2000);
+        srcData[3] = (UINT16) random(-0x5555, 0x5556);
+        expAddress[0] = 0x00;
+        expData = CStarWarsMathModel::subMultiply(srcData[1], srcData[2], srcData[3]);
+
+        error = thisGame->runMatrix(3, &srcAddress[1], &srcData[1],
+                                    1, &expAddress[0],
+                                    CStarWarsMathModel::s_programSubMultiply);
+        if (FAILED(error))
+        {
+            goto Exit;
+        }
+
+        error = thisGame->readMatrixWord(expAddress[0], &recData);
+        if (FAILED(error))
+        {
+            goto Exit;
+        }
+
+        if (recData != expData)
+        {
+            CHAR formatted[10];
+
+            // The hex is formatted with a leading space that's skipped to fit.
+            error = errorCustom;
+            error->code = ERROR_FAILED;
+            error->description = "E:";
+            error->description += formatHex(formatted, srcData[1], 4) + 1;
+            error->description += "-";
+            error->description += formatHex(formatted, srcData[2], 4) + 1;
+            error->description += "*";
+            error->description += formatHex(formatted, srcData[3], 4) + 1;
+            goto Exit;
+        }
+
+        vectors += 2;
+    }
+
+    error = errorCustom;
+    error->code = ERROR_SUCCESS;
+    error->description = "OK:MX ";
+    error->description += (vectors * 1000) / s_randomTestMs;
+    error->description += "/s";
+
+Exit:
+    return error;
+}
+
+
+//
+// Random Divider Test
+// -------------------
+// Random operands are divided and checked against the model. The dividend is
+// limited to less than twice the divisor so the quotient fits the 15 quotient
+// bits.
+//
+// 0123456789abcdef
+// OK:DV 123/s        - All passed, 123 vectors per second.
+// E:DV 5555 2aaa     - First failing dividend & divisor.
+//
+
+PERROR
+CStarWarsBaseGame::testDividerRandom(
+    void   *context
+)
+{
+    CStarWarsBaseGame *thisGame = (CStarWarsBaseGame *) context;
+    PERROR error = errorSuccess;
+    unsigned long startTime = millis();
+    UINT32 vectors = 0;
+
+    randomSeed(micros());
+
+    while ((millis() - startTime) < s_randomTestMs)
+    {
+        UINT16 divisor  = (UINT16) random(1, 0x8000);
+        UINT16 dividend = (UINT16) random((long) divisor * 2);
+        UINT16 expQuotient = CStarWarsMathModel::divide(dividend, divisor);
+        UINT16 recQuotient = 0;
+
+        error = thisGame->runDivider(dividend, divisor, &recQuotient);
+        if (FAILED(error))
+        {
+            goto Exit;
+        }
+
+        if (recQuotient != expQuotient)
+        {
+            error = errorCustom;
+            error->code = ERROR_FAILED;
+            error->description = "E:DV";
+            STRING_UINT16_HEX(error->description, dividend);
+            STRING_UINT16_HEX(error->description, divisor);
+            goto Exit;
+        }
+
+        vectors++;
+    }
+
+    error = errorCustom;
+    error->code = ERROR_SUCCESS;
+    error->description = "OK:DV ";
+    error->description += (vectors * 1000) / s_randomTestMs;
+    error->description += "/s";
+
+Exit:
+    return error;
+}
+
+
 PERROR
 CStarWarsBaseGame::testRepeatLastMatrixProgram(
     void   *context
@@ -686,7 +938,7 @@ CStarWarsBaseGame::testClockPulse(
 
     errorCustom->code = ERROR_SUCCESS;
     errorCustom->description = "OK: Count ";
-    errorCustom->description += String(thisGame->m_clockPulseCount, DEC);
+    errorCustom->description += thisGame->m_clockPulseCount;
 
     return error;
 }
@@ -695,6 +947,7 @@ CStarWarsBaseGame::testClockPulse(
 // Prototype signal capture
 //
 #include "PinMap.h"
+#include "CCapture.h"
 
 //
 // External capture input on J14 AUX pin 1.
@@ -750,3 +1003,122 @@ CStarWarsBaseGame::testCapture(
 }
 
 
+//
+// Number of clocks in a VCD capture.
+//
+static const UINT32 s_captureVcdClocks = 4096;
+
+//
+// 8 Channel Signal Capture
+// ------------------------
+// Capture aux pins 1 -> 7 (and the clock on aux pin 8) for every clock and export
+// the result on the serial port as a VCD file for viewing in a host logic viewer.
+//
+
+PERROR
+CStarWarsBaseGame::testCaptureVcd(
+    void   *context
+)
+{
+    CStarWarsBaseGame *thisGame = (CStarWarsBaseGame *) context;
+    C6809EClockMasterCpu *cpu = (C6809EClockMasterCpu *) thisGame->m_cpu;
+    PERROR error = errorSuccess;
+
+    // Aux pin 8 is the master clock output so isn't made an input.
+    CCapture capture(0x7F);
+
+    capture.reset(0);
+    cpu->setSampler(&capture);
+
+    for (UINT32 clock = 0 ; clock < s_captureVcdClocks ; clock++)
+    {
+        cpu->clockPulse();
+        thisGame->m_clockPulseCount++;
+    }
+
+    cpu->setSampler(NULL);
+
+    error = capture.exportSerial();
+
+    return error;
+}
+
+
+//
+// Signature window for the ungated signature and the longest gated window.
+//
+static const UINT32 s_signatureClocks    = 4096;
+static const UINT32 s_signatureMaxClocks = 0x10000;
+
+//
+// The gated signature window START & STOP edge is the rising edge on aux pin 7.
+//
+static const UINT8 s_signatureGateChannel = 7;
+
+//
+// Signature Analysis
+// ------------------
+// Clock the board through the window and fold every aux pin into a signature.
+// Aux pin 1 is displayed, use "Sig Chan" to step through the others.
+//
+
+PERROR
+CStarWarsBaseGame::testSignature(
+    void   *context
+)
+{
+    return testSignatureWindow(context, 0);
+}
+
+
+PERROR
+CStarWarsBaseGame::testSignatureGated(
+    void   *context
+)
+{
+    return testSignatureWindow(context, s_signatureGateChannel);
+}
+
+
+PERROR
+CStarWarsBaseGame::testSignatureChannel(
+    void   *context
+)
+{
+    CStarWarsBaseGame *thisGame = (CStarWarsBaseGame *) context;
+
+    // Aux pin 8 is the master clock output so it's not stepped through.
+    thisGame->m_signatureChannel = (thisGame->m_signatureChannel % 7) + 1;
+
+    return thisGame->m_signature.result(thisGame->m_signatureChannel);
+}
+
+
+PERROR
+CStarWarsBaseGame::testSignatureWindow(
+    void   *context,
+    UINT8  gateChannel
+)
+{
+    CStarWarsBaseGame *thisGame = (CStarWarsBaseGame *) context;
+    C6809EClockMasterCpu *cpu = (C6809EClockMasterCpu *) thisGame->m_cpu;
+    CSignature *signature = &thisGame->m_signature;
+    UINT32 clocks = (gateChannel == 0) ? s_signatureClocks : s_signatureMaxClocks;
+
+    // Aux pin 8 is the master clock output so isn't made an input.
+    signature->begin(0x7F, gateChannel, true);
+    cpu->setSampler(signature);
+
+    for (UINT32 clock = 0 ; (clock < clocks) && !signature->done() ; clock++)
+    {
+        cpu->clockPulse();
+        thisGame->m_clockPulseCount++;
+    }
+
+    cpu->setSampler(NULL);
+
+    thisGame->m_signatureChannel = 1;
+
+    return signature->result(thisGame->m_signatureChannel);
+}
+
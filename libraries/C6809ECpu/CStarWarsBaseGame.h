@@ -26,6 +26,7 @@
 #define CStarWarsBaseGame_h
 
 #include "CGame.h"
+#include "CSignature.h"
 
 
 class CStarWarsBaseGame : public CGame
@@ -115,6 +116,14 @@ class CStarWarsBaseGame : public CGame
             void   *context
         );
 
+        static PERROR testMatrixRandom(
+            void   *context
+        );
+
+        static PERROR testDividerRandom(
+            void   *context
+        );
+
         static PERROR testRepeatLastMatrixProgram(
             void   *context
         );
@@ -131,6 +140,22 @@ class CStarWarsBaseGame : public CGame
             void   *context
         );
 
+        static PERROR testCaptureVcd(
+            void   *context
+        );
+
+        static PERROR testSignature(
+            void   *context
+        );
+
+        static PERROR testSignatureGated(
+            void   *context
+        );
+
+        static PERROR testSignatureChannel(
+            void   *context
+        );
+
     protected:
 
         CStarWarsBaseGame(
@@ -145,6 +170,26 @@ class CStarWarsBaseGame : public CGame
         PERROR waitForMathRunLo(
         );
 
+        PERROR runMatrix(
+            int    srcDataLength,
+            UINT32 *srcDataAddress,
+            UINT16 *srcData,
+            int    expDataLength,
+            UINT32 *expDataAddress,
+            UINT16 programAddress
+        );
+
+        PERROR readMatrixWord(
+            UINT32 address,
+            UINT16 *data
+        );
+
+        PERROR runDivider(
+            UINT16 dividend,
+            UINT16 divisor,
+            UINT16 *quotient
+        );
+
         static PERROR testMatrix(
             void   *context,
             int    srcDataLength,
@@ -163,12 +208,20 @@ class CStarWarsBaseGame : public CGame
             UINT16 quotient
         );
 
+        static PERROR testSignatureWindow(
+            void   *context,
+            UINT8  gateChannel
+        );
+
         UINT32 m_clockPulseCount;
         UINT16 m_lastMatrixProgramAddress;
 
         UINT16 m_lastDivisorDataHi;
         UINT16 m_lastDivisorDataLo;
 
+        CSignature m_signature;
+        UINT8      m_signatureChannel;
+
 };
 
 #endif
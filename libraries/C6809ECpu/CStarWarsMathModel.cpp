@@ -0,0 +1,85 @@
+//
+// Copyright (c) 2021, Paul R. Swan
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+// OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR
+// TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+// EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+#include "CStarWarsMathModel.h"
+
+
+UINT16
+CStarWarsMathModel::copy(
+    UINT16 source
+)
+{
+    return source;
+}
+
+
+//
+// The multiplier result is taken from the product bits 14 -> 29 which is an
+// arithmetic shift (truncation towards minus infinity).
+//
+UINT16
+CStarWarsMathModel::subMultiply(
+    UINT16 minuend,
+    UINT16 subtrahend,
+    UINT16 multiplier
+)
+{
+    INT32 difference = (INT32) (INT16) minuend - (INT32) (INT16) subtrahend;
+    INT32 product    = difference * (INT32) (INT16) multiplier;
+
+    return (UINT16) (product >> 14);
+}
+
+
+//
+// Each step the divisor is added in 2's complement (inverted with carry in)
+// to the dividend shift register and the carry out is the next quotient bit.
+// On a carry the sum replaces the shift register contents before it's shifted.
+//
+UINT16
+CStarWarsMathModel::divide(
+    UINT16 dividend,
+    UINT16 divisor
+)
+{
+    UINT16 shift    = dividend;
+    UINT16 quotient = 0;
+
+    for (int step = 0 ; step < 15 ; step++)
+    {
+        INT32 sum = (INT32) shift + (INT32) ((UINT16) ~divisor) + 1;
+
+        quotient <<= 1;
+
+        if (sum & 0x10000)
+        {
+            quotient |= 1;
+            shift = (UINT16) sum;
+        }
+
+        shift <<= 1;
+    }
+
+    return quotient;
+}
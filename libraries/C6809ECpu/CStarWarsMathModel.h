@@ -0,0 +1,95 @@
+//
+// Copyright (c) 2021, Paul R. Swan
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+// OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR
+// TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+// EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+#ifndef CStarWarsMathModel_h
+#define CStarWarsMathModel_h
+
+//
+// Plain C++ so the model can be built on a host for cross checking as well as
+// on the tester.
+//
+#ifdef ARDUINO
+#include "Types.h"
+#else
+typedef signed short   INT16;
+typedef signed long    INT32;
+typedef unsigned short UINT16;
+#endif
+
+//
+// Software model of the Star Wars math box matrix processor programs and the
+// REH/REL divider used to generate expected results for random test vectors.
+//
+// Matrix words are 16-bit signed fixed point with 14 fractional bits, i.e.
+// 0x4000 is +1.0 and 0xC000 is -1.0.
+//
+// The matrix processor microcode is in the math box PROMs so only the test
+// programs that have been characterized against a working board are modelled.
+// test/CStarWarsMathModelTest.cpp checks the model gives the results of the
+// fixed test vectors.
+//
+class CStarWarsMathModel
+{
+    public:
+
+        //
+        // Matrix program that copies word 0x00 into word 0x01.
+        //
+        static const UINT16 s_programCopy = 0x170;
+
+        //
+        // Matrix program that writes (word 0x0C - word 0x0D) * word 0x0E into word 0x00.
+        //
+        static const UINT16 s_programSubMultiply = 0x174;
+
+        static
+        UINT16
+        copy(
+            UINT16 source
+        );
+
+        static
+        UINT16
+        subMultiply(
+            UINT16 minuend,
+            UINT16 subtrahend,
+            UINT16 multiplier
+        );
+
+        //
+        // The 15 step restoring divider (dividend * 0x4000) / divisor.
+        // The quotient register is 16-bit and the dividend shift register
+        // drops the carry, as in the hardware, so the result is only the true
+        // quotient when dividend < (2 * divisor) and divisor < 0x8000.
+        //
+        static
+        UINT16
+        divide(
+            UINT16 dividend,
+            UINT16 divisor
+        );
+
+};
+
+#endif
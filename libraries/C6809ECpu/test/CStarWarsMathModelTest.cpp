@@ -0,0 +1,200 @@
+//
+// Copyright (c) 2021, Paul R. Swan
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+// OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR
+// TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+// EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//
+//
+// Host test of CStarWarsMathModel, e.g.
+//
+//   make -C libraries/C6809ECpu/test
+//
+// The model has to give the results of the fixed vectors of test15 -> test25
+// in CStarWarsBaseGame, which pass on a working board, before it can be
+// trusted for the random vectors. test10 -> test14 only run their programs
+// and have no expected words.
+//
+// The ranges of the random matrix test are then checked to stay within what
+// the fixed vectors exercise, i.e. no word larger than the +/-1.33 (0x5555)
+// they pass through the subtract & multiply.
+//
+#include "CStarWarsMathModel.h"
+#include <stdio.h>
+
+#define ARRAYSIZE(x) (sizeof(x) / sizeof(x[0]))
+
+typedef struct _MATRIX_VECTOR {
+
+    const char *name;
+    UINT16     program;
+    UINT16     source[3];
+    UINT16     expected;
+
+} MATRIX_VECTOR;
+
+typedef struct _DIVIDER_VECTOR {
+
+    const char *name;
+    UINT16     dividend;
+    UINT16     divisor;
+    UINT16     expected;
+
+} DIVIDER_VECTOR;
+
+//
+// As in CStarWarsBaseGame. The copy source is word 0x00 and the subtract &
+// multiply sources are words 0x0C, 0x0D & 0x0E.
+//
+static const MATRIX_VECTOR s_matrixVector[] = { {"test15", CStarWarsMathModel::s_programCopy,        {0x5555},                 0x5555},
+                                                {"test16", CStarWarsMathModel::s_programCopy,        {0xAAAA},                 0xAAAA},
+                                                {"test17", CStarWarsMathModel::s_programSubMultiply, {0x5555, 0x0000, 0x4000}, 0x5555},
+                                                {"test18", CStarWarsMathModel::s_programSubMultiply, {0x0000, 0x5555, 0xC000}, 0x5555},
+                                                {"test19", CStarWarsMathModel::s_programSubMultiply, {0x2AAA, 0x0000, 0x4000}, 0x2AAA},
+                                                {"test20", CStarWarsMathModel::s_programSubMultiply, {0x0000, 0x2AAA, 0xC000}, 0x2AAA} };
+
+static const DIVIDER_VECTOR s_dividerVector[] = { {"test21", 0x4000, 0x4000, 0x4000},
+                                                  {"test22", 0x5555, 0x4000, 0x5555},
+                                                  {"test23", 0x2AAA, 0x4000, 0x2AAA},
+                                                  {"test24", 0x2AAA, 0x2AAA, 0x4000},
+                                                  {"test25", 0x5555, 0x5555, 0x4000} };
+
+//
+// The ranges of CStarWarsBaseGame::testMatrixRandom, inclusive.
+//
+static const INT32 s_operandMin    = -0x2000;
+static const INT32 s_operandMax    =  0x1FFF;
+static const INT32 s_multiplierMin = -0x5555;
+static const INT32 s_multiplierMax =  0x5555;
+
+//
+// The largest word magnitude of the fixed vectors.
+//
+static const INT32 s_resultMax = 0x5555;
+
+static int s_failures = 0;
+
+
+static
+void
+report(
+    const char *name,
+    UINT16     received,
+    UINT16     expected
+)
+{
+    printf("%s %s: %04x expected %04x\n",
+           (received == expected) ? "PASS" : "FAIL", name, received, expected);
+
+    if (received != expected)
+    {
+        s_failures++;
+    }
+}
+
+
+static
+void
+testFixedVectors(
+)
+{
+    for (unsigned int index = 0 ; index < ARRAYSIZE(s_matrixVector) ; index++)
+    {
+        const MATRIX_VECTOR *vector = &s_matrixVector[index];
+        UINT16 received;
+
+        if (vector->program == CStarWarsMathModel::s_programCopy)
+        {
+            received = CStarWarsMathModel::copy(vector->source[0]);
+        }
+        else
+        {
+            received = CStarWarsMathModel::subMultiply(vector->source[0],
+                                                       vector->source[1],
+                                                       vector->source[2]);
+        }
+
+        report(vector->name, received, vector->expected);
+    }
+
+    for (unsigned int index = 0 ; index < ARRAYSIZE(s_dividerVector) ; index++)
+    {
+        const DIVIDER_VECTOR *vector = &s_dividerVector[index];
+
+        report(vector->name,
+               CStarWarsMathModel::divide(vector->dividend, vector->divisor),
+               vector->expected);
+    }
+}
+
+
+//
+// The result magnitude is largest at the corners of the ranges.
+//
+static
+void
+testRandomRange(
+)
+{
+    const INT32 operand[]    = {s_operandMin, s_operandMax};
+    const INT32 multiplier[] = {s_multiplierMin, s_multiplierMax};
+    INT32 largest = 0;
+
+    for (int minuend = 0 ; minuend < 2 ; minuend++)
+    {
+        for (int subtrahend = 0 ; subtrahend < 2 ; subtrahend++)
+        {
+            for (int sign = 0 ; sign < 2 ; sign++)
+            {
+                INT16 result = (INT16) CStarWarsMathModel::subMultiply((UINT16) operand[minuend],
+                                                                       (UINT16) operand[subtrahend],
+                                                                       (UINT16) multiplier[sign]);
+                INT32 magnitude = (result < 0) ? -result : result;
+
+                if (magnitude > largest)
+                {
+                    largest = magnitude;
+                }
+            }
+        }
+    }
+
+    printf("%s random range: largest result %04x, fixed vectors %04x\n",
+           (largest <= s_resultMax) ? "PASS" : "FAIL", (unsigned int) largest, (unsigned int) s_resultMax);
+
+    if (largest > s_resultMax)
+    {
+        s_failures++;
+    }
+}
+
+
+int
+main(
+)
+{
+    testFixedVectors();
+    testRandomRange();
+
+    printf("%d failure(s)\n", s_failures);
+
+    return (s_failures == 0) ? 0 : 1;
+}
@@ -48,6 +48,35 @@ static const CONNECTION s_INT_i     = { 14, "INT"      };
 static const CONNECTION s_INTE_o    = { 16, "INTE"     };
 static const CONNECTION s_Vcc_i     = { 20, "Vcc"      };
 
+//
+// Bus pins - only used for naming as the buses are driven via the ports.
+//
+static const CONNECTION s_A_ot[]   = { {25, "A0"  },
+                                       {26, "A1"  },
+                                       {27, "A2"  },
+                                       {29, "A3"  },
+                                       {30, "A4"  },
+                                       {31, "A5"  },
+                                       {32, "A6"  },
+                                       {33, "A7"  },
+                                       {34, "A8"  },
+                                       {35, "A9"  },
+                                       { 1, "A10" },
+                                       {40, "A11" },
+                                       {37, "A12" },
+                                       {38, "A13" },
+                                       {39, "A14" },
+                                       {36, "A15" } }; // 16 bits
+
+static const CONNECTION s_D_iot[] = { {10, "D0" },
+                                      { 9, "D1" },
+                                      { 8, "D2" },
+                                      { 7, "D3" },
+                                      { 3, "D4" },
+                                      { 4, "D5" },
+                                      { 5, "D6" },
+                                      { 6, "D7" } }; // 8 bits.
+
 //
 // Definitions for the processor state byte output during the
 // SYNC phase.
@@ -497,6 +526,21 @@ Exit:
 }
 
 
+//
+// The data bus carries the status byte at the start of every cycle so it can't be
+// pre-charged independently of the cycle.
+//
+PERROR
+C8080DedicatedCpu::memoryReadFloating(
+    UINT32 address,
+    UINT16 *data,
+    UINT16 *floating
+)
+{
+    return errorNotImplemented;
+}
+
+
 PERROR
 C8080DedicatedCpu::waitForInterrupt(
     Interrupt interrupt,
@@ -548,3 +592,27 @@ C8080DedicatedCpu::acknowledgeInterrupt(
     return error;
 }
 
+
+//
+// Returns the probe connection for the logical address or data bus bit.
+//
+const CONNECTION *
+C8080DedicatedCpu::busConnection(
+    Bus   bus,
+    UINT8 bit
+)
+{
+    const CONNECTION *connection = (const CONNECTION *) NULL;
+
+    if ((bus == ADDRESS) && (bit < ARRAYSIZE(s_A_ot)))
+    {
+        connection = &s_A_ot[bit];
+    }
+    else if ((bus == DATA) && (bit < ARRAYSIZE(s_D_iot)))
+    {
+        connection = &s_D_iot[bit];
+    }
+
+    return connection;
+}
+
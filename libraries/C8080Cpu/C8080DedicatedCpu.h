@@ -74,6 +74,12 @@ class C8080DedicatedCpu : public ICpu
             UINT16 data
         );
 
+        virtual PERROR memoryReadFloating(
+            UINT32 address,
+            UINT16 *data,
+            UINT16 *floating
+        );
+
         virtual
         PERROR
         waitForInterrupt(
@@ -88,6 +94,13 @@ class C8080DedicatedCpu : public ICpu
             UINT16 *response
         );
 
+        virtual
+        const CONNECTION *
+        busConnection(
+            Bus   bus,
+            UINT8 bit
+        );
+
         //
         // C8080DedicatedCpu Interface
         //
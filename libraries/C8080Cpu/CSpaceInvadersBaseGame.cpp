@@ -131,6 +131,7 @@ static const OUTPUT_REGION s_outputRegion[] PROGMEM = { //
 //
 static const CUSTOM_FUNCTION s_customFunction[] PROGMEM = { //                                            "0123456789"
                                                             {CSpaceInvadersBaseGame::testShifter,         "Test Shift"},
+                                                            {CSpaceInvadersBaseGame::testShifterAll,      "Shift All "},
                                                             {NO_CUSTOM_FUNCTION}}; // end of list
 
 
@@ -240,3 +241,131 @@ CSpaceInvadersBaseGame::testShifter(
 Exit:
     return error;
 }
+
+
+//
+// Write the next data byte and check the result against the 16-bit value
+// formed with the previous data byte.
+//
+// A failure reports the result bit (Q, the MB14241 output or the discrete
+// shifter's output multiplexer) and the shift register bit (D, the data
+// latch) that feeds it at this count.
+//
+// 0123456789abcdef
+// E:Q3 D12 08 00
+//
+static
+PERROR
+shiftNext(
+    ICpu  *cpu,
+    UINT8 count,
+    UINT8 data,
+    UINT8 *previous
+)
+{
+    PERROR error = errorSuccess;
+    UINT16 shiftData = ((UINT16) data << 8) | *previous;
+    UINT16 shiftExpResult = (shiftData >> (count + 1)) & 0xFF;
+    UINT16 shiftRecResult;
+
+    CHECK_CPU_WRITE_EXIT(error, cpu, s_shifterData, data);
+    CHECK_CPU_READ_EXIT(error, cpu, s_shifterResult, &shiftRecResult);
+
+    *previous = data;
+
+    shiftRecResult &= 0xFF;
+
+    if (shiftRecResult != shiftExpResult)
+    {
+        UINT8 lane = 0;
+
+        while (!((shiftRecResult ^ shiftExpResult) & (1 << lane)))
+        {
+            lane++;
+        }
+
+        error = errorCustom;
+        error->code = ERROR_FAILED;
+        error->description = "E:Q";
+        error->description += lane;
+        error->description += " D";
+        error->description += (lane + count + 1);
+        STRING_UINT8_HEX(error->description, shiftExpResult);
+        STRING_UINT8_HEX(error->description, shiftRecResult);
+    }
+
+Exit:
+    return error;
+}
+
+
+//
+// Test every pair of data bytes for every shift count.
+//
+// The shift register always holds the last two bytes written so the bytes
+// are written as a de Bruijn sequence, where every byte written forms a new
+// pair with the byte before it. That's one write and one read per state
+// rather than two writes. The sequence is built from the Lyndon words
+// (i) and (i, j) for j > i in order and is cyclic, so it's primed with the
+// final byte.
+//
+// 0123456789abcdef
+// OK:Sh 1234/s
+//
+PERROR
+CSpaceInvadersBaseGame::testShifterAll(
+    void *context
+)
+{
+    CSpaceInvadersBaseGame *thisGame = (CSpaceInvadersBaseGame *) context;
+    ICpu *cpu = thisGame->m_cpu;
+    PERROR error = errorSuccess;
+    UINT32 startTime = millis();
+    UINT8 previous = 0;
+
+    for (UINT8 shiftCount = 0 ; shiftCount < 8 ; shiftCount++)
+    {
+        CHECK_CPU_WRITE_EXIT(error, cpu, s_shifterCount, (~shiftCount & 0x7));
+        CHECK_CPU_WRITE_EXIT(error, cpu, s_shifterData, 0xFF);
+
+        previous = 0xFF;
+
+        for (UINT16 i = 0 ; i < 0x100 ; i++)
+        {
+            error = shiftNext(cpu, shiftCount, (UINT8) i, &previous);
+            if (FAILED(error))
+            {
+                goto Exit;
+            }
+
+            for (UINT16 j = i + 1 ; j < 0x100 ; j++)
+            {
+                error = shiftNext(cpu, shiftCount, (UINT8) i, &previous);
+                if (FAILED(error))
+                {
+                    goto Exit;
+                }
+
+                error = shiftNext(cpu, shiftCount, (UINT8) j, &previous);
+                if (FAILED(error))
+                {
+                    goto Exit;
+                }
+            }
+        }
+    }
+
+    {
+        UINT32 elapsedMs = millis() - startTime;
+        UINT32 perSecond = (8UL * 0x10000UL * 1000UL) / ((elapsedMs != 0) ? elapsedMs : 1);
+
+        error = errorCustom;
+        error->code = ERROR_SUCCESS;
+        error->description = "OK:Sh ";
+        error->description += perSecond;
+        error->description += "/s";
+    }
+
+Exit:
+    return error;
+}
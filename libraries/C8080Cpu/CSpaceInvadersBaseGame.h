@@ -46,6 +46,13 @@ class CSpaceInvadersBaseGame : public CGame
             void *context
         );
 
+        //
+        // Custom function to test every shifter state for every shift count
+        //
+        static PERROR testShifterAll(
+            void *context
+        );
+
     protected:
 
         CSpaceInvadersBaseGame(
@@ -26,6 +26,7 @@
 #include "Error.h"
 #include "C8085Cpu.h"
 #include "PinMap.h"
+#include "CPinShortCheck.h"
 
 
 //
@@ -89,6 +90,24 @@ static const CONNECTION s_AD_iot[] = { {12, "AD0" },
                                        {18, "AD6" },
                                        {19, "AD7" } }; // 8 bits.
 
+//
+// The CPU output and bus pins checked for pin to pin shorts.
+// Power, clock and input pins driven by the board are excluded. /RD, /WR
+// & /INTA are strobes so the board never drives the bus in response.
+//
+static const CONNECTION_GROUP s_pinShortCheck[] = { {&s_RESOUT_o, 1},
+                                                    {&s_SOD_o,    1},
+                                                    {&s__INTA_o,  1, true},
+                                                    {&s_S0_o,     1},
+                                                    {&s_ALE_o,    1},
+                                                    {&s__WR_ot,   1, true},
+                                                    {&s__RD_ot,   1, true},
+                                                    {&s_S1_o,     1},
+                                                    {&s_IO_M_ot,  1},
+                                                    {&s_HLDA_o,   1},
+                                                    {s_A_ot,      ARRAYSIZE(s_A_ot)},
+                                                    {s_AD_iot,    ARRAYSIZE(s_AD_iot)} };
+
 
 C8085Cpu::C8085Cpu(
 ) : m_busA(g_pinMap40DIL, s_A_ot,  ARRAYSIZE(s_A_ot)),
@@ -208,6 +227,21 @@ C8085Cpu::check(
     // The address/data bus should be uncontended and pulled high.
     CHECK_BUS_VALUE_UINT8_EXIT(error, m_busAD, s_AD_iot, 0xFF);
 
+    // Look for pin to pin shorts on the probe socket.
+    {
+        CPinShortCheck pinShortCheck(g_pinMap40DIL, s_pinShortCheck, ARRAYSIZE(s_pinShortCheck));
+
+        error = pinShortCheck.check();
+
+        // The short check leaves the pins released so restore the idle state.
+        idle();
+
+        if (FAILED(error))
+        {
+            goto Exit;
+        }
+    }
+
     // Loop to detect a clock by sampling and detecting both high and lows.
     {
         UINT16 hiCount = 0;
@@ -398,6 +432,21 @@ C8085Cpu::memoryWrite(
 }
 
 
+//
+// The data bus is multiplexed with the low address byte (AD0-AD7) so it can't be
+// pre-charged independently of the cycle.
+//
+PERROR
+C8085Cpu::memoryReadFloating(
+    UINT32 address,
+    UINT16 *data,
+    UINT16 *floating
+)
+{
+    return errorNotImplemented;
+}
+
+
 PERROR
 C8085Cpu::waitForInterrupt(
     Interrupt interrupt,
@@ -450,3 +499,33 @@ C8085Cpu::acknowledgeInterrupt(
     return error;
 }
 
+
+//
+// Returns the probe connection for the logical address or data bus bit.
+//
+const CONNECTION *
+C8085Cpu::busConnection(
+    Bus   bus,
+    UINT8 bit
+)
+{
+    const CONNECTION *connection = (const CONNECTION *) NULL;
+
+    //
+    // The lower address byte is multiplexed with the data bus.
+    //
+    if ((bus == ADDRESS) && (bit >= ARRAYSIZE(s_AD_iot)))
+    {
+        if ((bit - ARRAYSIZE(s_AD_iot)) < ARRAYSIZE(s_A_ot))
+        {
+            connection = &s_A_ot[bit - ARRAYSIZE(s_AD_iot)];
+        }
+    }
+    else if (bit < ARRAYSIZE(s_AD_iot))
+    {
+        connection = &s_AD_iot[bit];
+    }
+
+    return connection;
+}
+
@@ -78,6 +78,12 @@ class C8085Cpu : public ICpu
             UINT16 data
         );
 
+        virtual PERROR memoryReadFloating(
+            UINT32 address,
+            UINT16 *data,
+            UINT16 *floating
+        );
+
         virtual
         PERROR
         waitForInterrupt(
@@ -92,6 +98,13 @@ class C8085Cpu : public ICpu
             UINT16 *response
         );
 
+        virtual
+        const CONNECTION *
+        busConnection(
+            Bus   bus,
+            UINT8 bit
+        );
+
         //
         // C8085Cpu Interface
         //
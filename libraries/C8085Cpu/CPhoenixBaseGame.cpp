@@ -24,6 +24,7 @@
 //
 #include "CPhoenixBaseGame.h"
 #include "C8085Cpu.h"
+#include "CToneCheck.h"
 
 //
 // Probe Head GND:
@@ -132,7 +133,22 @@ static const OUTPUT_REGION s_outputRegion[] PROGMEM = { //
 //
 // Custom functions implemented for this game.
 //
-static const CUSTOM_FUNCTION s_customFunction[] PROGMEM = { {NO_CUSTOM_FUNCTION}}; // end of list
+static const CUSTOM_FUNCTION s_customFunction[] PROGMEM = { //                            "0123456789"
+                                                            {CPhoenixBaseGame::soundToneA, "Tone A    "},
+                                                            {CPhoenixBaseGame::soundToneB, "Tone B    "},
+                                                            {NO_CUSTOM_FUNCTION}}; // end of list
+
+//
+// Half octave filter bank used to find the dominant frequency of the discrete
+// sound effect generators. The generators are analog so there's no exact
+// expected frequency to check - the result is compared to a known good board.
+//
+static const UINT16 s_toneBankHz[] = {350, 500, 700, 1000, 1400, 2000};
+
+//
+// Time for the sound effect to start after the latch is written.
+//
+static const UINT16 s_toneSettleMs = 100;
 
 
 CPhoenixBaseGame::CPhoenixBaseGame(
@@ -218,3 +234,83 @@ CPhoenixBaseGame::onBankSwitchVRamBank2(
     return error;
 }
 
+
+PERROR
+CPhoenixBaseGame::soundToneA(
+    void *cPhoenixBaseGame
+)
+{
+    CPhoenixBaseGame *thisGame = (CPhoenixBaseGame *) cPhoenixBaseGame;
+
+    return thisGame->soundTone(0x6000, 0x18, 'A');
+}
+
+
+PERROR
+CPhoenixBaseGame::soundToneB(
+    void *cPhoenixBaseGame
+)
+{
+    CPhoenixBaseGame *thisGame = (CPhoenixBaseGame *) cPhoenixBaseGame;
+
+    return thisGame->soundTone(0x6800, 0x18, 'B');
+}
+
+
+//
+// Play the tone of a sound effect generator and report the dominant frequency
+// measured on the AUX1 audio input. Fails only if there's no output at all.
+//
+// 0123456789abcdef
+// OK:A 1400Hz 63%
+// E:A Quiet
+//
+PERROR
+CPhoenixBaseGame::soundTone(
+    UINT32 address,
+    UINT8  data,
+    char   effect
+)
+{
+    PERROR error = errorSuccess;
+    CToneCheck toneCheck;
+
+    error = m_cpu->memoryWrite(address, data);
+
+    if (SUCCESS(error))
+    {
+        delay(s_toneSettleMs);
+
+        toneCheck.measure(s_toneBankHz, ARRAYSIZE(s_toneBankHz));
+
+        error = m_cpu->memoryWrite(address, 0x0F);
+    }
+
+    if (SUCCESS(error))
+    {
+        error = errorCustom;
+
+        if (toneCheck.quiet())
+        {
+            error->code = ERROR_FAILED;
+            error->description = "E:";
+            error->description += effect;
+            error->description += " Quiet";
+        }
+        else
+        {
+            UINT8 peak = toneCheck.peak();
+
+            error->code = ERROR_SUCCESS;
+            error->description = "OK:";
+            error->description += effect;
+            error->description += " ";
+            error->description += s_toneBankHz[peak];
+            error->description += "Hz ";
+            error->description += toneCheck.percent(peak);
+            error->description += "%";
+        }
+    }
+
+    return error;
+}
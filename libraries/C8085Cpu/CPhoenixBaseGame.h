@@ -47,6 +47,14 @@ class CPhoenixBaseGame : public CGame
             void *cPhoenixBaseGame
         );
 
+        static PERROR soundToneA(
+            void *cPhoenixBaseGame
+        );
+
+        static PERROR soundToneB(
+            void *cPhoenixBaseGame
+        );
+
     protected:
 
         CPhoenixBaseGame(
@@ -56,6 +64,14 @@ class CPhoenixBaseGame : public CGame
         ~CPhoenixBaseGame(
         );
 
+    private:
+
+        PERROR soundTone(
+            UINT32 address,
+            UINT8  data,
+            char   effect
+        );
+
 };
 
 #endif
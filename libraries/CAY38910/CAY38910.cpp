@@ -23,6 +23,7 @@
 // EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 //
 #include "CAY38910.h"
+#include "CToneCheck.h"
 
 
 static const UINT8 AY_R00_CHA_FINE_TONE     = 0x0;
@@ -42,6 +43,33 @@ static const UINT8 AY_R15_COARSE_ENV_SHAPE  = 0xD;
 static const UINT8 AY_R16_PORT_A_DATA       = 0xE;
 static const UINT8 AY_R17_PORT_B_DATA       = 0xF;
 
+static const UINT8 AY_NO_REG                = 0xFF;
+
+//
+// The R07 enable register port direction bits.
+//
+static const UINT8 AY_R07_IOA_OUTPUT        = 0x40;
+static const UINT8 AY_R07_IOB_OUTPUT        = 0x80;
+
+//
+// The writable bits of each register. The port direction bits of the enable
+// register are only tested for the ports that are safe to drive.
+//
+static const UINT8 s_regMask[] = {0xFF, 0x0F, 0xFF, 0x0F, 0xFF, 0x0F, 0x1F, 0x3F,
+                                  0x1F, 0x1F, 0x1F, 0xFF, 0xFF, 0x0F, 0xFF, 0xFF};
+
+//
+// Target audio check frequencies per channel. These are spaced so that the
+// 3rd harmonics of the square waves don't alias onto each other at the
+// tone checker sample rate.
+//
+static const UINT16 s_audioFrequencyHz[] = {800, 1100, 1500};
+
+//
+// Time for the output amplifier and coupling capacitors to settle.
+//
+static const UINT16 s_audioSettleMs = 50;
+
 
 CAY38910::CAY38910(
     ICpu   *cpu,
@@ -50,7 +78,10 @@ CAY38910::CAY38910(
 ) : m_cpu(cpu),
     m_regAddress(regAddress),
     m_regDataRd(regData),
-    m_regDataWr(regData)
+    m_regDataWr(regData),
+    m_outputPorts(0),
+    m_latchedReg(AY_NO_REG),
+    m_shadowValid(0)
 {
 }
 
@@ -63,7 +94,10 @@ CAY38910::CAY38910(
 ) : m_cpu(cpu),
     m_regAddress(regAddress),
     m_regDataRd(regDataRd),
-    m_regDataWr(regDataWr)
+    m_regDataWr(regDataWr),
+    m_outputPorts(0),
+    m_latchedReg(AY_NO_REG),
+    m_shadowValid(0)
 {
 }
 
@@ -73,6 +107,15 @@ CAY38910::~CAY38910(
 }
 
 
+void
+CAY38910::setOutputPorts(
+    UINT8 outputPorts
+)
+{
+    m_outputPorts = outputPorts;
+}
+
+
 //
 // Clear back to post-reset state.
 //
@@ -82,6 +125,8 @@ CAY38910::idle(
 {
     PERROR error = errorSuccess;
 
+    invalidate();
+
     for (UINT8 reg = 0 ; reg < 16 ; reg++)
     {
         error = write(reg, 0x00);
@@ -105,6 +150,8 @@ CAY38910::check(
 {
     PERROR error = errorSuccess;
 
+    invalidate();
+
     for (UINT8 exp = 0 ; exp < 250 ; exp++)
     {
         // Write
@@ -157,6 +204,169 @@ CAY38910::check(
         }
     }
 
+    if (SUCCESS(error))
+    {
+        error = checkRegisters();
+    }
+
+    return error;
+}
+
+
+//
+// Every writable bit of every register is tested with walking ones and
+// zeros. Then a unique value is written to every register before they're
+// all read back to find address latch faults. Finally the port data
+// registers are tested through the pins for the ports configured as safe
+// to drive as outputs.
+//
+// The chip is left idle.
+//
+// 0123456789abcdef
+// E:AY3 0007 01 00
+//
+PERROR
+CAY38910::checkRegisters(
+)
+{
+    PERROR error = errorSuccess;
+    UINT8 quiet = 0x3F;
+    UINT8 rec = 0;
+
+    if (m_outputPorts & 0x01)
+    {
+        quiet |= AY_R07_IOA_OUTPUT;
+    }
+
+    if (m_outputPorts & 0x02)
+    {
+        quiet |= AY_R07_IOB_OUTPUT;
+    }
+
+    for (UINT8 reg = 0 ; (reg < AY_R16_PORT_A_DATA) && SUCCESS(error) ; reg++)
+    {
+        UINT8 mask = (reg == AY_R07_ENABLE) ? quiet : s_regMask[reg];
+
+        for (UINT8 bit = 0 ; bit < 16 ; bit++)
+        {
+            UINT8 exp = (UINT8) (0x01 << (bit & 0x7));
+
+            if (bit & 0x8)
+            {
+                exp = ~exp;
+            }
+
+            exp &= mask;
+
+            error = write(reg, exp);
+            if (FAILED(error))
+            {
+                break;
+            }
+
+            error = read(reg, &rec);
+            if (FAILED(error))
+            {
+                break;
+            }
+
+            rec &= mask;
+
+            CHECK_VALUE_UINT8_BREAK(error, "AY3", reg, exp, rec);
+        }
+
+        if (SUCCESS(error))
+        {
+            error = write(reg, (reg == AY_R07_ENABLE) ? quiet : 0x00);
+        }
+    }
+
+    //
+    // Unique values to catch registers that alias each other.
+    //
+    for (UINT8 reg = 0 ; (reg < AY_R16_PORT_A_DATA) && SUCCESS(error) ; reg++)
+    {
+        if (reg != AY_R07_ENABLE)
+        {
+            error = write(reg, ((reg << 4) | reg) & s_regMask[reg]);
+        }
+    }
+
+    for (UINT8 reg = 0 ; (reg < AY_R16_PORT_A_DATA) && SUCCESS(error) ; reg++)
+    {
+        UINT8 mask = (reg == AY_R07_ENABLE) ? quiet : s_regMask[reg];
+        UINT8 exp  = (reg == AY_R07_ENABLE) ? quiet : (((reg << 4) | reg) & mask);
+
+        error = read(reg, &rec);
+        if (FAILED(error))
+        {
+            break;
+        }
+
+        rec &= mask;
+
+        CHECK_VALUE_UINT8_BREAK(error, "AY3", reg, exp, rec);
+    }
+
+    //
+    // In output mode the port data is read back from the pins.
+    //
+    for (UINT8 port = IOA ; (port <= IOB) && SUCCESS(error) ; port++)
+    {
+        UINT8 reg = AY_R16_PORT_A_DATA + port;
+
+        if (!(m_outputPorts & (0x01 << port)))
+        {
+            continue;
+        }
+
+        for (UINT16 exp = 0 ; exp < 0x100 ; exp++)
+        {
+            error = write(reg, (UINT8) exp);
+            if (FAILED(error))
+            {
+                break;
+            }
+
+            error = read(reg, &rec);
+            if (FAILED(error))
+            {
+                break;
+            }
+
+            CHECK_VALUE_UINT8_BREAK(error, "AY3", reg, exp, rec);
+        }
+    }
+
+    if (SUCCESS(error))
+    {
+        error = idle();
+    }
+
+    return error;
+}
+
+
+PERROR
+CAY38910::program(
+    const UINT8 regs[16]
+)
+{
+    PERROR error = errorSuccess;
+
+    for (UINT8 reg = 0 ; (reg < 16) && SUCCESS(error) ; reg++)
+    {
+        if (reg != AY_R07_ENABLE)
+        {
+            error = update(reg, regs[reg]);
+        }
+    }
+
+    if (SUCCESS(error))
+    {
+        error = update(AY_R07_ENABLE, regs[AY_R07_ENABLE]);
+    }
+
     return error;
 }
 
@@ -209,15 +419,130 @@ CAY38910::noise(
         }
     }
 
-    error = write(AY_R06_NOISE_PERIOD, noisePeriod);
+    error = update(AY_R06_NOISE_PERIOD, noisePeriod);
+    if (SUCCESS(error))
+    {
+        error = update(AY_R07_ENABLE, enable);
+    }
+
+    if (SUCCESS(error))
+    {
+        error = update(amplitudeReg, amplitudeData);
+    }
+
+    return error;
+}
+
+
+PERROR
+CAY38910::tone(
+    Channel channel,
+    UINT16  period,
+    UINT8   amplitude
+)
+{
+    PERROR error = errorSuccess;
+
+    UINT8 enable = 0x3F;
+
+    if (channel > CHC)
+    {
+        return errorNotImplemented;
+    }
+
+    enable ^= (0x01 << channel);
+
+    error = update(AY_R00_CHA_FINE_TONE + (channel * 2), (UINT8) (period & 0xFF));
+
     if (SUCCESS(error))
     {
-        error = write(AY_R07_ENABLE, enable);
+        error = update(AY_R01_CHA_COARSE_TONE + (channel * 2), (UINT8) ((period >> 8) & 0x0F));
+    }
+
+    for (UINT8 index = CHA ; (index <= CHC) && SUCCESS(error) ; index++)
+    {
+        error = update(AY_R10_CHA_AMPLITUDE + index, (index == channel) ? amplitude : 0x00);
     }
 
     if (SUCCESS(error))
     {
-        error = write(amplitudeReg, amplitudeData);
+        error = update(AY_R07_ENABLE, enable);
+    }
+
+    return error;
+}
+
+
+//
+// The tone periods are rounded so the filters are run at the actual
+// frequencies generated rather than the targets.
+//
+// 0123456789abcdef
+// OK:AY2 81 80 82%
+// E:AY2 B Quiet
+// E:AY2 B 1500 40%
+//
+PERROR
+CAY38910::audioCheck(
+    UINT32     clockHz,
+    const char *label
+)
+{
+    PERROR error = errorSuccess;
+    CToneCheck toneCheck;
+    UINT16 frequencyHz[ARRAYSIZE(s_audioFrequencyHz)];
+    UINT16 period[ARRAYSIZE(s_audioFrequencyHz)];
+    UINT8  percent[ARRAYSIZE(s_audioFrequencyHz)];
+
+    for (UINT8 index = 0 ; index < ARRAYSIZE(s_audioFrequencyHz) ; index++)
+    {
+        period[index]      = (UINT16) ((clockHz + (8UL * s_audioFrequencyHz[index])) / (16UL * s_audioFrequencyHz[index]));
+        frequencyHz[index] = (UINT16) ((clockHz + (8UL * period[index])) / (16UL * period[index]));
+    }
+
+    for (UINT8 channel = CHA ; channel <= CHC ; channel++)
+    {
+        CDescription channelLabel(label);
+
+        channelLabel += ' ';
+        channelLabel += (char) ('A' + channel);
+
+        error = tone((Channel) channel, period[channel], 0x0F);
+
+        if (SUCCESS(error))
+        {
+            delay(s_audioSettleMs);
+
+            error = toneCheck.check(frequencyHz,
+                                    ARRAYSIZE(s_audioFrequencyHz),
+                                    channel,
+                                    (PCSTR) channelLabel);
+
+            percent[channel] = toneCheck.percent(channel);
+        }
+
+        if (FAILED(error))
+        {
+            break;
+        }
+    }
+
+    (void) idle();
+
+    if (SUCCESS(error))
+    {
+        error = errorCustom;
+        error->code = ERROR_SUCCESS;
+        error->description = "OK:";
+        error->description += label;
+
+        for (UINT8 channel = CHA ; channel <= CHC ; channel++)
+        {
+            error->description += " ";
+            error->description += percent[channel];
+        }
+
+        error->description += "%";
     }
 
     return error;
@@ -243,6 +568,40 @@ CAY38910::readPort(
 }
 
 
+//
+// Forget the latched address & the shadow, they can't be trusted once
+// anything else has accessed the chip or it has been reset.
+//
+void
+CAY38910::invalidate(
+)
+{
+    m_latchedReg  = AY_NO_REG;
+    m_shadowValid = 0;
+}
+
+
+//
+// Only latch the register address if it's changed.
+//
+PERROR
+CAY38910::select(
+    UINT8 reg
+)
+{
+    PERROR error = errorSuccess;
+
+    if (reg != m_latchedReg)
+    {
+        error = m_cpu->memoryWrite(m_regAddress, (UINT16) reg);
+
+        m_latchedReg = SUCCESS(error) ? reg : AY_NO_REG;
+    }
+
+    return error;
+}
+
+
 PERROR
 CAY38910::read(
     UINT8 reg,
@@ -252,7 +611,7 @@ CAY38910::read(
     PERROR error = errorSuccess;
     UINT16 data16 = 0;
 
-    error = m_cpu->memoryWrite(m_regAddress, (UINT16) reg);
+    error = select(reg);
 
     if (SUCCESS(error))
     {
@@ -273,13 +632,44 @@ CAY38910::write(
 {
     PERROR error = errorSuccess;
 
-    error = m_cpu->memoryWrite(m_regAddress, (UINT16) reg);
+    error = select(reg);
 
     if (SUCCESS(error))
     {
         error = m_cpu->memoryWrite(m_regDataWr, (UINT16) data);
     }
 
+    if (SUCCESS(error))
+    {
+        m_shadow[reg] = data;
+        m_shadowValid |= (0x0001 << reg);
+    }
+    else
+    {
+        m_shadowValid &= ~(0x0001 << reg);
+    }
+
     return error;
 }
 
+
+//
+// Writing the envelope shape register restarts the envelope so it's always
+// written even if it's unchanged.
+//
+PERROR
+CAY38910::update(
+    UINT8 reg,
+    UINT8 data
+)
+{
+    if ((reg != AY_R15_COARSE_ENV_SHAPE)          &&
+        (m_shadowValid & (0x0001 << reg))         &&
+        (m_shadow[reg] == data))
+    {
+        return errorSuccess;
+    }
+
+    return write(reg, data);
+}
+
@@ -34,6 +34,13 @@
 // IO locations, one to set the register address to access and the other
 // to read or write data to it.
 //
+// A shadow of the 16 registers and the address latch is kept so that
+// unchanged registers aren't rewritten and the address isn't re-latched
+// for consecutive accesses to the same register. The shadow is kept across
+// calls so that repeated tones only write what changed. idle() and check()
+// start from an unknown state, callers that access the chip outside of this
+// class must call invalidate() before using it again.
+//
 class CAY38910
 {
     public:
@@ -71,39 +78,109 @@ class CAY38910
         ~CAY38910(
         );
 
+        //
+        // Set the ports (bit 0 is IOA, bit 1 is IOB) that are safe to drive as
+        // outputs during the register check. By default both ports are left
+        // as inputs because most boards drive them externally.
+        //
+        void setOutputPorts(
+            UINT8 outputPorts
+        );
+
         PERROR idle(
         );
 
+        //
+        // Read/write test of the tone registers followed by a test of every
+        // writable bit of every register and of the output ports.
+        //
         PERROR check(
         );
 
+        //
+        // Write a complete register set, only writing the registers that
+        // differ from the shadow. The enable register is written last.
+        //
+        PERROR program(
+            const UINT8 regs[16]
+        );
+
         PERROR noise(
             Channel channel
         );
+
+        //
+        // Generate a square wave tone on the specified channel with the
+        // other channels silenced. The frequency is clock / (16 * period).
+        //
+        PERROR tone(
+            Channel channel,
+            UINT16  period,
+            UINT8   amplitude
+        );
+
+        //
+        // Play a different tone on each channel in turn and verify it on the
+        // AUX1 audio input with the tone checker. The label is at most
+        // 3 characters, e.g. "AY2".
+        //
+        PERROR audioCheck(
+            UINT32     clockHz,
+            const char *label
+        );
     
         PERROR readPort(
             Port port,
             UINT8 *data
         );
 
+        //
+        // Forget the shadow and the latched register address.
+        //
+        void invalidate(
+        );
+
     private:
 
+        PERROR checkRegisters(
+        );
+
+        PERROR select(
+            UINT8 reg
+        );
+
         PERROR read(
             UINT8 reg,
             UINT8 *data
         );
 
+        //
+        // Unconditional write.
+        //
         PERROR write(
             UINT8 reg,
             UINT8 data
         );
 
+        //
+        // Write only if the register differs from the shadow.
+        //
+        PERROR update(
+            UINT8 reg,
+            UINT8 data
+        );
+
     private:
 
         ICpu    *m_cpu;
         UINT32  m_regAddress;
         UINT32  m_regDataRd;
         UINT32  m_regDataWr;
+        UINT8   m_outputPorts;
+
+        UINT8   m_latchedReg;
+        UINT16  m_shadowValid;
+        UINT8   m_shadow[16];
 };
 
 #endif
@@ -51,11 +51,17 @@ static const UINT32 s_p2ResetAddress   = 0x010015A0; // No clear for IRQ1
 static const UINT32 s_irq2ClearAddress = 0x010015C0;
 static const UINT32 s_irq3ClearAddress = 0x010015E0;
 
+//
+// The length of VBLANK in which the VRAM can be accessed, 32 of the 416 lines
+// at 64us per line. The VBLANK interrupt is latched so this can't be measured.
+//
+static const UINT32 s_vblankWindowUs = 2048;
+
 
 //
 // RAM region is the same for all games on this board set.
 //
-// NOTE: The VRAM sync limits IO to ~50 bytes/s so the VRAM test takes several minutes to complete.
+// NOTE: The VRAM sync limits IO to a burst of accesses per VBLANK window (previously ~50 bytes/s).
 //
 static const RAM_REGION s_ramRegion[] PROGMEM = { //
                                                   // See note above about access restrictions w.r.t video RAM access
@@ -115,6 +121,9 @@ CSystem2BaseGame::CSystem2BaseGame(
            s_outputRegion,
            s_customFunction)
 {
+    m_vblankWindowOpen    = false;
+    m_vblankWindowStartUs = 0;
+
     m_cpu = new CT11Cpu(onAddressRemap, this);
     m_cpu->idle();
 
@@ -291,22 +300,34 @@ CSystem2BaseGame::onAddressRemap(
     if ((cpuAddress & 0x02000000) != 0)
     {
         //
-        // The VBLANK interrupt is already enabled
-        // by the VRAM bank switch.
+        // Accesses are batched into a VBLANK window and only re-synchronised
+        // once the first half of the window has been used, leaving the second
+        // half as margin for the access in flight.
         //
-
-        // Reset the VBLANK interrupt.
-        error = cpu->memoryWrite(s_irq3ClearAddress, 0x0);
-        if (FAILED(error))
+        if (!thisGame->m_vblankWindowOpen ||
+            ((micros() - thisGame->m_vblankWindowStartUs) >= (s_vblankWindowUs / 2)))
         {
-            goto Exit;
-        }
+            //
+            // The VBLANK interrupt is already enabled
+            // by the VRAM bank switch.
+            //
+
+            // Reset the VBLANK interrupt.
+            error = cpu->memoryWrite(s_irq3ClearAddress, 0x0);
+            if (FAILED(error))
+            {
+                goto Exit;
+            }
 
-        // Wait for VBLANK;
-        error = cpu->waitForInterrupt(ICpu::IRQ3, true, 300);
-        if (FAILED(error))
-        {
-            goto Exit;
+            // Wait for VBLANK;
+            error = cpu->waitForInterrupt(ICpu::IRQ3, true, 300);
+            if (FAILED(error))
+            {
+                goto Exit;
+            }
+
+            thisGame->m_vblankWindowStartUs = micros();
+            thisGame->m_vblankWindowOpen    = true;
         }
 
         // Strip the flag we just processed.
@@ -336,6 +357,9 @@ CSystem2BaseGame::onBankSwitchVRAM0(
     CSystem2BaseGame *thisGame  = (CSystem2BaseGame *) cSystem2BaseGame;
     ICpu             *cpu       = thisGame->m_cpu;
 
+    // Force the first VRAM access to synchronise to a new window.
+    thisGame->m_vblankWindowOpen = false;
+
     // Enable the VBLANK interrupt for VRAM access sync.
     error = cpu->memoryWrite(s_irqEnableAddress, 0x8);
     if (FAILED(error))
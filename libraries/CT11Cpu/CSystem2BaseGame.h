@@ -58,6 +58,11 @@ class CSystem2BaseGame : public CGame
         ~CSystem2BaseGame(
         );
 
+    private:
+
+        bool   m_vblankWindowOpen;
+        UINT32 m_vblankWindowStartUs;
+
 };
 
 #endif
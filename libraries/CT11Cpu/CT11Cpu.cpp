@@ -26,6 +26,7 @@
 #include "Error.h"
 #include "CT11Cpu.h"
 #include "PinMap.h"
+#include "CPinShortCheck.h"
 
 
 //
@@ -84,6 +85,22 @@ static const CONNECTION s_DALLo_iot[] = { {17, "DAL0" },
                                           {11, "DAL6" },
                                           {10, "DAL7" } }; // Lower 8 of 16 bits
 
+//
+// The CPU output and bus pins checked for pin to pin shorts.
+// Power, clock and input pins driven by the board are excluded. /RAS &
+// /CAS are strobes so the RAM never sees a cycle.
+//
+static const CONNECTION_GROUP s_pinShortCheck[] = { {&s__BCLR_o,  1},
+                                                    {&s_SEL1_o,   1},
+                                                    {&s_SEL0_o,   1},
+                                                    {&s_R_WHB_o,  1},
+                                                    {&s_R_WLB_o,  1},
+                                                    {&s__RAS_o,   1, true},
+                                                    {&s__CAS_o,   1, true},
+                                                    {&s_PI_o,     1},
+                                                    {s_DALHi_iot, ARRAYSIZE(s_DALHi_iot)},
+                                                    {s_DALLo_iot, ARRAYSIZE(s_DALLo_iot)} };
+
 //
 // The AI pins represented as an 8-bit bus
 //
@@ -289,6 +306,21 @@ CT11Cpu::check(
     CHECK_BUS_VALUE_UINT8_EXIT(error, m_busDALHi, s_DALHi_iot, 0xFF);
     CHECK_BUS_VALUE_UINT8_EXIT(error, m_busDALLo, s_DALLo_iot, 0xFF);
 
+    // Look for pin to pin shorts on the probe socket.
+    {
+        CPinShortCheck pinShortCheck(g_pinMap40DIL, s_pinShortCheck, ARRAYSIZE(s_pinShortCheck));
+
+        error = pinShortCheck.check();
+
+        // The short check leaves the pins released so restore the idle state.
+        idle();
+
+        if (FAILED(error))
+        {
+            goto Exit;
+        }
+    }
+
 Exit:
     return error;
 }
@@ -513,6 +545,21 @@ CT11Cpu::memoryWrite(
 }
 
 
+//
+// The data bus is multiplexed with the address (DAL0-DAL15) so it can't be
+// pre-charged independently of the cycle.
+//
+PERROR
+CT11Cpu::memoryReadFloating(
+    UINT32 address,
+    UINT16 *data,
+    UINT16 *floating
+)
+{
+    return errorNotImplemented;
+}
+
+
 PERROR
 CT11Cpu::waitForInterrupt(
     Interrupt interrupt,
@@ -591,3 +638,31 @@ CT11Cpu::acknowledgeInterrupt(
     return error;
 }
 
+
+//
+// Returns the probe connection for the logical address or data bus bit.
+//
+const CONNECTION *
+CT11Cpu::busConnection(
+    Bus   bus,
+    UINT8 bit
+)
+{
+    const CONNECTION *connection = (const CONNECTION *) NULL;
+
+    //
+    // Address & data are both multiplexed onto DAL so the bus
+    // selection makes no difference.
+    //
+    if (bit < ARRAYSIZE(s_DALLo_iot))
+    {
+        connection = &s_DALLo_iot[bit];
+    }
+    else if ((bit - ARRAYSIZE(s_DALLo_iot)) < ARRAYSIZE(s_DALHi_iot))
+    {
+        connection = &s_DALHi_iot[bit - ARRAYSIZE(s_DALLo_iot)];
+    }
+
+    return connection;
+}
+
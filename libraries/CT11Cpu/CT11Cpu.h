@@ -85,6 +85,12 @@ class CT11Cpu : public ICpu
             UINT16  data
         );
 
+        virtual PERROR memoryReadFloating(
+            UINT32 address,
+            UINT16 *data,
+            UINT16 *floating
+        );
+
         virtual
         PERROR
         waitForInterrupt(
@@ -99,6 +105,13 @@ class CT11Cpu : public ICpu
             UINT16 *response
         );
 
+        virtual
+        const CONNECTION *
+        busConnection(
+            Bus   bus,
+            UINT8 bit
+        );
+
         //
         // CT11Cpu Interface
         //
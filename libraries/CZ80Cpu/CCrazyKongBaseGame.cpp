@@ -112,7 +112,9 @@ static const OUTPUT_REGION s_outputRegion[] PROGMEM = { //
 //
 // Custom functions implemented for this game.
 //
-static const CUSTOM_FUNCTION s_customFunction[] PROGMEM = {{NO_CUSTOM_FUNCTION}}; // end of list
+static const CUSTOM_FUNCTION s_customFunction[] PROGMEM = { //                               "0123456789"
+                                                            {CCrazyKongBaseGame::spinReport, "Spin Max  "},
+                                                            {NO_CUSTOM_FUNCTION}}; // end of list
 
 
 CCrazyKongBaseGame::CCrazyKongBaseGame(
@@ -321,3 +323,16 @@ CCrazyKongBaseGame::onAddressRemap(
     return error;
 }
 
+
+//
+// Show the most CLK and WAIT polls made by a bus cycle since the last report.
+//
+PERROR
+CCrazyKongBaseGame::spinReport(
+    void *cCrazyKongBaseGame
+)
+{
+    CCrazyKongBaseGame *pThis = (CCrazyKongBaseGame *) cCrazyKongBaseGame;
+
+    return ((CZ80ACpu *) pThis->m_cpu)->spinReport();
+}
@@ -61,6 +61,10 @@ class CCrazyKongBaseGame : public CGame
             UINT32 *addressOut
         );
 
+        static PERROR spinReport(
+            void *cCrazyKongBaseGame
+        );
+
     protected:
 
         CCrazyKongBaseGame(
@@ -26,6 +26,7 @@
 #include "CZ80Cpu.h"
 #include "Bitswap.h"
 #include "CRomCheck.h"
+#include "CCapture.h"
 #include <DFR_Key.h>
 
 //
@@ -143,6 +144,8 @@ static const OUTPUT_REGION s_outputRegion[] PROGMEM = { //
 //
 static const CUSTOM_FUNCTION s_customFunction[] PROGMEM = { //                                    "0123456789"
                                                             {CDambustersBaseGame::nvRamCrc,       "NV RAM CRC"},
+                                                            {CCapture::captureAux,                "Capture   "},
+                                                            {CDambustersBaseGame::waitReport,     "Wait Hist "},
                                                             {NO_CUSTOM_FUNCTION}}; // end of list
 
 
@@ -165,12 +168,17 @@ CDambustersBaseGame::CDambustersBaseGame(
     m_cpu = new CZ80Cpu(0x10D000, onAddressRemap, this, onDataRemap, this);
     m_cpu->idle();
 
+    // Calibrate the WAIT latency over all of the ROM & RAM regions.
+    ((CZ80Cpu *) m_cpu)->setWaitCalibrationRegions(&m_romRegion, &m_ramRegion);
+
     // The VBLANK interrupt is on the NMI pin.
     m_interrupt = ICpu::NMI;
 
     // There is no direct hardware response of a vector on this platform.
     m_interruptAutoVector = true;
 
+    // The first report is of the memory space.
+    m_waitReportSpace = CZ80Cpu::WAIT_SPACE_COUNT - 1;
 }
 
 
@@ -359,3 +367,19 @@ CDambustersBaseGame::nvRamCrc(
     return error;
 }
 
+
+//
+// Show the WAIT latency histogram of the memory, IO and V-RAM spaces in turn.
+//
+PERROR
+CDambustersBaseGame::waitReport(
+    void *cDambustersBaseGame
+)
+{
+    CDambustersBaseGame *thisGame = (CDambustersBaseGame *) cDambustersBaseGame;
+
+    thisGame->m_waitReportSpace = (thisGame->m_waitReportSpace + 1) % CZ80Cpu::WAIT_SPACE_COUNT;
+
+    return ((CZ80Cpu *) thisGame->m_cpu)->waitReport((CZ80Cpu::WaitSpace) thisGame->m_waitReportSpace);
+}
+
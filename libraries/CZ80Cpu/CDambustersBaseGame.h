@@ -59,6 +59,14 @@ class CDambustersBaseGame : public CGame
             void *cDambustersBaseGame
         );
 
+        //
+        // Custom function to show the WAIT latency histogram of the next
+        // address space on each call.
+        //
+        static PERROR waitReport(
+            void *cDambustersBaseGame
+        );
+
     protected:
 
         CDambustersBaseGame(
@@ -69,6 +77,10 @@ class CDambustersBaseGame : public CGame
         ~CDambustersBaseGame(
         );
 
+    private:
+
+        UINT8 m_waitReportSpace;
+
 };
 
 #endif
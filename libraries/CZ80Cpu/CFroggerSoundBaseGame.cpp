@@ -54,6 +54,11 @@
 //   0x800 - CHC F1
 
 
+//
+// AY-3-8910 clock (from MAME), 14.31818MHz / 8.
+//
+static const UINT32 s_ayClockHz = 1789772;
+
 //
 // RAM region is the same for all games on this board set.
 //
@@ -117,6 +122,7 @@ static const OUTPUT_REGION s_outputRegion[] PROGMEM = { //
 static const CUSTOM_FUNCTION s_customFunction[] PROGMEM = { //                                    "0123456789"
                                                             {CFroggerSoundBaseGame::ayIdle,       "AY Idle   "},
                                                             {CFroggerSoundBaseGame::ayCheck,      "AY Check  "},
+                                                            {CFroggerSoundBaseGame::ayAudio,      "AY Audio  "},
                                                             {CFroggerSoundBaseGame::ay_35_ChA,    "AY 35 CHA "},
                                                             {CFroggerSoundBaseGame::ay_35_ChB,    "AY 35 CHB "},
                                                             {CFroggerSoundBaseGame::ay_35_ChC,    "AY 35 CHC "},
@@ -201,6 +207,26 @@ CFroggerSoundBaseGame::ayCheck(
 }
 
 
+// Verify the audio output of each AY-3-8910 channel on AUX1.
+PERROR
+CFroggerSoundBaseGame::ayAudio(
+    void *cFroggerSoundBaseGame
+)
+{
+    CFroggerSoundBaseGame *pThis = (CFroggerSoundBaseGame *) cFroggerSoundBaseGame;
+    PERROR error = errorSuccess;
+
+    error = pThis->m_cpu->memoryWrite(AY_FLT_OFF, 0);
+
+    if (SUCCESS(error))
+    {
+        error = pThis->m_ay->audioCheck(s_ayClockHz, "35");
+    }
+
+    return error;
+}
+
+
 PERROR
 CFroggerSoundBaseGame::ay_35_ChA(
     void *cFroggerSoundBaseGame
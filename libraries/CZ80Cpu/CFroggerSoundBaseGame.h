@@ -48,6 +48,10 @@ class CFroggerSoundBaseGame : public CGame
             void *cFroggerSoundBaseGame
         );
 
+        static PERROR ayAudio(
+            void *cFroggerSoundBaseGame
+        );
+
         static PERROR ay_35_ChA(
             void *cFroggerSoundBaseGame
         );
@@ -143,6 +143,7 @@ static const OUTPUT_REGION s_outputRegion[] PROGMEM = { //
 static const CUSTOM_FUNCTION s_customFunction[] PROGMEM = { //                                    "0123456789"
                                                             {CGalaxianBaseGame::clearVideo,       "Clear Vid."},
                                                             {CGalaxianBaseGame::shellMissileTest, "Shell Mis."},
+                                                            {CGalaxianBaseGame::waitReport,       "Wait Hist "},
                                                             {NO_CUSTOM_FUNCTION}}; // end of list
 
 
@@ -161,12 +162,17 @@ CGalaxianBaseGame::CGalaxianBaseGame(
     m_cpu = new CZ80Cpu();
     m_cpu->idle();
 
+    // Calibrate the WAIT latency over all of the ROM & RAM regions.
+    ((CZ80Cpu *) m_cpu)->setWaitCalibrationRegions(&m_romRegion, &m_ramRegion);
+
     // The VBLANK interrupt is on the NMI pin.
     m_interrupt = ICpu::NMI;
 
     // There is no direct hardware response of a vector on this platform.
     m_interruptAutoVector = true;
 
+    // The first report is of the memory space.
+    m_waitReportSpace = CZ80Cpu::WAIT_SPACE_COUNT - 1;
 }
 
 
@@ -354,3 +360,19 @@ CGalaxianBaseGame::shellMissileTest(
     return error;
 }
 
+
+//
+// Show the WAIT latency histogram of the memory, IO and V-RAM spaces in turn.
+//
+PERROR
+CGalaxianBaseGame::waitReport(
+    void *context
+)
+{
+    CGalaxianBaseGame *thisGame = (CGalaxianBaseGame *) context;
+
+    thisGame->m_waitReportSpace = (thisGame->m_waitReportSpace + 1) % CZ80Cpu::WAIT_SPACE_COUNT;
+
+    return ((CZ80Cpu *) thisGame->m_cpu)->waitReport((CZ80Cpu::WaitSpace) thisGame->m_waitReportSpace);
+}
+
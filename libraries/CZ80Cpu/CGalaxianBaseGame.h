@@ -53,6 +53,14 @@ class CGalaxianBaseGame : public CGame
             void *context
         );
 
+        //
+        // Custom function to show the WAIT latency histogram of the next
+        // address space on each call.
+        //
+        static PERROR waitReport(
+            void *context
+        );
+
     protected:
 
         CGalaxianBaseGame(
@@ -63,6 +71,10 @@ class CGalaxianBaseGame : public CGame
         ~CGalaxianBaseGame(
         );
 
+    private:
+
+        UINT8 m_waitReportSpace;
+
 };
 
 #endif
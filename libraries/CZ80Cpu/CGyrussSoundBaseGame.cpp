@@ -43,6 +43,11 @@
 // Notes:
 //
 
+//
+// AY-3-8910 clock (from MAME), 14.31818MHz / 8.
+//
+static const UINT32 s_ayClockHz = 1789772;
+
 //
 // RAM region is the same for all games on this board set.
 //
@@ -88,6 +93,7 @@ static const OUTPUT_REGION s_outputRegion[] PROGMEM = { //
 static const CUSTOM_FUNCTION s_customFunction[] PROGMEM = { //                                  "0123456789"
                                                             {CGyrussSoundBaseGame::ayIdle,      "AY Idle   "},
                                                             {CGyrussSoundBaseGame::ayCheck,     "AY Check  "},
+                                                            {CGyrussSoundBaseGame::ayAudio,     "AY Audio  "},
                                                             {CGyrussSoundBaseGame::ayNoise,     "AY Noise  "},
                                                             {NO_CUSTOM_FUNCTION}}; // end of list
 
@@ -232,6 +238,32 @@ CGyrussSoundBaseGame::ayCheck(
 }
 
 
+// Verify the audio output of each AY-3-8910 channel on AUX1.
+PERROR
+CGyrussSoundBaseGame::ayAudio(
+    void *cGyrussSoundBaseGame
+)
+{
+    CGyrussSoundBaseGame *pThis = (CGyrussSoundBaseGame *) cGyrussSoundBaseGame;
+    PERROR error = errorSuccess;
+
+    for (int x = 0 ; x < 5 ; x++)
+    {
+        CDescription label("AY");
+
+        label += x;
+
+        error = pThis->m_ay[x]->audioCheck(s_ayClockHz, (PCSTR) label);
+        if (FAILED(error))
+        {
+            break;
+        }
+    }
+
+    return error;
+}
+
+
 // Noise test the AY-3-8910's.
 PERROR
 CGyrussSoundBaseGame::ayNoise(
@@ -48,6 +48,10 @@ class CGyrussSoundBaseGame : public CGame
             void *cGyrussSoundBaseGame
         );
 
+        static PERROR ayAudio(
+            void *cGyrussSoundBaseGame
+        );
+
         static PERROR ayNoise(
             void *cGyrussSoundBaseGame
         );
@@ -103,7 +103,9 @@ static const OUTPUT_REGION s_outputRegion[] PROGMEM = { //
 //
 // Custom functions implemented for this game.
 //
-static const CUSTOM_FUNCTION s_customFunction[] PROGMEM = {{NO_CUSTOM_FUNCTION}}; // end of list
+static const CUSTOM_FUNCTION s_customFunction[] PROGMEM = { //                             "0123456789"
+                                                            {CLadybugBaseGame::spinReport, "Spin Max  "},
+                                                            {NO_CUSTOM_FUNCTION}}; // end of list
 
 
 CLadybugBaseGame::CLadybugBaseGame(
@@ -147,3 +149,16 @@ CLadybugBaseGame::interruptCheck(
     return errorNotImplemented;
 }
 
+
+//
+// Show the most CLK and WAIT polls made by a bus cycle since the last report.
+//
+PERROR
+CLadybugBaseGame::spinReport(
+    void *cLadybugBaseGame
+)
+{
+    CLadybugBaseGame *pThis = (CLadybugBaseGame *) cLadybugBaseGame;
+
+    return ((CZ80ACpu *) pThis->m_cpu)->spinReport();
+}
@@ -39,6 +39,10 @@ class CLadybugBaseGame : public CGame
         virtual PERROR interruptCheck(
         );
 
+        static PERROR spinReport(
+            void *cLadybugBaseGame
+        );
+
     protected:
 
         CLadybugBaseGame(
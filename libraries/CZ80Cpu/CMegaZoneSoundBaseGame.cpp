@@ -57,6 +57,11 @@
 //   isolate it.
 //
 
+//
+// AY-3-8910 clock (from MAME), 14.31818MHz / 8.
+//
+static const UINT32 s_ayClockHz = 1789772;
+
 //
 // RAM region is the same for all games on this board set.
 //
@@ -102,6 +107,7 @@ static const OUTPUT_REGION s_outputRegion[] PROGMEM = { //
 static const CUSTOM_FUNCTION s_customFunction[] PROGMEM = { //                                 "0123456789"
                                                             {CMegaZoneSoundBaseGame::ayIdle,   "AY Idle   "},
                                                             {CMegaZoneSoundBaseGame::ayCheck,  "AY Check  "},
+                                                            {CMegaZoneSoundBaseGame::ayAudio,  "AY Audio  "},
                                                             {CMegaZoneSoundBaseGame::ayChA,    "AY CHA    "},
                                                             {CMegaZoneSoundBaseGame::ayChB,    "AY CHB    "},
                                                             {CMegaZoneSoundBaseGame::ayChC,    "AY CHC    "},
@@ -132,6 +138,9 @@ CMegaZoneSoundBaseGame::CMegaZoneSoundBaseGame(
     // AY
     m_ay = new CAY38910(m_cpu, 0x10000L, 0x10020L);
 
+    // Port B drives the output filters (from MAME) so it's safe to test as an output.
+    m_ay->setOutputPorts(0x02);
+
 }
 
 
@@ -186,6 +195,21 @@ CMegaZoneSoundBaseGame::ayCheck(
 }
 
 
+// Verify the audio output of each AY-3-8910 channel on AUX1.
+PERROR
+CMegaZoneSoundBaseGame::ayAudio(
+    void *cMegaZoneSoundBaseGame
+)
+{
+    CMegaZoneSoundBaseGame *pThis = (CMegaZoneSoundBaseGame *) cMegaZoneSoundBaseGame;
+    PERROR error = errorSuccess;
+
+    error = pThis->m_ay->audioCheck(s_ayClockHz, "B8");
+
+    return error;
+}
+
+
 PERROR
 CMegaZoneSoundBaseGame::ayChA(
     void *cMegaZoneSoundBaseGame
@@ -48,6 +48,10 @@ class CMegaZoneSoundBaseGame : public CGame
             void *cMegaZoneSoundBaseGame
         );
 
+        static PERROR ayAudio(
+            void *cMegaZoneSoundBaseGame
+        );
+
         static PERROR ayChA(
             void *cMegaZoneSoundBaseGame
         );
@@ -98,7 +98,9 @@ static const OUTPUT_REGION s_outputRegion[] PROGMEM = { //
 //
 // Custom functions implemented for this game.
 //
-static const CUSTOM_FUNCTION s_customFunction[] PROGMEM = {{NO_CUSTOM_FUNCTION}}; // end of list
+static const CUSTOM_FUNCTION s_customFunction[] PROGMEM = { //                             "0123456789"
+                                                            {CPuckmanBaseGame::spinReport, "Spin Max  "},
+                                                            {NO_CUSTOM_FUNCTION}}; // end of list
 
 
 CPuckmanBaseGame::CPuckmanBaseGame(
@@ -151,3 +153,16 @@ CPuckmanBaseGame::interruptCheck(
     return errorNotImplemented;
 }
 
+
+//
+// Show the most CLK and WAIT polls made by a bus cycle since the last report.
+//
+PERROR
+CPuckmanBaseGame::spinReport(
+    void *cPuckmanBaseGame
+)
+{
+    CPuckmanBaseGame *pThis = (CPuckmanBaseGame *) cPuckmanBaseGame;
+
+    return ((CZ80ACpu *) pThis->m_cpu)->spinReport();
+}
@@ -39,6 +39,10 @@ class CPuckmanBaseGame : public CGame
         virtual PERROR interruptCheck(
         );
 
+        static PERROR spinReport(
+            void *cPuckmanBaseGame
+        );
+
     protected:
 
         CPuckmanBaseGame(
@@ -141,7 +141,9 @@ static const OUTPUT_REGION s_outputRegion[] PROGMEM = { //
 //
 // Custom functions implemented for this game.
 //
-static const CUSTOM_FUNCTION s_customFunction[] PROGMEM = {{NO_CUSTOM_FUNCTION}}; // end of list
+static const CUSTOM_FUNCTION s_customFunction[] PROGMEM = { //                              "0123456789"
+                                                            {CScrambleBaseGame::spinReport, "Spin Max  "},
+                                                            {NO_CUSTOM_FUNCTION}}; // end of list
 
 
 CScrambleBaseGame::CScrambleBaseGame(
@@ -179,11 +181,11 @@ CScrambleBaseGame::CScrambleBaseGame(
             m_8255WriteBaseAddress0 += s_hustlerScrambleBaseOffset;
             m_8255WriteBaseAddress1 += s_hustlerScrambleBaseOffset;
 
-            addAddressOffset(m_ramRegion,          s_hustlerScrambleBaseOffset);
-            addAddressOffset(m_ramRegionByteOnly,  s_hustlerScrambleBaseOffset);
-            addAddressOffset(m_ramRegionWriteOnly, s_hustlerScrambleBaseOffset);
-            addAddressOffset(m_inputRegion,        s_hustlerScrambleBaseOffset);
-            addAddressOffset(m_outputRegion,       s_hustlerScrambleBaseOffset);
+            m_ramRegion.addAddressOffset(s_hustlerScrambleBaseOffset);
+            m_ramRegionByteOnly.addAddressOffset(s_hustlerScrambleBaseOffset);
+            m_ramRegionWriteOnly.addAddressOffset(s_hustlerScrambleBaseOffset);
+            m_inputRegion.addAddressOffset(s_hustlerScrambleBaseOffset);
+            m_outputRegion.addAddressOffset(s_hustlerScrambleBaseOffset);
         }
 
         case SCRAMBLE :
@@ -364,3 +366,16 @@ CScrambleBaseGame::onBankSwitchSetup8255_1(
     return cpu->memoryWrite(thisGame->m_8255WriteBaseAddress1 + 0x003, 0x88);
 }
 
+
+//
+// Show the most CLK and WAIT polls made by a bus cycle since the last report.
+//
+PERROR
+CScrambleBaseGame::spinReport(
+    void *cScrambleBaseGame
+)
+{
+    CScrambleBaseGame *pThis = (CScrambleBaseGame *) cScrambleBaseGame;
+
+    return ((CZ80ACpu *) pThis->m_cpu)->spinReport();
+}
@@ -52,6 +52,10 @@ class CScrambleBaseGame : public CGame
             void *cScrambleBaseGame
         );
 
+        static PERROR spinReport(
+            void *cScrambleBaseGame
+        );
+
     protected:
 
         CScrambleBaseGame(
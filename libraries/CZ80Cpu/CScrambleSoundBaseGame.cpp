@@ -62,6 +62,11 @@
 //   0x800 - #0 CHC F1
 
 
+//
+// AY-3-8910 clock (from MAME), 14.31818MHz / 8.
+//
+static const UINT32 s_ayClockHz = 1789772;
+
 //
 // RAM region is the same for all games on this board set.
 //
@@ -140,6 +145,7 @@ static const OUTPUT_REGION s_outputRegion[] PROGMEM = { //
 static const CUSTOM_FUNCTION s_customFunction[] PROGMEM = { //                                    "0123456789"
                                                             {CScrambleSoundBaseGame::ayIdle,      "AY Idle   "},
                                                             {CScrambleSoundBaseGame::ayCheck,     "AY Check  "},
+                                                            {CScrambleSoundBaseGame::ayAudio,     "AY Audio  "},
                                                             {CScrambleSoundBaseGame::ay_3D_ChA,   "AY 3D CHA "},
                                                             {CScrambleSoundBaseGame::ay_3D_ChB,   "AY 3D CHB "},
                                                             {CScrambleSoundBaseGame::ay_3D_ChC,   "AY 3D CHC "},
@@ -241,6 +247,30 @@ CScrambleSoundBaseGame::ayCheck(
 }
 
 
+// Verify the audio output of each AY-3-8910 channel on AUX1.
+PERROR
+CScrambleSoundBaseGame::ayAudio(
+    void *cScrambleSoundBaseGame
+)
+{
+    CScrambleSoundBaseGame *pThis = (CScrambleSoundBaseGame *) cScrambleSoundBaseGame;
+    PERROR error = errorSuccess;
+
+    error = pThis->m_cpu->memoryWrite(AY_FLT_OFF, 0);
+
+    if (SUCCESS(error))
+    {
+        error = pThis->m_ay[0]->audioCheck(s_ayClockHz, "3D");
+    }
+    if (SUCCESS(error))
+    {
+        error = pThis->m_ay[1]->audioCheck(s_ayClockHz, "3C");
+    }
+
+    return error;
+}
+
+
 PERROR
 CScrambleSoundBaseGame::ay_3D_ChA(
     void *cScrambleSoundBaseGame
@@ -48,6 +48,10 @@ class CScrambleSoundBaseGame : public CGame
             void *cScrambleSoundBaseGame
         );
 
+        static PERROR ayAudio(
+            void *cScrambleSoundBaseGame
+        );
+
         static PERROR ay_3D_ChA(
             void *cScrambleSoundBaseGame
         );
@@ -26,6 +26,7 @@
 #include "Error.h"
 #include "CZ80ACpu.h"
 #include "PinMap.h"
+#include "CPinShortCheck.h"
 
 
 //
@@ -139,100 +140,151 @@ static const UINT8 s_C5_BIT_D6        = 0x20;
 static const UINT8 s_D7_BIT_D7        = 0x80;
 
 
+//
+// The number of polls of CLK or WAIT before a bus cycle is abandoned, ~50ms.
+// This is long enough for WAIT to be held for several video lines.
+//
+static const UINT16 s_spinBudget = 0xFFFF;
+
+//
+// The following wait macros count the polls made in "spin". The count is only
+// advanced after the signal has been checked so the time from the signal
+// changing to the bus cycle continuing is the same as an unbounded loop.
+//
+// If the budget runs out the control lines are released, "error" is set to
+// name the signal, the level it's stuck at and the bus phase and the macro
+// exits via the function's "Exit" label.
+//
+
 //
 // Wait for CLK rising edge to be detected.
-// Note that the system will hang here if CLK is stuck.
 //
-#define WAIT_FOR_CLK_RISING_EDGE(r1,r2)    \
-    {                                      \
-        while(1)                           \
-        {                                  \
-            r1 = *g_portInA;               \
-            r2 = *g_portInA;               \
-                                           \
-            if (!(r1 & s_A2_BIT_IN_CLK) && \
-                 (r2 & s_A2_BIT_IN_CLK))   \
-            {                              \
-                break;                     \
-            }                              \
-        }                                  \
-    }                                      \
+#define WAIT_FOR_CLK_RISING_EDGE(r1,r2,spin,phase)         \
+    {                                                      \
+        spin = 0;                                          \
+        while(1)                                           \
+        {                                                  \
+            r1 = *g_portInA;                               \
+            r2 = *g_portInA;                               \
+                                                           \
+            if (!(r1 & s_A2_BIT_IN_CLK) &&                 \
+                 (r2 & s_A2_BIT_IN_CLK))                   \
+            {                                              \
+                break;                                     \
+            }                                              \
+                                                           \
+            if (++spin == s_spinBudget)                    \
+            {                                              \
+                *g_portOutB = ~(0);                        \
+                error = stuck("CLK", r2 & s_A2_BIT_IN_CLK, phase); \
+                goto Exit;                                 \
+            }                                              \
+        }                                                  \
+    }                                                      \
 
 //
 // Wait for CLK falling edge to be detected.
-// Note that the system will hang here if CLK is stuck.
 //
-#define WAIT_FOR_CLK_FALLING_EDGE(r1,r2)   \
-    {                                      \
-        while(1)                           \
-        {                                  \
-            r1 = *g_portInA;               \
-            r2 = *g_portInA;               \
-                                           \
-            if ( (r1 & s_A2_BIT_IN_CLK) && \
-                !(r2 & s_A2_BIT_IN_CLK))   \
-            {                              \
-                break;                     \
-            }                              \
-        }                                  \
-    }                                      \
+#define WAIT_FOR_CLK_FALLING_EDGE(r1,r2,spin,phase)        \
+    {                                                      \
+        spin = 0;                                          \
+        while(1)                                           \
+        {                                                  \
+            r1 = *g_portInA;                               \
+            r2 = *g_portInA;                               \
+                                                           \
+            if ( (r1 & s_A2_BIT_IN_CLK) &&                 \
+                !(r2 & s_A2_BIT_IN_CLK))                   \
+            {                                              \
+                break;                                     \
+            }                                              \
+                                                           \
+            if (++spin == s_spinBudget)                    \
+            {                                              \
+                *g_portOutB = ~(0);                        \
+                error = stuck("CLK", r2 & s_A2_BIT_IN_CLK, phase); \
+                goto Exit;                                 \
+            }                                              \
+        }                                                  \
+    }                                                      \
 
 
 //
 // Wait for CLK high.
-// This loop is 2 instructions total, 125ns.
-// Note that the system will hang here if CLK is stuck.
+// This loop is 2 instructions total, 125ns, plus the spin count.
 //
-#define WAIT_FOR_CLK_HI(r1,r2)            \
-    {                                      \
-        while(1)                           \
-        {                                  \
-            r1 = *g_portInA;               \
-                                           \
-            if ((r1 & s_A2_BIT_IN_CLK))   \
-            {                              \
-                break;                     \
-            }                              \
-        }                                  \
-    }                                      \
+#define WAIT_FOR_CLK_HI(r1,r2,spin,phase)                  \
+    {                                                      \
+        spin = 0;                                          \
+        while(1)                                           \
+        {                                                  \
+            r1 = *g_portInA;                               \
+                                                           \
+            if ((r1 & s_A2_BIT_IN_CLK))                    \
+            {                                              \
+                break;                                     \
+            }                                              \
+                                                           \
+            if (++spin == s_spinBudget)                    \
+            {                                              \
+                *g_portOutB = ~(0);                        \
+                error = stuck("CLK", 0, phase);            \
+                goto Exit;                                 \
+            }                                              \
+        }                                                  \
+    }                                                      \
 
 
 //
 // Wait for WAIT high.
-// This loop is 2 instructions total, 125ns.
-// Note that the system will hang here if WAIT is stuck.
+// This loop is 2 instructions total, 125ns, plus the spin count.
 //
-#define WAIT_FOR_WAIT_HI(r1,r2)            \
-    {                                      \
-        while(1)                           \
-        {                                  \
-            r1 = *g_portInL;               \
-                                           \
-            if ((r1 & s_L2_BIT_IN_WAIT))   \
-            {                              \
-                break;                     \
-            }                              \
-        }                                  \
-    }                                      \
+#define WAIT_FOR_WAIT_HI(r1,r2,spin,phase)                 \
+    {                                                      \
+        spin = 0;                                          \
+        while(1)                                           \
+        {                                                  \
+            r1 = *g_portInL;                               \
+                                                           \
+            if ((r1 & s_L2_BIT_IN_WAIT))                   \
+            {                                              \
+                break;                                     \
+            }                                              \
+                                                           \
+            if (++spin == s_spinBudget)                    \
+            {                                              \
+                *g_portOutB = ~(0);                        \
+                error = stuck("WAIT", 0, phase);           \
+                goto Exit;                                 \
+            }                                              \
+        }                                                  \
+    }                                                      \
 
 
 //
 // Wait for WAIT low.
-// This loop is 2 instructions total, 125ns.
-// Note that the system will hang here if WAIT is stuck.
+// This loop is 2 instructions total, 125ns, plus the spin count.
 //
-#define WAIT_FOR_WAIT_LO(r1,r2)            \
-    {                                      \
-        while(1)                           \
-        {                                  \
-            r1 = *g_portInL;               \
-                                           \
-            if (!(r1 & s_L2_BIT_IN_WAIT))  \
-            {                              \
-                break;                     \
-            }                              \
-        }                                  \
-    }                                      \
+#define WAIT_FOR_WAIT_LO(r1,r2,spin,phase)                 \
+    {                                                      \
+        spin = 0;                                          \
+        while(1)                                           \
+        {                                                  \
+            r1 = *g_portInL;                               \
+                                                           \
+            if (!(r1 & s_L2_BIT_IN_WAIT))                  \
+            {                                              \
+                break;                                     \
+            }                                              \
+                                                           \
+            if (++spin == s_spinBudget)                    \
+            {                                              \
+                *g_portOutB = ~(0);                        \
+                error = stuck("WAIT", 1, phase);           \
+                goto Exit;                                 \
+            }                                              \
+        }                                                  \
+    }                                                      \
 
 #define IS_IO_SPACE(ad)   ((ad & (UINT32) 0x010000) != 0)
 #define IS_WAIT_SPACE(ad) ((ad & (UINT32) 0x100000) != 0)
@@ -289,6 +341,22 @@ static const CONNECTION s_D_iot[] = { {14, "D0" },
                                       {10, "D6" },
                                       {13, "D7" } }; // 8 bits.
 
+//
+// The CPU output and bus pins checked for pin to pin shorts.
+// Power, clock and input pins driven by the board are excluded. /MREQ,
+// /IORQ, /RD & /WR are strobes so a read or write is never started.
+//
+static const CONNECTION_GROUP s_pinShortCheck[] = { {&s__HALT_o,   1},
+                                                    {&s__MREQ_ot,  1, true},
+                                                    {&s__IORQ_ot,  1, true},
+                                                    {&s__RD_ot,    1, true},
+                                                    {&s__WR_ot,    1, true},
+                                                    {&s__BUSACK_o, 1},
+                                                    {&s__M1_o,     1},
+                                                    {&s__RFSH_ot,  1},
+                                                    {s_A_ot,       ARRAYSIZE(s_A_ot)},
+                                                    {s_D_iot,      ARRAYSIZE(s_D_iot)} };
+
 
 CZ80ACpu::CZ80ACpu(
     UINT32                vramAddress,
@@ -310,8 +378,13 @@ CZ80ACpu::CZ80ACpu(
     m_addressRemapCallbackContext(addressRemapCallbackContext),
     m_dataRemapCallback(dataRemapCallback),
     m_dataRemapCallbackContext(dataRemapCallbackContext),
-    m_cycleType(cycleType)
+    m_cycleType(cycleType),
+    m_waitWindowMeasured(false),
+    m_waitWindowStartUs(0),
+    m_waitWindowLengthUs(0),
+    m_spinReportCycle(SPIN_CYCLE_COUNT - 1)
 {
+    resetMaxSpins();
 };
 
 //
@@ -403,6 +476,21 @@ CZ80ACpu::check(
     // The data bus should be uncontended and pulled high.
     CHECK_BUS_VALUE_UINT8_EXIT(error, m_busD, s_D_iot, 0xFF);
 
+    // Look for pin to pin shorts on the probe socket.
+    {
+        CPinShortCheck pinShortCheck(g_pinMap40DIL, s_pinShortCheck, ARRAYSIZE(s_pinShortCheck));
+
+        error = pinShortCheck.check();
+
+        // The short check leaves the pins released so restore the idle state.
+        idle();
+
+        if (FAILED(error))
+        {
+            goto Exit;
+        }
+    }
+
     // Loop to detect a clock by sampling and detecting both high and lows.
     {
         UINT16 hiCount = 0;
@@ -435,8 +523,8 @@ CZ80ACpu::check(
     //
     // Check if a none-zero VRAM address was supplied, indicating that the
     // WAIT toggling should be active for that access. This is checked here
-    // because there is no timeout in the bus cycles thus they hang if the
-    // VRAM WAIT hold off isn't working.
+    // because otherwise the bus cycles only time out with a stuck WAIT error
+    // if the VRAM WAIT hold off isn't working.
     //
 
     if (m_vramAddress != 0)
@@ -509,6 +597,8 @@ CZ80ACpu::memoryRead(
 
     register UINT8 r1;
     register UINT8 r2;
+    UINT16 spinClk = 0;
+    UINT16 spinSync = 0;
 
     // Before processing anything, perform any address remapping.
     if (m_addressRemapCallback)
@@ -536,20 +626,16 @@ CZ80ACpu::memoryRead(
 
     if (IS_WAIT_SPACE(address))
     {
-        *g_portOutB = ~(s_B3_BIT_OUT_MREQ);
-
-        // Wait for wait to become active (leaving HBLANK)
-        WAIT_FOR_WAIT_LO(r1,r2);
-
-        // Wait for wait to become inactive (start of HBLANK)
-        WAIT_FOR_WAIT_HI(r1,r2);
-
-        *g_portOutB = ~(0);
+        error = waitWindowSync();
+        if (FAILED(error))
+        {
+            goto Exit;
+        }
     }
     else if (m_cycleType == CYCLE_TYPE_DEFAULT)
     {
         // Wait for the clock edge
-        WAIT_FOR_CLK_RISING_EDGE(r1,r2);
+        WAIT_FOR_CLK_RISING_EDGE(r1,r2,spinClk,"Sync Rd");
     }
 
     // Select the address space based on the supplied address
@@ -568,7 +654,7 @@ CZ80ACpu::memoryRead(
             if (IS_SYNC_SPACE(address))
             {
                 // Wait for the clock edge
-                WAIT_FOR_CLK_FALLING_EDGE(r1,r2);
+                WAIT_FOR_CLK_FALLING_EDGE(r1,r2,spinSync,"Sync Rd");
             }
 
             error = MREQreadCrazyKong(data);
@@ -583,8 +669,14 @@ CZ80ACpu::memoryRead(
         }
     }
 
+Exit:
+
     interrupts();
 
+    recordSpins(IS_IO_SPACE(address) ? SPIN_CYCLE_IORQ_RD : SPIN_CYCLE_MREQ_RD,
+                (spinClk > spinSync) ? spinClk : spinSync,
+                0);
+
     // Before return perform any data remapping.
     if (SUCCESS(error))
     {
@@ -609,6 +701,8 @@ CZ80ACpu::memoryWrite(
 
     register UINT8 r1;
     register UINT8 r2;
+    UINT16 spinClk = 0;
+    UINT16 spinSync = 0;
 
     // Before processing anything, perform any address remapping.
     if (m_addressRemapCallback)
@@ -648,20 +742,16 @@ CZ80ACpu::memoryWrite(
 
     if (IS_WAIT_SPACE(address))
     {
-        *g_portOutB = ~(s_B3_BIT_OUT_MREQ);
-
-        // Wait for wait to become active (leaving HBLANK)
-        WAIT_FOR_WAIT_LO(r1,r2);
-
-        // Wait for wait to become inactive (start of HBLANK)
-        WAIT_FOR_WAIT_HI(r1,r2);
-
-        *g_portOutB = ~(0);
+        error = waitWindowSync();
+        if (FAILED(error))
+        {
+            goto Exit;
+        }
     }
     else if (m_cycleType == CYCLE_TYPE_DEFAULT)
     {
         // Wait for the clock edge
-        WAIT_FOR_CLK_RISING_EDGE(r1,r2);
+        WAIT_FOR_CLK_RISING_EDGE(r1,r2,spinClk,"Sync Wr");
     }
 
     // Select the address space based on the supplied address
@@ -680,7 +770,7 @@ CZ80ACpu::memoryWrite(
             if (IS_SYNC_SPACE(address))
             {
                 // Wait for the clock edge
-                WAIT_FOR_CLK_FALLING_EDGE(r1,r2);
+                WAIT_FOR_CLK_FALLING_EDGE(r1,r2,spinSync,"Sync Wr");
             }
 
             error = MREQwriteCrazyKong(data);
@@ -691,8 +781,110 @@ CZ80ACpu::memoryWrite(
         }
     }
 
+Exit:
+
     interrupts();
 
+    recordSpins(IS_IO_SPACE(address) ? SPIN_CYCLE_IORQ_WR : SPIN_CYCLE_MREQ_WR,
+                (spinClk > spinSync) ? spinClk : spinSync,
+                0);
+
+    return error;
+}
+
+
+
+//
+// Synchronise a WAIT space access to the start of an HBLANK window (WAIT
+// inactive). The window is timed on the first access and later accesses are
+// then issued without re-synchronising while they fall in the first half of
+// the current window, so several accesses are made per line rather than one.
+// The MREQ cycles still honour WAIT should the estimate be wrong.
+// Called with interrupts disabled. The window waits are bounded by the
+// spin budget but aren't recorded in the bus cycle spin counts.
+//
+PERROR
+CZ80ACpu::waitWindowSync(
+)
+{
+    PERROR error = errorSuccess;
+
+    register UINT8 r1;
+    UINT16 spinWait = 0;
+
+    if (m_waitWindowMeasured &&
+        ((micros() - m_waitWindowStartUs) < (m_waitWindowLengthUs / 2)))
+    {
+        return error;
+    }
+
+    *g_portOutB = ~(s_B3_BIT_OUT_MREQ);
+
+    // Wait for wait to become active (leaving HBLANK)
+    WAIT_FOR_WAIT_LO(r1,r1,spinWait,"Window");
+
+    // Wait for wait to become inactive (start of HBLANK)
+    WAIT_FOR_WAIT_HI(r1,r1,spinWait,"Window");
+
+    // Time this window to its end then sync to the start of the next.
+    if (!m_waitWindowMeasured)
+    {
+        UINT32 startUs = micros();
+
+        WAIT_FOR_WAIT_LO(r1,r1,spinWait,"Window");
+
+        m_waitWindowLengthUs = micros() - startUs;
+        m_waitWindowMeasured = true;
+
+        WAIT_FOR_WAIT_HI(r1,r1,spinWait,"Window");
+    }
+
+    *g_portOutB = ~(0);
+
+    m_waitWindowStartUs = micros();
+
+Exit:
+
+    return error;
+}
+
+//
+// Read with the data bus pre-charged high and then pre-charged low with the
+// pullups disabled. A bit that follows the pre-charge isn't being driven.
+//
+PERROR
+CZ80ACpu::memoryReadFloating(
+    UINT32 address,
+    UINT16 *data,
+    UINT16 *floating
+)
+{
+    PERROR error = errorSuccess;
+    UINT16 dataLo = 0;
+
+    m_busD.pinMode(OUTPUT);
+    m_busD.digitalWrite(0xFF);
+    m_busD.pinMode(INPUT);
+
+    error = memoryRead(address, data);
+
+    if (SUCCESS(error))
+    {
+        m_busD.pinMode(OUTPUT);
+        m_busD.digitalWrite(0x00);
+        m_busD.pinMode(INPUT);
+
+        error = memoryRead(address, &dataLo);
+    }
+
+    // Return to the idle pulled high state.
+    m_busD.pinMode(INPUT_PULLUP);
+
+    if (SUCCESS(error))
+    {
+        *floating = (*data ^ dataLo) & 0xFF;
+    }
+
     return error;
 }
 
@@ -757,12 +949,14 @@ CZ80ACpu::acknowledgeInterrupt(
 
     register UINT8 r1;
     register UINT8 r2;
+    UINT16 spinClk = 0;
+    UINT16 spinWait = 0;
     register UINT8 r3;
     register UINT8 r4;
     register UINT8 r5;
 
     // Wait for the clock edge
-    WAIT_FOR_CLK_RISING_EDGE(r1,r2);
+    WAIT_FOR_CLK_RISING_EDGE(r1,r2,spinClk,"INTA");
 
     // Start the cycle by assert the control line M1
     m_pin_M1.digitalWrite(LOW);
@@ -780,7 +974,7 @@ CZ80ACpu::acknowledgeInterrupt(
 
     // Wait for WAIT to be deasserted.
     // Port L requires an "lds" to access so no wait state needed from above.
-    WAIT_FOR_WAIT_HI(r1,r2);
+    WAIT_FOR_WAIT_HI(r1,r2,spinWait,"INTA");
 
     *g_portOutB = ~(s_B1_BIT_OUT_IORQ); // Wait state
 
@@ -807,6 +1001,139 @@ CZ80ACpu::acknowledgeInterrupt(
 
 Exit:
 
+    m_pin_M1.digitalWrite(HIGH);
+
+    interrupts();
+
+    recordSpins(SPIN_CYCLE_INTA, spinClk, spinWait);
+
+    return error;
+}
+
+
+//
+// Returns the probe connection for the logical address or data bus bit.
+//
+const CONNECTION *
+CZ80ACpu::busConnection(
+    Bus   bus,
+    UINT8 bit
+)
+{
+    const CONNECTION *connection = (const CONNECTION *) NULL;
+
+    if ((bus == ADDRESS) && (bit < ARRAYSIZE(s_A_ot)))
+    {
+        connection = &s_A_ot[bit];
+    }
+    else if ((bus == DATA) && (bit < ARRAYSIZE(s_D_iot)))
+    {
+        connection = &s_D_iot[bit];
+    }
+
+    return connection;
+}
+
+
+void
+CZ80ACpu::maxSpins(
+    SpinCycle cycle,
+    UINT16    *clk,
+    UINT16    *wait
+)
+{
+    *clk  = m_maxSpinClk[cycle];
+    *wait = m_maxSpinWait[cycle];
+}
+
+
+void
+CZ80ACpu::resetMaxSpins(
+)
+{
+    for (UINT8 cycle = 0 ; cycle < SPIN_CYCLE_COUNT ; cycle++)
+    {
+        m_maxSpinClk[cycle]  = 0;
+        m_maxSpinWait[cycle] = 0;
+    }
+}
+
+
+//
+// The clock count is followed by the wait count.
+//
+// 0123456789abcdef
+// OK:MRd 0004 0123
+//
+PERROR
+CZ80ACpu::spinReport(
+)
+{
+    PERROR error = errorCustom;
+    UINT8 cycle;
+
+    m_spinReportCycle = (m_spinReportCycle + 1) % SPIN_CYCLE_COUNT;
+    cycle = m_spinReportCycle;
+
+    error->code = ERROR_SUCCESS;
+    error->description = "OK:";
+    error->description += (cycle == SPIN_CYCLE_MREQ_RD) ? "MRd" :
+                          (cycle == SPIN_CYCLE_MREQ_WR) ? "MWr" :
+                          (cycle == SPIN_CYCLE_IORQ_RD) ? "IRd" :
+                          (cycle == SPIN_CYCLE_IORQ_WR) ? "IWr" : "INT";
+    STRING_UINT16_HEX(error->description, m_maxSpinClk[cycle]);
+    STRING_UINT16_HEX(error->description, m_maxSpinWait[cycle]);
+
+    m_maxSpinClk[cycle]  = 0;
+    m_maxSpinWait[cycle] = 0;
+
+    return error;
+}
+
+
+//
+// Called after the bus cycle has been terminated so the bookkeeping doesn't
+// affect the cycle timing.
+//
+void
+CZ80ACpu::recordSpins(
+    SpinCycle cycle,
+    UINT16    clk,
+    UINT16    wait
+)
+{
+    if (clk > m_maxSpinClk[cycle])
+    {
+        m_maxSpinClk[cycle] = clk;
+    }
+
+    if (wait > m_maxSpinWait[cycle])
+    {
+        m_maxSpinWait[cycle] = wait;
+    }
+}
+
+
+//
+// 0123456789abcdef
+// E:WAIT=0 MREQ Rd
+// E:CLK=1 Sync Wr
+//
+PERROR
+CZ80ACpu::stuck(
+    const char *signal,
+    UINT8      level,
+    const char *phase
+)
+{
+    PERROR error = errorCustom;
+
+    error->code = ERROR_FAILED;
+    error->description = "E:";
+    error->description += signal;
+    error->description += (level ? "=1 " : "=0 ");
+    error->description += phase;
+
     return error;
 }
 
@@ -820,6 +1147,7 @@ CZ80ACpu::MREQread(
 
     register UINT8 r1;
     register UINT8 r2;
+    UINT16 spinWait = 0;
     register UINT8 r3;
     register UINT8 r4;
     register UINT8 r5;
@@ -830,7 +1158,7 @@ CZ80ACpu::MREQread(
 
     // Wait for WAIT to be deasserted.
     // Port L requires an "lds" to access so no wait state needed from above.
-    WAIT_FOR_WAIT_HI(r1,r2);
+    WAIT_FOR_WAIT_HI(r1,r2,spinWait,"MREQ Rd");
 
     *g_portOutB = ~(s_B3_BIT_OUT_MREQ | s_B0_BIT_OUT_RD); // Wait state
 
@@ -856,6 +1184,8 @@ CZ80ACpu::MREQread(
 
 Exit:
 
+    recordSpins(SPIN_CYCLE_MREQ_RD, 0, spinWait);
+
     return error;
 }
 
@@ -869,6 +1199,7 @@ CZ80ACpu::MREQwrite(
 
     register UINT8 r1;
     register UINT8 r2;
+    UINT16 spinWait = 0;
     register UINT8 r3;
     register UINT8 r4;
     register UINT8 r5;
@@ -879,7 +1210,7 @@ CZ80ACpu::MREQwrite(
 
     // Wait for WAIT to be deasserted.
     // Port L requires an "lds" to access so no wait state needed from above.
-    WAIT_FOR_WAIT_HI(r1,r2);
+    WAIT_FOR_WAIT_HI(r1,r2,spinWait,"MREQ Wr");
 
     *g_portOutB = ~(s_B3_BIT_OUT_MREQ | s_B2_BIT_OUT_WR);  // Wait state
 
@@ -895,6 +1226,8 @@ CZ80ACpu::MREQwrite(
 
 Exit:
 
+    recordSpins(SPIN_CYCLE_MREQ_WR, 0, spinWait);
+
     return error;
 }
 
@@ -908,12 +1241,14 @@ CZ80ACpu::MREQreadPuckman(
 
     register UINT8 r1;
     register UINT8 r2;
+    UINT16 spinClk = 0;
+    UINT16 spinWait = 0;
     register UINT8 r3;
     register UINT8 r4;
     register UINT8 r5;
 
     // Wait for the clock edge
-    WAIT_FOR_CLK_FALLING_EDGE(r1,r2);
+    WAIT_FOR_CLK_FALLING_EDGE(r1,r2,spinClk,"MREQ Rd");
 
     // Start the cycle by assert the control lines
     *g_portOutB = ~(s_B3_BIT_OUT_MREQ | s_B0_BIT_OUT_RD);
@@ -927,7 +1262,7 @@ CZ80ACpu::MREQreadPuckman(
 
     // Wait for WAIT to be deasserted.
     // Port L requires an "lds" to access so no wait state needed from above.
-    WAIT_FOR_WAIT_HI(r1,r2);
+    WAIT_FOR_WAIT_HI(r1,r2,spinWait,"MREQ Rd");
 
     // Read in reverse order - port L is a slower access.
     r1 = *g_portInL;
@@ -951,6 +1286,8 @@ CZ80ACpu::MREQreadPuckman(
 
 Exit:
 
+    recordSpins(SPIN_CYCLE_MREQ_RD, spinClk, spinWait);
+
     return error;
 }
 
@@ -964,12 +1301,14 @@ CZ80ACpu::MREQwritePuckman(
 
     register UINT8 r1;
     register UINT8 r2;
+    UINT16 spinClk = 0;
+    UINT16 spinWait = 0;
     register UINT8 r3;
     register UINT8 r4;
     register UINT8 r5;
 
     // Wait for the clock edge
-    WAIT_FOR_CLK_FALLING_EDGE(r1,r2);
+    WAIT_FOR_CLK_FALLING_EDGE(r1,r2,spinClk,"MREQ Wr");
 
     // Start the cycle by assert the control lines
     *g_portOutB = ~(s_B3_BIT_OUT_MREQ);
@@ -983,7 +1322,7 @@ CZ80ACpu::MREQwritePuckman(
 
     // Wait for WAIT to be deasserted.
     // Port L requires an "lds" to access so no wait state needed from above.
-    WAIT_FOR_WAIT_HI(r1,r2);
+    WAIT_FOR_WAIT_HI(r1,r2,spinWait,"MREQ Wr");
 
     // This is a write but we keep these here to match the read cycle timing.
     r1 = *g_portInL;
@@ -997,6 +1336,8 @@ CZ80ACpu::MREQwritePuckman(
 
 Exit:
 
+    recordSpins(SPIN_CYCLE_MREQ_WR, spinClk, spinWait);
+
     return error;
 }
 
@@ -1010,6 +1351,7 @@ CZ80ACpu::MREQreadCrazyKong(
 
     register UINT8 r1;
     register UINT8 r2;
+    UINT16 spinWait = 0;
     register UINT8 r3;
     register UINT8 r4;
     register UINT8 r5;
@@ -1027,7 +1369,7 @@ CZ80ACpu::MREQreadCrazyKong(
 
     // Wait for WAIT to be deasserted.
     // Port L requires an "lds" to access so no wait state needed from above.
-    WAIT_FOR_WAIT_HI(r1,r2);
+    WAIT_FOR_WAIT_HI(r1,r2,spinWait,"MREQ Rd");
 
     // Read in reverse order - port L is a slower access.
     r1 = *g_portInL;
@@ -1051,6 +1393,8 @@ CZ80ACpu::MREQreadCrazyKong(
 
 Exit:
 
+    recordSpins(SPIN_CYCLE_MREQ_RD, 0, spinWait);
+
     return error;
 }
 
@@ -1064,6 +1408,7 @@ CZ80ACpu::MREQwriteCrazyKong(
 
     register UINT8 r1;
     register UINT8 r2;
+    UINT16 spinWait = 0;
     register UINT8 r3;
     register UINT8 r4;
     register UINT8 r5;
@@ -1081,7 +1426,7 @@ CZ80ACpu::MREQwriteCrazyKong(
 
     // Wait for WAIT to be deasserted.
     // Port L requires an "lds" to access so no wait state needed from above.
-    WAIT_FOR_WAIT_HI(r1,r2);
+    WAIT_FOR_WAIT_HI(r1,r2,spinWait,"MREQ Wr");
 
     // This is a write but we keep these here to match the read cycle timing.
     r1 = *g_portInL;
@@ -1095,6 +1440,8 @@ CZ80ACpu::MREQwriteCrazyKong(
 
 Exit:
 
+    recordSpins(SPIN_CYCLE_MREQ_WR, 0, spinWait);
+
     return error;
 }
 
@@ -1108,6 +1455,7 @@ CZ80ACpu::MREQreadLadybug(
 
     register UINT8 r1;
     register UINT8 r2;
+    UINT16 spinWait = 0;
     register UINT8 r3;
     register UINT8 r4;
     register UINT8 r5;
@@ -1121,7 +1469,7 @@ CZ80ACpu::MREQreadLadybug(
 
     // Wait for WAIT to be deasserted.
     // Port L requires an "lds" to access so no wait state needed from above.
-    WAIT_FOR_WAIT_HI(r1,r2);
+    WAIT_FOR_WAIT_HI(r1,r2,spinWait,"MREQ Rd");
 
     *g_portOutB = ~(s_B3_BIT_OUT_MREQ | s_B0_BIT_OUT_RD); // Wait state
 
@@ -1147,6 +1495,8 @@ CZ80ACpu::MREQreadLadybug(
 
 Exit:
 
+    recordSpins(SPIN_CYCLE_MREQ_RD, 0, spinWait);
+
     return error;
 }
 
@@ -1160,6 +1510,7 @@ CZ80ACpu::IORQread(
 
     register UINT8 r1;
     register UINT8 r2;
+    UINT16 spinWait = 0;
     register UINT8 r3;
     register UINT8 r4;
     register UINT8 r5;
@@ -1178,7 +1529,7 @@ CZ80ACpu::IORQread(
 
     // Wait for WAIT to be deasserted.
     // Port L requires an "lds" to access so no wait state needed from above.
-    WAIT_FOR_WAIT_HI(r1,r2);
+    WAIT_FOR_WAIT_HI(r1,r2,spinWait,"IORQ Rd");
 
     *g_portOutB = ~(s_B1_BIT_OUT_IORQ | s_B0_BIT_OUT_RD); // Wait state
 
@@ -1204,6 +1555,8 @@ CZ80ACpu::IORQread(
 
 Exit:
 
+    recordSpins(SPIN_CYCLE_IORQ_RD, 0, spinWait);
+
     return error;
 }
 
@@ -1217,6 +1570,7 @@ CZ80ACpu::IORQwrite(
 
     register UINT8 r1;
     register UINT8 r2;
+    UINT16 spinWait = 0;
     register UINT8 r3;
     register UINT8 r4;
     register UINT8 r5;
@@ -1235,7 +1589,7 @@ CZ80ACpu::IORQwrite(
 
     // Wait for WAIT to be deasserted.
     // Port L requires an "lds" to access so no wait state needed from above.
-    WAIT_FOR_WAIT_HI(r1,r2);
+    WAIT_FOR_WAIT_HI(r1,r2,spinWait,"IORQ Wr");
 
     *g_portOutB = ~(s_B1_BIT_OUT_IORQ | s_B2_BIT_OUT_WR);
 
@@ -1251,6 +1605,8 @@ CZ80ACpu::IORQwrite(
 
 Exit:
 
+    recordSpins(SPIN_CYCLE_IORQ_WR, 0, spinWait);
+
     return error;
 }
 
@@ -47,14 +47,23 @@ class CZ80ACpu : public ICpu
             CYCLE_TYPE_LADYBUG
         } CycleType;
 
+        typedef enum {
+            SPIN_CYCLE_MREQ_RD,
+            SPIN_CYCLE_MREQ_WR,
+            SPIN_CYCLE_IORQ_RD,
+            SPIN_CYCLE_IORQ_WR,
+            SPIN_CYCLE_INTA,
+            SPIN_CYCLE_COUNT
+        } SpinCycle;
+
         //
         // Constructor
         //
         // vramAddress
         //  If a none-zero VRAM address is supplied then WAIT toggling should be
         //  active for that access. This is verified in the "check" function
-        //  because there is no timeout in the bus cycles and thus they hang if the
-        //  VRAM WAIT hold-off isn't working.
+        //  because otherwise the bus cycles only fail with a stuck WAIT timeout
+        //  if the VRAM WAIT hold-off isn't working.
         //
         // addressRemapCallback
         //  If this is supplied then the callback is made as the first action
@@ -105,7 +114,7 @@ class CZ80ACpu : public ICpu
         // Z80A Address Space:
         // 0x000000 -> 0x00FFFF - Memory Mapped Data
         // 0x010000 -> 0x01FFFF - Input/Output Ports
-        // 0x1xxxxx             - WAIT pre-synchronized space
+        // 0x1xxxxx             - WAIT pre-synchronized space (several accesses per HBLANK window)
 
         virtual PERROR memoryRead(
             UINT32 address,
@@ -117,6 +126,12 @@ class CZ80ACpu : public ICpu
             UINT16 data
         );
 
+        virtual PERROR memoryReadFloating(
+            UINT32 address,
+            UINT16 *data,
+            UINT16 *floating
+        );
+
         virtual
         PERROR
         waitForInterrupt(
@@ -131,10 +146,41 @@ class CZ80ACpu : public ICpu
             UINT16 *response
         );
 
+        virtual
+        const CONNECTION *
+        busConnection(
+            Bus   bus,
+            UINT8 bit
+        );
+
         //
         // CZ80ACpu Interface
         //
 
+        //
+        // The most polls of CLK and WAIT made in a single wait by the bus
+        // cycles of the given kind since the last reset. Used to tune the
+        // spin budget that times out a stuck CLK or WAIT.
+        //
+        void
+        maxSpins(
+            SpinCycle cycle,
+            UINT16    *clk,
+            UINT16    *wait
+        );
+
+        void
+        resetMaxSpins(
+        );
+
+        //
+        // The max spin counts of the next cycle kind for the LCD, which are
+        // then reset. Each call steps to the next kind.
+        //
+        PERROR
+        spinReport(
+        );
+
     private:
 
         //
@@ -200,6 +246,24 @@ class CZ80ACpu : public ICpu
             UINT16 *data
         );
 
+        PERROR
+        waitWindowSync(
+        );
+
+        void
+        recordSpins(
+            SpinCycle cycle,
+            UINT16    clk,
+            UINT16    wait
+        );
+
+        PERROR
+        stuck(
+            const char *signal,
+            UINT8      level,
+            const char *phase
+        );
+
     private:
 
         CBus          m_busA;
@@ -221,6 +285,14 @@ class CZ80ACpu : public ICpu
         void                 *m_dataRemapCallbackContext;
         CycleType             m_cycleType;
 
+        bool                  m_waitWindowMeasured;
+        UINT32                m_waitWindowStartUs;
+        UINT32                m_waitWindowLengthUs;
+
+        UINT16                m_maxSpinClk[SPIN_CYCLE_COUNT];
+        UINT16                m_maxSpinWait[SPIN_CYCLE_COUNT];
+        UINT8                 m_spinReportCycle;
+
 };
 
 #endif
@@ -26,6 +26,7 @@
 #include "Error.h"
 #include "CZ80Cpu.h"
 #include "PinMap.h"
+#include "CPinShortCheck.h"
 
 
 //
@@ -90,6 +91,36 @@ static const CONNECTION s_D_iot[] = { {14, "D0" },
                                       {10, "D6" },
                                       {13, "D7" } }; // 8 bits.
 
+//
+// The CPU output and bus pins checked for pin to pin shorts.
+// Power, clock and input pins driven by the board are excluded. /MREQ,
+// /IORQ, /RD & /WR are strobes so a read or write is never started.
+//
+static const CONNECTION_GROUP s_pinShortCheck[] = { {&s__HALT_o,   1},
+                                                    {&s__MREQ_ot,  1, true},
+                                                    {&s__IORQ_ot,  1, true},
+                                                    {&s__RD_ot,    1, true},
+                                                    {&s__WR_ot,    1, true},
+                                                    {&s__BUSACK_o, 1},
+                                                    {&s__M1_o,     1},
+                                                    {&s__RFSH_ot,  1},
+                                                    {s_A_ot,       ARRAYSIZE(s_A_ot)},
+                                                    {s_D_iot,      ARRAYSIZE(s_D_iot)} };
+
+
+//
+// WAIT calibration. The default budget is used until calibrated and for the
+// IO space. A calibrated budget is the slowest release seen at the start and
+// end of every ROM & RAM region plus 50% and a small margin. Latencies of
+// more than half the default budget are flagged as marginal.
+//
+static const UINT8  s_defaultWaitBudget     = 64;
+static const UINT8  s_waitMargin            = 4;
+static const UINT8  s_marginalWaitBin       = 6;
+static const UINT8  s_calibrationCycles     = 64;
+static const UINT8  s_calibrationPolls      = 255;
+static const UINT8  s_lateAssertPolls       = 16;
+
 
 CZ80Cpu::CZ80Cpu(
     UINT32                vramAddress,
@@ -108,8 +139,20 @@ CZ80Cpu::CZ80Cpu(
     m_addressRemapCallback(addressRemapCallback),
     m_addressRemapCallbackContext(addressRemapCallbackContext),
     m_dataRemapCallback(dataRemapCallback),
-    m_dataRemapCallbackContext(dataRemapCallbackContext)
+    m_dataRemapCallbackContext(dataRemapCallbackContext),
+    m_waitWindowMeasured(false),
+    m_waitWindowStartUs(0),
+    m_waitWindowLengthUs(0),
+    m_waitRomRegion(NULL),
+    m_waitRamRegion(NULL)
 {
+    for (UINT8 space = 0 ; space < WAIT_SPACE_COUNT ; space++)
+    {
+        m_waitBudget[space]    = s_defaultWaitBudget;
+        m_waitPreSample[space] = 0;
+
+        memset(m_waitHistogram[space], 0, sizeof(m_waitHistogram[space]));
+    }
 };
 
 //
@@ -200,6 +243,21 @@ CZ80Cpu::check(
     // The data bus should be uncontended and pulled high.
     CHECK_BUS_VALUE_UINT8_EXIT(error, m_busD, s_D_iot, 0xFF);
 
+    // Look for pin to pin shorts on the probe socket.
+    {
+        CPinShortCheck pinShortCheck(g_pinMap40DIL, s_pinShortCheck, ARRAYSIZE(s_pinShortCheck));
+
+        error = pinShortCheck.check();
+
+        // The short check leaves the pins released so restore the idle state.
+        idle();
+
+        if (FAILED(error))
+        {
+            goto Exit;
+        }
+    }
+
     // Loop to detect a clock by sampling and detecting both high and lows.
     {
         UINT16 hiCount = 0;
@@ -232,7 +290,7 @@ CZ80Cpu::check(
     //
     // Check if a none-zero VRAM address was supplied, indicating that the
     // WAIT toggling should be active for that access. This is checked here
-    // because there is no timeout in the bus cycles thus they hang if the
+    // because otherwise the bus cycles only fail with a WAIT timeout if the
     // VRAM WAIT hold off isn't working.
     //
 
@@ -273,6 +331,8 @@ CZ80Cpu::check(
         m_busA.pinMode(INPUT);
     }
 
+    error = calibrateWait();
+
 Exit:
     return error;
 }
@@ -325,6 +385,8 @@ CZ80Cpu::memoryRead(
 {
     PERROR error = errorSuccess;
     bool interruptsDisabled = false;
+    WaitSpace space = WAIT_SPACE_MEM;
+    UINT16 polls = 0;
 
     // Before processing anything, perform any address remapping.
     if (m_addressRemapCallback)
@@ -347,6 +409,16 @@ CZ80Cpu::memoryRead(
     // Select the address space based on the supplied address
     selectAddressSpace(address);
 
+    if (address & 0x100000)
+    {
+        space = WAIT_SPACE_VRAM;
+    }
+    else if ((address >= (UINT32) 0x10000) &&
+             (address <= (UINT32) 0x1FFFF))
+    {
+        space = WAIT_SPACE_IO;
+    }
+
     // Critical timing section
     noInterrupts();
     interruptsDisabled = true;
@@ -363,33 +435,21 @@ CZ80Cpu::memoryRead(
 
         if (address & 0x100000)
         {
-            // Wait for wait to become active (leaving HBLANK)
-            for (int i = 0 ; i < 4096 ; i++)
+            error = waitWindowSync();
+            if (FAILED(error))
             {
-                waitValue = m_pin_WAIT.digitalRead();
-
-                if (waitValue == LOW)
-                {
-                    break;
-                }
+                goto Exit;
             }
-            CHECK_LITERAL_VALUE_EXIT(error, s__WAIT_i, waitValue, LOW);
-
-            // Wait for wait to become inactive (start of HBLANK)
-            for (int i = 0 ; i < 4096 ; i++)
-            {
-                waitValue = m_pin_WAIT.digitalRead();
+        }
 
-                if (waitValue == HIGH)
-                {
-                    break;
-                }
-            }
-            CHECK_LITERAL_VALUE_EXIT(error, s__WAIT_i, waitValue, HIGH);
+        // Give a late WAIT generator time to assert WAIT before it's sampled.
+        for (UINT8 i = m_waitPreSample[space] ; i != 0 ; i--)
+        {
+            (void) m_pin_WAIT.digitalRead();
         }
 
         // Perform a usual cycle.
-        for (int i = 0 ; i < 64 ; i++)
+        for (polls = 0 ; polls < m_waitBudget[space] ; polls++)
         {
             waitValue = m_pin_WAIT.digitalRead();
 
@@ -410,6 +470,8 @@ CZ80Cpu::memoryRead(
     m_pin_MREQ.digitalWriteHIGH();
     m_pin_IORQ.digitalWriteHIGH();
 
+    recordWait(space, polls);
+
     // Before return perform any data remapping.
     if (SUCCESS(error))
     {
@@ -438,6 +500,8 @@ CZ80Cpu::memoryWrite(
 {
     PERROR error = errorSuccess;
     bool interruptsDisabled = false;
+    WaitSpace space = WAIT_SPACE_MEM;
+    UINT16 polls = 0;
 
     // Before processing anything, perform any address remapping.
     if (m_addressRemapCallback)
@@ -472,6 +536,16 @@ CZ80Cpu::memoryWrite(
     // Select the address space based on the supplied address
     selectAddressSpace(address);
 
+    if (address & 0x100000)
+    {
+        space = WAIT_SPACE_VRAM;
+    }
+    else if ((address >= (UINT32) 0x10000) &&
+             (address <= (UINT32) 0x1FFFF))
+    {
+        space = WAIT_SPACE_IO;
+    }
+
     // Critical timing section
     noInterrupts();
     interruptsDisabled = true;
@@ -488,32 +562,20 @@ CZ80Cpu::memoryWrite(
 
         if (address & 0x100000)
         {
-            // Wait for wait to become active (leaving HBLANK)
-            for (int i = 0 ; i < 4096 ; i++)
+            error = waitWindowSync();
+            if (FAILED(error))
             {
-                waitValue = m_pin_WAIT.digitalRead();
-
-                if (waitValue == LOW)
-                {
-                    break;
-                }
+                goto Exit;
             }
-            CHECK_LITERAL_VALUE_EXIT(error, s__WAIT_i, waitValue, LOW);
-
-            // Wait for wait to become inactive (start of HBLANK)
-            for (int i = 0 ; i < 4096 ; i++)
-            {
-                waitValue = m_pin_WAIT.digitalRead();
+        }
 
-                if (waitValue == HIGH)
-                {
-                    break;
-                }
-            }
-            CHECK_LITERAL_VALUE_EXIT(error, s__WAIT_i, waitValue, HIGH);
+        // Give a late WAIT generator time to assert WAIT before it's sampled.
+        for (UINT8 i = m_waitPreSample[space] ; i != 0 ; i--)
+        {
+            (void) m_pin_WAIT.digitalRead();
         }
 
-        for (int i = 0 ; i < 64 ; i++)
+        for (polls = 0 ; polls < m_waitBudget[space] ; polls++)
         {
             waitValue = m_pin_WAIT.digitalRead();
 
@@ -534,6 +596,8 @@ CZ80Cpu::memoryWrite(
     m_pin_MREQ.digitalWriteHIGH();
     m_pin_IORQ.digitalWriteHIGH();
 
+    recordWait(space, polls);
+
 Exit:
 
     if (interruptsDisabled)
@@ -545,6 +609,443 @@ Exit:
 }
 
 
+
+//
+// Synchronise a Money Money V-RAM access to the start of an HBLANK window
+// (WAIT inactive). The window is timed on the first access and later accesses
+// are then issued without re-synchronising while they fall in the first half
+// of the current window, so several accesses are made per line rather than one.
+// Called with the cycle strobe asserted and interrupts disabled.
+//
+PERROR
+CZ80Cpu::waitWindowSync(
+)
+{
+    PERROR error = errorSuccess;
+
+    if (m_waitWindowMeasured &&
+        ((micros() - m_waitWindowStartUs) < (m_waitWindowLengthUs / 2)))
+    {
+        return errorSuccess;
+    }
+
+    // Wait for wait to become active (leaving HBLANK)
+    error = waitForWait(LOW);
+    if (FAILED(error))
+    {
+        goto Exit;
+    }
+
+    // Wait for wait to become inactive (start of HBLANK)
+    error = waitForWait(HIGH);
+    if (FAILED(error))
+    {
+        goto Exit;
+    }
+
+    // Time this window to its end then sync to the start of the next.
+    if (!m_waitWindowMeasured)
+    {
+        UINT32 startUs = micros();
+
+        error = waitForWait(LOW);
+        if (FAILED(error))
+        {
+            goto Exit;
+        }
+
+        m_waitWindowLengthUs = micros() - startUs;
+        m_waitWindowMeasured = true;
+
+        error = waitForWait(HIGH);
+        if (FAILED(error))
+        {
+            goto Exit;
+        }
+    }
+
+    m_waitWindowStartUs = micros();
+
+Exit:
+    return error;
+}
+
+
+PERROR
+CZ80Cpu::waitForWait(
+    int value
+)
+{
+    PERROR error = errorSuccess;
+    int waitValue;
+
+    for (int i = 0 ; i < 4096 ; i++)
+    {
+        waitValue = m_pin_WAIT.digitalRead();
+
+        if (waitValue == value)
+        {
+            break;
+        }
+    }
+    CHECK_LITERAL_VALUE_EXIT(error, s__WAIT_i, waitValue, value);
+
+Exit:
+    return error;
+}
+
+//
+// Calibrate the WAIT poll budget and pre-sample delay of the memory space and,
+// if a V-RAM address was supplied, the V-RAM space. The start and end of every
+// region in the tables supplied with setWaitCalibrationRegions() are sampled,
+// otherwise address 0 and the V-RAM address. A space's budget & pre-sample are
+// only changed if every sampled cycle completes. The histograms are then
+// cleared so they only record the cycles made by the tests that follow.
+//
+PERROR
+CZ80Cpu::calibrateWait(
+)
+{
+    PERROR error = errorSuccess;
+    WAIT_SAMPLE sample[WAIT_SPACE_COUNT];
+
+    memset(sample, 0, sizeof(sample));
+
+    if ((m_waitRomRegion == NULL) && (m_waitRamRegion == NULL))
+    {
+        error = sampleWait(0x0000, sample);
+        if (FAILED(error))
+        {
+            goto Exit;
+        }
+    }
+
+    if (m_waitRomRegion != NULL)
+    {
+        for (int index = 0 ; m_waitRomRegion->valid(index) ; index++)
+        {
+            ROM_REGION region = (*m_waitRomRegion)[index];
+
+            error = sampleWait(region.start, sample);
+            if (SUCCESS(error))
+            {
+                error = sampleWait(region.start + region.length - 1, sample);
+            }
+            if (FAILED(error))
+            {
+                goto Exit;
+            }
+        }
+    }
+
+    if (m_waitRamRegion != NULL)
+    {
+        for (int index = 0 ; m_waitRamRegion->valid(index) ; index++)
+        {
+            RAM_REGION region = (*m_waitRamRegion)[index];
+
+            error = sampleWait(region.start, sample);
+            if (SUCCESS(error))
+            {
+                error = sampleWait(region.end, sample);
+            }
+            if (FAILED(error))
+            {
+                goto Exit;
+            }
+        }
+    }
+
+    if ((m_vramAddress != 0) && (sample[WAIT_SPACE_VRAM].cycles == 0))
+    {
+        error = sampleWait(m_vramAddress, sample);
+        if (FAILED(error))
+        {
+            goto Exit;
+        }
+    }
+
+    for (UINT8 space = 0 ; space < WAIT_SPACE_COUNT ; space++)
+    {
+        if ((space != WAIT_SPACE_IO) && (sample[space].cycles != 0))
+        {
+            UINT16 budget = (UINT16) sample[space].maxRelease + (sample[space].maxRelease / 2) + s_waitMargin;
+
+            m_waitBudget[space]    = (budget > 0xFF) ? 0xFF : (UINT8) budget;
+            m_waitPreSample[space] = sample[space].lateAssert ? (sample[space].maxAssert + 1) : 0;
+        }
+
+        memset(m_waitHistogram[space], 0, sizeof(m_waitHistogram[space]));
+    }
+
+Exit:
+    return error;
+}
+
+
+//
+// Sample WAIT from the start of a number of read cycles of the address to find
+// the latest release of WAIT and, if WAIT is asserted after the cycle starts
+// rather than immediately, the latest assertion. Sampling continues past the
+// release to catch a late assertion. The results are merged into the sample of
+// the address's space. IO addresses are skipped as reads may have side effects.
+//
+PERROR
+CZ80Cpu::sampleWait(
+    UINT32      address,
+    WAIT_SAMPLE sample[]
+)
+{
+    PERROR error = errorSuccess;
+    bool interruptsDisabled = false;
+    WaitSpace space = WAIT_SPACE_MEM;
+
+    if (m_addressRemapCallback)
+    {
+        error = m_addressRemapCallback(m_addressRemapCallbackContext,
+                                       address, &address);
+        if (FAILED(error))
+        {
+            return error;
+        }
+    }
+
+    if (address & 0x100000)
+    {
+        space = WAIT_SPACE_VRAM;
+    }
+    else if ((address >= (UINT32) 0x10000) &&
+             (address <= (UINT32) 0x1FFFF))
+    {
+        return errorSuccess;
+    }
+
+    m_busA.pinMode(OUTPUT);
+    m_busA.digitalWrite((UINT16) (address & 0xFFFF));
+    m_busD.pinMode(INPUT);
+
+    for (UINT8 cycle = 0 ; cycle < s_calibrationCycles ; cycle++)
+    {
+        UINT8 firstLow = s_calibrationPolls;
+        UINT8 release = s_calibrationPolls;
+        int waitValue = LOW;
+
+        selectAddressSpace(address);
+
+        noInterrupts();
+        interruptsDisabled = true;
+
+        m_pin_RD.digitalWriteLOW();
+
+        if (space == WAIT_SPACE_VRAM)
+        {
+            error = waitWindowSync();
+            if (FAILED(error))
+            {
+                goto Exit;
+            }
+        }
+
+        for (UINT8 poll = 0 ; poll < s_calibrationPolls ; poll++)
+        {
+            waitValue = m_pin_WAIT.digitalRead();
+
+            if (waitValue == LOW)
+            {
+                if (firstLow == s_calibrationPolls)
+                {
+                    firstLow = poll;
+                }
+
+                release = s_calibrationPolls;
+            }
+            else if (release == s_calibrationPolls)
+            {
+                release = poll;
+            }
+            else if ((poll - release) >= s_lateAssertPolls)
+            {
+                break;
+            }
+        }
+
+        m_pin_RD.digitalWriteHIGH();
+        m_pin_MREQ.digitalWriteHIGH();
+        m_pin_IORQ.digitalWriteHIGH();
+
+        interrupts();
+        interruptsDisabled = false;
+
+        CHECK_LITERAL_VALUE_EXIT(error, s__WAIT_i, waitValue, HIGH);
+
+        if (release > sample[space].maxRelease)
+        {
+            sample[space].maxRelease = release;
+        }
+
+        if ((firstLow != 0) && (firstLow != s_calibrationPolls))
+        {
+            sample[space].lateAssert = true;
+
+            if (firstLow > sample[space].maxAssert)
+            {
+                sample[space].maxAssert = firstLow;
+            }
+        }
+    }
+
+    sample[space].cycles += s_calibrationCycles;
+
+Exit:
+
+    if (interruptsDisabled)
+    {
+        m_pin_RD.digitalWriteHIGH();
+        m_pin_MREQ.digitalWriteHIGH();
+        m_pin_IORQ.digitalWriteHIGH();
+
+        interrupts();
+    }
+
+    m_busA.digitalWrite(~0);
+    m_busA.pinMode(INPUT);
+
+    return error;
+}
+
+
+//
+// The region tables are views owned by the game and must outlive the CPU.
+//
+void
+CZ80Cpu::setWaitCalibrationRegions(
+    const CRomRegionTable          *romRegion,
+    const CRegionTable<RAM_REGION> *ramRegion
+)
+{
+    m_waitRomRegion = romRegion;
+    m_waitRamRegion = ramRegion;
+}
+
+
+//
+// Called after the bus cycle has been terminated so the bookkeeping doesn't
+// affect the cycle timing.
+//
+void
+CZ80Cpu::recordWait(
+    WaitSpace space,
+    UINT16    polls
+)
+{
+    UINT8 bin = 0;
+
+    while ((polls != 0) && (bin < (s_waitBins - 1)))
+    {
+        polls >>= 1;
+        bin++;
+    }
+
+    if (m_waitHistogram[space][bin] != 0xFFFF)
+    {
+        m_waitHistogram[space][bin]++;
+    }
+}
+
+
+//
+// Each bin is shown scaled to 0-9 with '.' for an empty bin followed by
+// the poll budget. Fails if any cycle polled WAIT for half the default budget.
+//
+// 0123456789abcdef
+// OK:M 9731.... 0c
+// E:V 1.....19 40
+//
+PERROR
+CZ80Cpu::waitReport(
+    WaitSpace space
+)
+{
+    PERROR error = errorCustom;
+    UINT32 total = 0;
+    bool marginal = false;
+
+    for (UINT8 bin = 0 ; bin < s_waitBins ; bin++)
+    {
+        total += m_waitHistogram[space][bin];
+
+        if ((bin >= s_marginalWaitBin) && (m_waitHistogram[space][bin] != 0))
+        {
+            marginal = true;
+        }
+    }
+
+    error->code = marginal ? ERROR_FAILED : ERROR_SUCCESS;
+    error->description = marginal ? "E:" : "OK:";
+    error->description += (space == WAIT_SPACE_MEM) ? "M " :
+                          (space == WAIT_SPACE_IO)  ? "I " : "V ";
+
+    for (UINT8 bin = 0 ; bin < s_waitBins ; bin++)
+    {
+        UINT32 count = m_waitHistogram[space][bin];
+
+        if (count == 0)
+        {
+            error->description += '.';
+        }
+        else
+        {
+            error->description += (char) ('0' + ((count * 9 + total - 1) / total));
+        }
+    }
+
+    STRING_UINT8_HEX(error->description, m_waitBudget[space]);
+
+    return error;
+}
+
+
+//
+// Read with the data bus pre-charged high and then pre-charged low with the
+// pullups disabled. A bit that follows the pre-charge isn't being driven.
+//
+PERROR
+CZ80Cpu::memoryReadFloating(
+    UINT32 address,
+    UINT16 *data,
+    UINT16 *floating
+)
+{
+    PERROR error = errorSuccess;
+    UINT16 dataLo = 0;
+
+    m_busD.pinMode(OUTPUT);
+    m_busD.digitalWrite(0xFF);
+    m_busD.pinMode(INPUT);
+
+    error = memoryRead(address, data);
+
+    if (SUCCESS(error))
+    {
+        m_busD.pinMode(OUTPUT);
+        m_busD.digitalWrite(0x00);
+        m_busD.pinMode(INPUT);
+
+        error = memoryRead(address, &dataLo);
+    }
+
+    // Return to the idle pulled high state.
+    m_busD.pinMode(INPUT_PULLUP);
+
+    if (SUCCESS(error))
+    {
+        *floating = (*data ^ dataLo) & 0xFF;
+    }
+
+    return error;
+}
+
+
 PERROR
 CZ80Cpu::waitForInterrupt(
     Interrupt interrupt,
@@ -597,3 +1098,27 @@ CZ80Cpu::acknowledgeInterrupt(
     return error;
 }
 
+
+//
+// Returns the probe connection for the logical address or data bus bit.
+//
+const CONNECTION *
+CZ80Cpu::busConnection(
+    Bus   bus,
+    UINT8 bit
+)
+{
+    const CONNECTION *connection = (const CONNECTION *) NULL;
+
+    if ((bus == ADDRESS) && (bit < ARRAYSIZE(s_A_ot)))
+    {
+        connection = &s_A_ot[bit];
+    }
+    else if ((bus == DATA) && (bit < ARRAYSIZE(s_D_iot)))
+    {
+        connection = &s_D_iot[bit];
+    }
+
+    return connection;
+}
+
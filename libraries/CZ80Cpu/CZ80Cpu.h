@@ -30,6 +30,7 @@
 #include "CBus.h"
 #include "CFast8BitBus.h"
 #include "CFastPin.h"
+#include "CRegionTable.h"
 
 
 class CZ80Cpu : public ICpu
@@ -42,8 +43,7 @@ class CZ80Cpu : public ICpu
         // vramAddress
         //  If a none-zero VRAM address is supplied then WAIT toggling should be
         //  active for that access. This is verified in the "check" function
-        //  because there is no timeout in the bus cycles and thus they hang if the
-        //  VRAM WAIT hold-off isn't working.
+        //  before the WAIT latency of the access is calibrated.
         //
         // addressRemapCallback
         //  If this is supplied then the callback is made as the first action
@@ -93,7 +93,7 @@ class CZ80Cpu : public ICpu
         // 0x10000 -> 0x1FFFF - Input/Output Ports
         //
         // Game Specific Address Space
-        // 0x100000 -> 0x10FFFF - Money Money v-RAM WAIT-synchronized cycle.
+        // 0x100000 -> 0x10FFFF - Money Money v-RAM WAIT-synchronized cycle (windowed).
 
         virtual PERROR memoryRead(
             UINT32 address,
@@ -105,6 +105,12 @@ class CZ80Cpu : public ICpu
             UINT16 data
         );
 
+        virtual PERROR memoryReadFloating(
+            UINT32 address,
+            UINT16 *data,
+            UINT16 *floating
+        );
+
         virtual
         PERROR
         waitForInterrupt(
@@ -119,10 +125,57 @@ class CZ80Cpu : public ICpu
             UINT16 *response
         );
 
+        virtual
+        const CONNECTION *
+        busConnection(
+            Bus   bus,
+            UINT8 bit
+        );
+
         //
         // CZ80Cpu Interface
         //
 
+        //
+        // The address spaces with separate WAIT latency calibration.
+        //
+        typedef enum {
+            WAIT_SPACE_MEM,
+            WAIT_SPACE_IO,
+            WAIT_SPACE_VRAM,
+            WAIT_SPACE_COUNT
+        } WaitSpace;
+
+        //
+        // Supply the game's ROM & RAM region tables so that the WAIT latency
+        // is calibrated over every region rather than a single address.
+        //
+        void
+        setWaitCalibrationRegions(
+            const CRomRegionTable          *romRegion,
+            const CRegionTable<RAM_REGION> *ramRegion
+        );
+
+        //
+        // Measure the WAIT latency distribution of memory cycles (and V-RAM
+        // cycles if a V-RAM address was supplied) and set the poll budget and
+        // pre-sample delay of each to the smallest safe value. IO cycles keep
+        // the default because reads may have side effects.
+        // Called by check().
+        //
+        PERROR
+        calibrateWait(
+        );
+
+        //
+        // The WAIT latency histogram of an address space for the LCD.
+        // Fails if the latency is marginal.
+        //
+        PERROR
+        waitReport(
+            WaitSpace space
+        );
+
     private:
 
         void
@@ -130,8 +183,46 @@ class CZ80Cpu : public ICpu
             UINT32 address
         );
 
+        PERROR
+        waitWindowSync(
+        );
+
+        PERROR
+        waitForWait(
+            int value
+        );
+
+        //
+        // The worst case WAIT latency seen in the sampled cycles of a space.
+        //
+        typedef struct _WAIT_SAMPLE {
+
+            UINT16 cycles;
+            UINT8  maxRelease;
+            UINT8  maxAssert;
+            bool   lateAssert;
+
+        } WAIT_SAMPLE;
+
+        PERROR
+        sampleWait(
+            UINT32      address,
+            WAIT_SAMPLE sample[]
+        );
+
+        void
+        recordWait(
+            WaitSpace space,
+            UINT16    polls
+        );
+
     private:
 
+        //
+        // Log2 latency bins, 0, 1, 2-3, 4-7 ... 64+ polls.
+        //
+        static const UINT8 s_waitBins = 8;
+
         CBus          m_busA;
         CFast8BitBus  m_busD;
 
@@ -149,6 +240,17 @@ class CZ80Cpu : public ICpu
         DataRemapCallback     m_dataRemapCallback;
         void                 *m_dataRemapCallbackContext;
 
+        bool                  m_waitWindowMeasured;
+        UINT32                m_waitWindowStartUs;
+        UINT32                m_waitWindowLengthUs;
+
+        UINT8                 m_waitBudget[WAIT_SPACE_COUNT];
+        UINT8                 m_waitPreSample[WAIT_SPACE_COUNT];
+        UINT16                m_waitHistogram[WAIT_SPACE_COUNT][s_waitBins];
+
+        const CRomRegionTable          *m_waitRomRegion;
+        const CRegionTable<RAM_REGION> *m_waitRamRegion;
+
 };
 
 #endif
@@ -1,5 +1,6 @@
 #include "Arduino.h"
 #include "DFR_Key.h"
+#include <avr/interrupt.h>
 
 static int DEFAULT_KEY_PIN = 0;
 static int DEFAULT_THRESHOLD = 20;
@@ -35,6 +36,14 @@ static int DEFAULT_THRESHOLD = 20;
 	static int NOKEY_ARV	= 1023;
 #endif
 
+// The keypad sampling from the ADC interrupt, once begin() is called.
+static DFR_Key *s_sampler = NULL;
+
+ISR(ADC_vect)
+{
+  if (s_sampler != NULL) s_sampler->sample(ADC);
+}
+
 DFR_Key::DFR_Key()
 {
   _refreshRate = 10;
@@ -46,10 +55,30 @@ DFR_Key::DFR_Key()
   _prevInput = NO_KEY;
   _prevKey = NO_KEY;
   _oldTime = 0;
+  _pressFlag = NULL;
+  _sampling = false;
+  _stableKey = NO_KEY;
+  _candidateKey = NO_KEY;
+  _candidateCount = 0;
+  _head = 0;
+  _tail = 0;
 }
 
 int DFR_Key::getKey()
 {
+ if (_sampling)
+ {
+    int key = SAMPLE_WAIT;
+
+    if (_tail != _head)
+    {
+      key = _queue[_tail];
+      _tail = (_tail + 1) % KEY_QUEUE_SIZE;
+    }
+
+    return key;
+ }
+
  if (millis() > _oldTime + _refreshRate)
  {
     _prevInput = _curInput;
@@ -65,12 +94,7 @@ int DFR_Key::getKey()
       _change = true;
       _prevKey = _curKey;
 
-      if (_curInput > UPKEY_ARV - _threshold && _curInput < UPKEY_ARV + _threshold ) _curKey = UP_KEY;
-      else if (_curInput > DOWNKEY_ARV - _threshold && _curInput < DOWNKEY_ARV + _threshold ) _curKey = DOWN_KEY;
-      else if (_curInput > RIGHTKEY_ARV - _threshold && _curInput < RIGHTKEY_ARV + _threshold ) _curKey = RIGHT_KEY;
-      else if (_curInput > LEFTKEY_ARV - _threshold && _curInput < LEFTKEY_ARV + _threshold ) _curKey = LEFT_KEY;
-      else if (_curInput > SELKEY_ARV - _threshold && _curInput < SELKEY_ARV + _threshold ) _curKey = SELECT_KEY;
-      else _curKey = NO_KEY;
+      _curKey = decode(_curInput);
    }
 
    if (_change) return _curKey; else return SAMPLE_WAIT;
@@ -81,4 +105,95 @@ int DFR_Key::getKey()
 void DFR_Key::setRate(int rate)
 {
   _refreshRate = rate;
-}
\ No newline at end of file
+}
+
+int DFR_Key::decode(int input)
+{
+  if (input > UPKEY_ARV - _threshold && input < UPKEY_ARV + _threshold ) return UP_KEY;
+  else if (input > DOWNKEY_ARV - _threshold && input < DOWNKEY_ARV + _threshold ) return DOWN_KEY;
+  else if (input > RIGHTKEY_ARV - _threshold && input < RIGHTKEY_ARV + _threshold ) return RIGHT_KEY;
+  else if (input > LEFTKEY_ARV - _threshold && input < LEFTKEY_ARV + _threshold ) return LEFT_KEY;
+  else if (input > SELKEY_ARV - _threshold && input < SELKEY_ARV + _threshold ) return SELECT_KEY;
+  else return NO_KEY;
+}
+
+void DFR_Key::begin(volatile bool *pressFlag)
+{
+  _pressFlag = pressFlag;
+  _stableKey = NO_KEY;
+  _candidateKey = NO_KEY;
+  _candidateCount = 0;
+  _head = 0;
+  _tail = 0;
+  _sampling = true;
+
+  s_sampler = this;
+  resume();
+}
+
+void DFR_Key::flush()
+{
+  _tail = _head;
+}
+
+/*
+	The ADC auto triggers on the timer 0 overflow that also drives millis()
+	so there is only one ~5us interrupt per millisecond on top of the one that
+	is already there. analogRead() can't share the ADC with the auto trigger
+	so anything else sampling has to pause() the keypad first.
+*/
+void DFR_Key::pause()
+{
+  ADCSRA &= ~(_BV(ADATE) | _BV(ADIE));
+  while (ADCSRA & _BV(ADSC));
+  ADCSRA |= _BV(ADIF);
+}
+
+void DFR_Key::resume()
+{
+  if (s_sampler == NULL) return;
+
+  int channel = s_sampler->_keyPin;
+
+  ADMUX = _BV(REFS0) | (channel & 0x07);
+  ADCSRB = (ADCSRB & ~(_BV(MUX5) | _BV(ADTS2) | _BV(ADTS1) | _BV(ADTS0))) |
+           ((channel & 0x08) ? _BV(MUX5) : 0) |
+           _BV(ADTS2);
+  ADCSRA |= _BV(ADIF);
+  ADCSRA |= _BV(ADEN) | _BV(ADATE) | _BV(ADIE);
+}
+
+/*
+	A change is only queued once the same key has been decoded for
+	KEY_DEBOUNCE_SAMPLES in a row, which also rides over the in between
+	values read as the resistor ladder switches from one key to another.
+	If the queue is full the change is dropped.
+*/
+void DFR_Key::sample(int input)
+{
+  int key = decode(input);
+
+  if (key != _candidateKey)
+  {
+    _candidateKey = key;
+    _candidateCount = 1;
+    return;
+  }
+
+  if (_candidateCount < KEY_DEBOUNCE_SAMPLES) _candidateCount++;
+
+  if ((_candidateCount == KEY_DEBOUNCE_SAMPLES) && (key != _stableKey))
+  {
+    unsigned char next = (_head + 1) % KEY_QUEUE_SIZE;
+
+    _stableKey = key;
+
+    if (next != _tail)
+    {
+      _queue[_head] = key;
+      _head = next;
+    }
+
+    if ((key != NO_KEY) && (_pressFlag != NULL)) *_pressFlag = true;
+  }
+}
@@ -11,13 +11,32 @@
 #define RIGHT_KEY 5
 #define SELECT_KEY 1
 
+#define KEY_QUEUE_SIZE 8
+#define KEY_DEBOUNCE_SAMPLES 4
+
 class DFR_Key
 {
   public:
     DFR_Key();
     int getKey();
     void setRate(int);
+
+    // Switch to sampling from the ADC interrupt, triggered by the timer 0
+    // overflow (~1KHz). Debounced key changes are queued for getKey() and
+    // pressFlag (if supplied) is set on every key press.
+    void begin(volatile bool *pressFlag = NULL);
+    void flush();
+
+    // Stop & restart the interrupt sampling around any analogRead() use.
+    static void pause();
+    static void resume();
+
+    // Called from the ADC interrupt with each sample.
+    void sample(int input);
+
   private:
+    int decode(int input);
+
     int _refreshRate;
     int _keyPin;
     int _threshold;
@@ -28,6 +47,15 @@ class DFR_Key
     int _prevKey;
     boolean _change;
     unsigned long _oldTime;
+
+    volatile bool *_pressFlag;
+    boolean _sampling;
+    int _stableKey;
+    int _candidateKey;
+    unsigned char _candidateCount;
+    volatile unsigned char _head;
+    volatile unsigned char _tail;
+    volatile unsigned char _queue[KEY_QUEUE_SIZE];
 };
 
 #endif
\ No newline at end of file
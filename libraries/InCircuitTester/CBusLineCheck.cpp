@@ -0,0 +1,696 @@
+//
+// Copyright (c) 2021, Paul R. Swan
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+// OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR
+// TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+// EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+#include "CBusLineCheck.h"
+
+//
+// The maximum number of address lines examined, this matches the
+// number of samples available in ROM_DATA2N.
+//
+static const UINT8 s_maxAddressLines = 18;
+
+//
+// Enough samples for a walking one & walking zero on a 16-bit bus.
+//
+static const UINT8 s_maxDataSamples = 32;
+
+//
+// The number of addresses sampled for a floating bus. Base plus 2n offsets.
+//
+static const UINT8 s_floatingSamples = 8;
+
+
+CBusLineCheck::CBusLineCheck(
+    ICpu *cpu,
+    void *bankSwitchContext
+) : m_cpu(cpu),
+    m_bankSwitchContext(bankSwitchContext)
+{
+};
+
+
+PERROR
+CBusLineCheck::checkRomFloating(
+    const ROM_REGION *romRegion
+)
+{
+    PERROR error = errorSuccess;
+
+    if (romRegion->bankSwitch != NO_BANK_SWITCH)
+    {
+        error = romRegion->bankSwitch( m_bankSwitchContext );
+
+        if (FAILED(error))
+        {
+            return error;
+        }
+    }
+
+    UINT8  dataBusWidth    = m_cpu->dataBusWidth(romRegion->start);
+    UINT8  dataAccessWidth = m_cpu->dataAccessWidth(romRegion->start);
+    UINT16 mask            = (dataAccessWidth == 2) ? 0xFFFF : 0x00FF;
+
+    return checkFloating(romRegion->start,
+                         romRegion->length,
+                         dataBusWidth,
+                         mask,
+                         romRegion->location);
+}
+
+
+PERROR
+CBusLineCheck::checkRamFloating(
+    const RAM_REGION *ramRegion
+)
+{
+    PERROR error = errorSuccess;
+
+    if (ramRegion->bankSwitch != NO_BANK_SWITCH)
+    {
+        error = ramRegion->bankSwitch( m_bankSwitchContext );
+
+        if (FAILED(error))
+        {
+            return error;
+        }
+    }
+
+    UINT8  dataBusWidth = m_cpu->dataBusWidth(ramRegion->start);
+    UINT32 increment    = dataBusWidth * ramRegion->step;
+    UINT32 regionLength = ((ramRegion->end - ramRegion->start) / increment) + 1;
+
+    return checkFloating(ramRegion->start,
+                         regionLength,
+                         increment,
+                         ramRegion->mask,
+                         ramRegion->location);
+}
+
+
+//
+// A bit is only reported as floating if it followed the pre-charge on every
+// sample so that a device that is present but returning 0xFF isn't flagged.
+// CPUs that can't pre-charge the data bus return success.
+//
+PERROR
+CBusLineCheck::checkFloating(
+    UINT32 start,
+    UINT32 length,
+    UINT32 increment,
+    UINT16 mask,
+    PCSTR  location
+)
+{
+    PERROR error = errorSuccess;
+    UINT16 alwaysFloating = mask;
+
+    if (length == 0)
+    {
+        return errorSuccess;
+    }
+
+    for (UINT8 sample = 0 ; sample < s_floatingSamples ; sample++)
+    {
+        UINT32 offset   = (sample == 0) ? 0 : (1UL << (sample - 1));
+        UINT16 data     = 0;
+        UINT16 floating = 0;
+
+        if (offset >= length)
+        {
+            break;
+        }
+
+        error = m_cpu->memoryReadFloating(start + (offset * increment), &data, &floating);
+
+        if (error == errorNotImplemented)
+        {
+            return errorSuccess;
+        }
+
+        if (FAILED(error))
+        {
+            return error;
+        }
+
+        alwaysFloating &= floating;
+
+        if (alwaysFloating == 0)
+        {
+            return errorSuccess;
+        }
+    }
+
+    error = errorCustom;
+    error->code = ERROR_FAILED;
+    error->description = "E:";
+    error->description += location;
+
+    if (alwaysFloating == mask)
+    {
+        error->description += " No Resp";
+    }
+    else
+    {
+        error->description += " Flt";
+
+        if (mask > 0xFF)
+        {
+            STRING_UINT16_HEX(error->description, alwaysFloating);
+        }
+        else
+        {
+            STRING_UINT8_HEX(error->description, alwaysFloating);
+        }
+    }
+
+    return error;
+}
+
+
+//
+// ROM signatures (bit k is the region relative address line):
+//
+// - Stuck low   : only sample k mismatches and it reads the same as the base address.
+// - Stuck high  : every sample except k mismatches and the base address reads sample k.
+//                 An open TTL input floats high and so looks the same.
+// - Short k,k+1 : only samples k & k+1 mismatch and they read the same value.
+//
+PERROR
+CBusLineCheck::checkRom(
+    const CRomRegionTable &romRegionTable,
+    const ROM_REGION      *romRegion
+)
+{
+    PERROR error = errorSuccess;
+
+    UINT16 expData[s_maxAddressLines] = {0};
+    UINT16 recData[s_maxAddressLines] = {0};
+    UINT16 baseData = 0;
+    UINT8  count = 0;
+
+    if (romRegion->bankSwitch != NO_BANK_SWITCH)
+    {
+        error = romRegion->bankSwitch( m_bankSwitchContext );
+
+        if (FAILED(error))
+        {
+            return error;
+        }
+    }
+
+    UINT8 dataBusWidth    = m_cpu->dataBusWidth(romRegion->start);
+    UINT8 dataAccessWidth = m_cpu->dataAccessWidth(romRegion->start);
+
+    UINT8  dataBusWidthShift = (dataBusWidth == 2) ? 1 : 0;
+    UINT8  dataBitShift      = ((dataBusWidth == 2) && (dataAccessWidth == 1) && (romRegion->start & 1)) ? 8 : 0;
+    UINT16 mask              = (dataAccessWidth == 2) ? 0xFFFF : 0x00FF;
+
+    error = m_cpu->memoryRead(romRegion->start, &baseData);
+
+    if (FAILED(error))
+    {
+        return error;
+    }
+
+    baseData &= mask;
+
+    for ( ; ((1UL << count) < romRegion->length) && (count < s_maxAddressLines) ; count++)
+    {
+        UINT32 address = romRegion->start + (1UL << (count + dataBusWidthShift));
+
+        error = m_cpu->memoryRead(address, &recData[count]);
+
+        if (FAILED(error))
+        {
+            return error;
+        }
+
+        expData[count] = romRegionTable.data2n(romRegion, count) & mask;
+        recData[count] &= mask;
+    }
+
+    error = checkData(expData, recData, count, mask, dataBitShift);
+
+    if ((error != errorSuccess) || (count == 0))
+    {
+        return error;
+    }
+
+    {
+        UINT32 mismatch = 0;
+        UINT32 all = (1UL << count) - 1;
+
+        for (UINT8 k = 0 ; k < count ; k++)
+        {
+            if (expData[k] != recData[k])
+            {
+                mismatch |= (1UL << k);
+            }
+        }
+
+        for (UINT8 k = 0 ; k < count ; k++)
+        {
+            UINT32 bit = (1UL << k);
+
+            if ((mismatch == bit) &&
+                (recData[k] == baseData))
+            {
+                return reportLine(ICpu::ADDRESS, k + dataBusWidthShift, "St Lo");
+            }
+
+            if ((count >= 3) &&
+                (mismatch == (all & ~bit)) &&
+                (baseData == expData[k]))
+            {
+                return reportLine(ICpu::ADDRESS, k + dataBusWidthShift, "St Hi");
+            }
+
+            if (((k + 1) < count) &&
+                (mismatch == (bit | (bit << 1))) &&
+                (recData[k] == recData[k + 1]))
+            {
+                return reportShort(ICpu::ADDRESS, k + dataBusWidthShift, k + 1 + dataBusWidthShift);
+            }
+        }
+    }
+
+    return errorSuccess;
+}
+
+
+//
+// RAM signatures (bit k is the region relative address line):
+//
+// - Stuck/open  : a write to offset 2^k overwrites the base address.
+//                 Stuck high & low can't be told apart as both just alias.
+// - Short k,k+1 : a write to offset 2^(k+1) overwrites offset 2^k.
+//
+PERROR
+CBusLineCheck::checkRam(
+    const RAM_REGION *ramRegion
+)
+{
+    PERROR error = errorSuccess;
+
+    UINT16 expData[s_maxDataSamples] = {0};
+    UINT16 recData[s_maxDataSamples] = {0};
+    UINT8  count = 0;
+
+    if (ramRegion->bankSwitch != NO_BANK_SWITCH)
+    {
+        error = ramRegion->bankSwitch( m_bankSwitchContext );
+
+        if (FAILED(error))
+        {
+            return error;
+        }
+    }
+
+    UINT8 dataBusWidth    = m_cpu->dataBusWidth(ramRegion->start);
+    UINT8 dataAccessWidth = m_cpu->dataAccessWidth(ramRegion->start);
+
+    UINT8  dataBusWidthShift = (dataBusWidth == 2) ? 1 : 0;
+    UINT8  dataBitShift      = ((dataBusWidth == 2) && (dataAccessWidth == 1) && (ramRegion->start & 1)) ? 8 : 0;
+    UINT8  stepShift         = 0;
+    UINT16 mask              = ramRegion->mask;
+
+    UINT32 increment    = dataBusWidth * ramRegion->step;
+    UINT32 regionLength = ((ramRegion->end - ramRegion->start) / increment) + 1;
+
+    for ( ; (1 << stepShift) < ramRegion->step ; stepShift++) {}
+
+    //
+    // Data lines - walking one & walking zero on the base address.
+    //
+    for (UINT8 bit = 0 ; bit < 16 ; bit++)
+    {
+        UINT16 bitMask = (1 << bit);
+
+        if (!(mask & bitMask))
+        {
+            continue;
+        }
+
+        expData[count + 0] = bitMask;
+        expData[count + 1] = mask & ~bitMask;
+
+        for (UINT8 i = count ; i < (count + 2) ; i++)
+        {
+            error = m_cpu->memoryWrite(ramRegion->start, expData[i]);
+
+            if (SUCCESS(error))
+            {
+                error = m_cpu->memoryRead(ramRegion->start, &recData[i]);
+            }
+
+            if (FAILED(error))
+            {
+                return error;
+            }
+
+            recData[i] &= mask;
+        }
+
+        count += 2;
+    }
+
+    error = checkData(expData, recData, count, mask, dataBitShift);
+
+    if (error != errorSuccess)
+    {
+        return error;
+    }
+
+    //
+    // The address lines can only be judged with working data lines, e.g. a
+    // dead chip reads the same everywhere and so would alias on every line.
+    //
+    for (UINT8 i = 0 ; i < count ; i++)
+    {
+        if (recData[i] != expData[i])
+        {
+            return errorSuccess;
+        }
+    }
+
+    //
+    // Address lines - aliasing on the base and on the neighbour.
+    //
+    {
+        UINT32 aliasBase = 0;
+        UINT32 aliasNext = 0;
+        UINT8  lines = 0;
+
+        for ( ; ((1UL << lines) < regionLength) && (lines < s_maxAddressLines) ; lines++) {}
+
+        for (UINT8 k = 0 ; k < lines ; k++)
+        {
+            UINT32 address     = ramRegion->start + ((1UL << k) * increment);
+            UINT32 nextAddress = ramRegion->start + ((1UL << (k + 1)) * increment);
+            UINT16 data = 0;
+
+            // Base
+            {
+                error = m_cpu->memoryWrite(ramRegion->start, 0);
+
+                if (SUCCESS(error))
+                {
+                    error = m_cpu->memoryWrite(address, mask);
+                }
+
+                if (SUCCESS(error))
+                {
+                    error = m_cpu->memoryRead(ramRegion->start, &data);
+                }
+
+                if (FAILED(error))
+                {
+                    return error;
+                }
+
+                if ((data & mask) == mask)
+                {
+                    aliasBase |= (1UL << k);
+                }
+            }
+
+            // Neighbour
+            if ((k + 1) < lines)
+            {
+                error = m_cpu->memoryWrite(address, 0);
+
+                if (SUCCESS(error))
+                {
+                    error = m_cpu->memoryWrite(nextAddress, mask);
+                }
+
+                if (SUCCESS(error))
+                {
+                    error = m_cpu->memoryRead(address, &data);
+                }
+
+                if (FAILED(error))
+                {
+                    return error;
+                }
+
+                if ((data & mask) == mask)
+                {
+                    aliasNext |= (1UL << k);
+                }
+            }
+        }
+
+        UINT8 addressShift = dataBusWidthShift + stepShift;
+
+        //
+        // A single line fault aliases on one line, or on two neighbours for
+        // a short. Anything more isn't a bus line fault.
+        //
+        {
+            UINT8 baseLines = 0;
+            UINT8 nextLines = 0;
+            UINT8 lowest = 0;
+
+            for (UINT8 k = 0 ; k < lines ; k++)
+            {
+                if (aliasBase & (1UL << k))
+                {
+                    lowest = (baseLines == 0) ? k : lowest;
+                    baseLines++;
+                }
+
+                if (aliasNext & (1UL << k))
+                {
+                    nextLines++;
+                }
+            }
+
+            if ((baseLines > 2) ||
+                ((baseLines == 2) && (aliasBase != (3UL << lowest))) ||
+                (nextLines > 1))
+            {
+                return errorSuccess;
+            }
+        }
+
+        for (UINT8 k = 0 ; (k + 1) < lines ; k++)
+        {
+            UINT32 bits = (3UL << k);
+
+            if (((aliasBase & bits) == bits) &&
+                 (aliasNext & (1UL << k)))
+            {
+                return reportShort(ICpu::ADDRESS, k + addressShift, k + 1 + addressShift);
+            }
+        }
+
+        for (UINT8 k = 0 ; k < lines ; k++)
+        {
+            if (aliasBase & (1UL << k))
+            {
+                return reportLine(ICpu::ADDRESS, k + addressShift, "Stuck");
+            }
+        }
+
+        for (UINT8 k = 0 ; k < lines ; k++)
+        {
+            if (aliasNext & (1UL << k))
+            {
+                return reportShort(ICpu::ADDRESS, k + addressShift, k + 1 + addressShift);
+            }
+        }
+    }
+
+    return errorSuccess;
+}
+
+
+//
+// Data signatures across all the samples:
+//
+// - Stuck       : every mismatch is on one bit and that bit always reads the same.
+// - Short       : every mismatch is on two bits and those bits always read the same.
+//
+// At least two mismatched samples are needed so that a single corrupt
+// location isn't reported as a line fault.
+//
+PERROR
+CBusLineCheck::checkData(
+    const UINT16 expData[],
+    const UINT16 recData[],
+    UINT8        count,
+    UINT16       mask,
+    UINT8        dataBitShift
+)
+{
+    UINT16 diff = 0;
+    UINT8  mismatches = 0;
+    UINT8  bits[2] = {0};
+    UINT8  numBits = 0;
+
+    for (UINT8 i = 0 ; i < count ; i++)
+    {
+        UINT16 sampleDiff = (expData[i] ^ recData[i]) & mask;
+
+        if (sampleDiff != 0)
+        {
+            diff |= sampleDiff;
+            mismatches++;
+        }
+    }
+
+    if (mismatches < 2)
+    {
+        return errorSuccess;
+    }
+
+    for (UINT8 bit = 0 ; bit < 16 ; bit++)
+    {
+        if (diff & (1 << bit))
+        {
+            if (numBits == ARRAYSIZE(bits))
+            {
+                return errorSuccess;
+            }
+
+            bits[numBits++] = bit;
+        }
+    }
+
+    if (numBits == 1)
+    {
+        UINT16 bitMask = (1 << bits[0]);
+        UINT8  hiCount = 0;
+
+        for (UINT8 i = 0 ; i < count ; i++)
+        {
+            if (recData[i] & bitMask)
+            {
+                hiCount++;
+            }
+        }
+
+        if (hiCount == 0)
+        {
+            return reportLine(ICpu::DATA, bits[0] + dataBitShift, "St Lo");
+        }
+
+        if (hiCount == count)
+        {
+            return reportLine(ICpu::DATA, bits[0] + dataBitShift, "St Hi");
+        }
+    }
+    else if (numBits == 2)
+    {
+        bool same = true;
+
+        for (UINT8 i = 0 ; i < count ; i++)
+        {
+            if (((recData[i] >> bits[0]) ^ (recData[i] >> bits[1])) & 1)
+            {
+                same = false;
+                break;
+            }
+        }
+
+        if (same)
+        {
+            return reportShort(ICpu::DATA, bits[0] + dataBitShift, bits[1] + dataBitShift);
+        }
+    }
+
+    return errorSuccess;
+}
+
+
+PERROR
+CBusLineCheck::reportLine(
+    ICpu::Bus bus,
+    UINT8     bit,
+    PCSTR     verdict
+)
+{
+    PERROR error = errorCustom;
+
+    error->code = ERROR_FAILED;
+    error->description = "E:";
+    appendLineName(error->description, bus, bit, true);
+    error->description += " ";
+    error->description += verdict;
+
+    return error;
+}
+
+
+PERROR
+CBusLineCheck::reportShort(
+    ICpu::Bus bus,
+    UINT8     bitA,
+    UINT8     bitB
+)
+{
+    PERROR error = errorCustom;
+
+    error->code = ERROR_FAILED;
+    error->description = "E:";
+    appendLineName(error->description, bus, bitA, false);
+    error->description += "=";
+    appendLineName(error->description, bus, bitB, false);
+    error->description += " Sh";
+
+    return error;
+}
+
+
+//
+// Append the connection name & pin or, if the CPU doesn't connect
+// the line to the probe, the logical name.
+//
+void
+CBusLineCheck::appendLineName(
+    CDescription &string,
+    ICpu::Bus    bus,
+    UINT8        bit,
+    bool         withPin
+)
+{
+    const CONNECTION *connection = m_cpu->busConnection(bus, bit);
+
+    if (connection != NULL)
+    {
+        string += connection->name;
+
+        if (withPin)
+        {
+            string += " p";
+            string += connection->pin;
+        }
+    }
+    else
+    {
+        string += (bus == ICpu::ADDRESS) ? "A" : "D";
+        string += bit;
+    }
+}
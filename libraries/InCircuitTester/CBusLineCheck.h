@@ -0,0 +1,146 @@
+//
+// Copyright (c) 2021, Paul R. Swan
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+// OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR
+// TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+// EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+#ifndef CBusLineCheck_h
+#define CBusLineCheck_h
+
+#include "Arduino.h"
+#include "Types.h"
+#include "ICpu.h"
+#include "CRegionTable.h"
+
+//
+// Localises a ROM or RAM failure to a single stuck or shorted address or data line
+// by looking at the pattern of mismatches rather than the first failing address.
+//
+// A located fault is returned as a failure with the line(s) named from the CPU
+// probe connection, for example:
+//
+// 0123456789abcdef
+// E:A5 p35 St Lo     - A5 (probe pin 35) is stuck low.
+// E:D3 p8 St Hi      - D3 (probe pin 8) is stuck high or open.
+// E:A10 p40 Stuck    - A10 aliases the RAM, either stuck or open.
+// E:A6=A7 Sh         - A6 & A7 are shorted together.
+//
+// If no single line explains the mismatches then success is returned so the
+// caller can report the original error.
+//
+class CBusLineCheck
+{
+    public:
+
+        CBusLineCheck(
+            ICpu *cpu,
+            void *bankSwitchContext
+        );
+
+        //
+        // Uses the data2n samples of the ROM region plus a read of the
+        // base address to localise the fault. The samples are read through
+        // the region table as they may be in PROGMEM.
+        //
+        PERROR
+        checkRom(
+            const CRomRegionTable &romRegionTable,
+            const ROM_REGION      *romRegion
+        );
+
+        //
+        // Uses walking data patterns on the base address and a small set of
+        // targeted writes at 2n offsets to detect address aliasing.
+        //
+        PERROR
+        checkRam(
+            const RAM_REGION *ramRegion
+        );
+
+        //
+        // Sample a handful of addresses in the region with the data bus
+        // pre-charged high and low to detect a region with no device
+        // responding (e.g. an empty socket) before a full pass is run.
+        //
+        // 0123456789abcdef
+        // E:11D No Resp      - no data bits are driven.
+        // E:11D Flt 0F       - the given data bits are never driven.
+        //
+        PERROR
+        checkRomFloating(
+            const ROM_REGION *romRegion
+        );
+
+        PERROR
+        checkRamFloating(
+            const RAM_REGION *ramRegion
+        );
+
+    private:
+
+        PERROR
+        checkFloating(
+            UINT32 start,
+            UINT32 length,
+            UINT32 increment,
+            UINT16 mask,
+            PCSTR  location
+        );
+
+        PERROR
+        checkData(
+            const UINT16 expData[],
+            const UINT16 recData[],
+            UINT8        count,
+            UINT16       mask,
+            UINT8        dataBitShift
+        );
+
+        PERROR
+        reportLine(
+            ICpu::Bus bus,
+            UINT8     bit,
+            PCSTR     verdict
+        );
+
+        PERROR
+        reportShort(
+            ICpu::Bus bus,
+            UINT8     bitA,
+            UINT8     bitB
+        );
+
+        void
+        appendLineName(
+            CDescription &string,
+            ICpu::Bus    bus,
+            UINT8        bit,
+            bool         withPin
+        );
+
+    private:
+
+        ICpu *m_cpu;
+        void *m_bankSwitchContext;
+
+};
+
+#endif
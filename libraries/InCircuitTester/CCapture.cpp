@@ -0,0 +1,299 @@
+//
+// Copyright (c) 2021, Paul R. Swan
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+// OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR
+// TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+// EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+#include "CCapture.h"
+#include "PinMap.h"
+#include "SerialPort.h"
+
+//
+// Longest sample period supported so the VCD time stamps of a full buffer
+// (768 runs of 255 samples) still fit in 32 bits of microseconds.
+//
+static const UINT16 s_maxPeriodUs = 10000;
+
+//
+// Longest sample period exported with a 1ns timescale, above this a full
+// buffer would overflow 32 bits of nanoseconds so 1us is used instead.
+//
+static const UINT32 s_maxNsTick = 20000;
+
+//
+// The default aux capture used by the generic custom function.
+//
+static const UINT32 s_auxSamples  = 50000;
+static const UINT16 s_auxPeriodUs = 10;
+
+
+CCapture::CCapture(
+    UINT8 inputMask
+) : m_run(NULL),
+    m_maxRuns(0),
+    m_runCount(0),
+    m_sampleCount(0),
+    m_droppedCount(0),
+    m_nsPerSample(0)
+{
+    for (UINT8 channel = 0 ; channel < 8 ; channel++)
+    {
+        if (inputMask & (1 << channel))
+        {
+            ::pinMode(g_pinMap8Aux[channel + 1], INPUT);
+        }
+    }
+
+    m_run = (PCAPTURE_RUN) malloc(s_maxRuns * sizeof(CAPTURE_RUN));
+
+    if (m_run != NULL)
+    {
+        m_maxRuns = s_maxRuns;
+    }
+}
+
+
+CCapture::~CCapture(
+)
+{
+    if (m_run != NULL)
+    {
+        free(m_run);
+    }
+}
+
+
+void
+CCapture::reset(
+    UINT32 nsPerSample
+)
+{
+    m_runCount     = 0;
+    m_sampleCount  = 0;
+    m_droppedCount = 0;
+    m_nsPerSample  = nsPerSample;
+}
+
+
+PERROR
+CCapture::captureTimed(
+    UINT32 samples,
+    UINT16 periodUs
+)
+{
+    PERROR error = errorSuccess;
+
+    if (periodUs > s_maxPeriodUs)
+    {
+        periodUs = s_maxPeriodUs;
+    }
+
+    reset((UINT32) periodUs * 1000);
+
+    if (periodUs == 0)
+    {
+        unsigned long startUs = micros();
+
+        for (UINT32 count = 0 ; count < samples ; count++)
+        {
+            sample();
+        }
+
+        //
+        // Free running so the sample period is the average over the capture.
+        //
+        if (samples != 0)
+        {
+            m_nsPerSample = ((micros() - startUs) * 1000) / samples;
+        }
+    }
+    else
+    {
+        unsigned long nextUs = micros();
+
+        for (UINT32 count = 0 ; count < samples ; count++)
+        {
+            while ((long) (micros() - nextUs) < 0);
+
+            sample();
+            nextUs += periodUs;
+        }
+    }
+
+    return error;
+}
+
+
+//
+// 0123456789abcdef
+// OK:50000 R123      - 50000 samples compressed into 123 runs.
+// E:No Memory        - The run buffer could not be allocated.
+// E:Ovf 1234         - The run buffer filled and 1234 samples were dropped.
+//
+PERROR
+CCapture::result(
+)
+{
+    PERROR error = errorCustom;
+
+    if (m_run == NULL)
+    {
+        error->code = ERROR_FAILED;
+        error->description = "E:No Memory";
+    }
+    else if (m_droppedCount != 0)
+    {
+        error->code = ERROR_FAILED;
+        error->description = "E:Ovf ";
+        error->description += m_droppedCount;
+    }
+    else
+    {
+        error->code = ERROR_SUCCESS;
+        error->description = "OK:";
+        error->description += m_sampleCount;
+        error->description += " R";
+        error->description += m_runCount;
+    }
+
+    return error;
+}
+
+
+//
+// Channels are named AUX1 -> AUX8 with single character VCD identifiers '!' -> '('.
+// Clocked captures use 1 tick per clock since the clock rate is set by the
+// caller's pulse loop rather than any fixed time base. Timed captures with
+// long periods use a 1us timescale so the time stamps don't wrap.
+//
+void
+CCapture::exportVcd(
+    Print &out
+)
+{
+    UINT32 tick = (m_nsPerSample != 0) ? m_nsPerSample : 1;
+    UINT32 time = 0;
+    UINT8  last = 0;
+    bool   us   = (m_nsPerSample > s_maxNsTick);
+
+    if (us)
+    {
+        tick = m_nsPerSample / 1000;
+    }
+
+    if (m_nsPerSample == 0)
+    {
+        out.println("$comment 1 tick per CPU clock $end");
+    }
+
+    if (m_droppedCount != 0)
+    {
+        out.print("$comment buffer full, ");
+        out.print(m_droppedCount);
+        out.println(" samples dropped at the end $end");
+    }
+
+    out.println(us ? "$timescale 1 us $end" : "$timescale 1 ns $end");
+    out.println("$scope module aux $end");
+
+    for (UINT8 channel = 0 ; channel < 8 ; channel++)
+    {
+        out.print("$var wire 1 ");
+        out.print((char) ('!' + channel));
+        out.print(" AUX");
+        out.print(channel + 1);
+        out.println(" $end");
+    }
+
+    out.println("$upscope $end");
+    out.println("$enddefinitions $end");
+
+    for (UINT16 run = 0 ; run < m_runCount ; run++)
+    {
+        UINT8 value   = m_run[run].value;
+        UINT8 changed = (run == 0) ? 0xFF : (value ^ last);
+
+        out.print('#');
+        out.println(time);
+
+        if (run == 0)
+        {
+            out.println("$dumpvars");
+        }
+
+        for (UINT8 channel = 0 ; channel < 8 ; channel++)
+        {
+            if (changed & (1 << channel))
+            {
+                out.print((value & (1 << channel)) ? '1' : '0');
+                out.println((char) ('!' + channel));
+            }
+        }
+
+        if (run == 0)
+        {
+            out.println("$end");
+        }
+
+        last  = value;
+        time += m_run[run].count * tick;
+    }
+
+    out.print('#');
+    out.println(time);
+}
+
+
+//
+// What was captured before any overflow is still exported.
+//
+PERROR
+CCapture::exportSerial(
+)
+{
+    if (m_run != NULL)
+    {
+        ensureSerial();
+        exportVcd(Serial);
+        Serial.flush();
+    }
+
+    return result();
+}
+
+
+PERROR
+CCapture::captureAux(
+    void *context
+)
+{
+    PERROR error = errorSuccess;
+    CCapture capture;
+
+    error = capture.captureTimed(s_auxSamples, s_auxPeriodUs);
+
+    if (SUCCESS(error))
+    {
+        error = capture.exportSerial();
+    }
+
+    return error;
+}
@@ -0,0 +1,173 @@
+//
+// Copyright (c) 2021, Paul R. Swan
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+// OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR
+// TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+// EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+#ifndef CCapture_h
+#define CCapture_h
+
+#include "Arduino.h"
+#include "Types.h"
+#include "Error.h"
+#include "ISampler.h"
+
+//
+// A run of identical consecutive samples.
+//
+typedef struct _CAPTURE_RUN {
+
+    UINT8 value;  // PINK, bit 0 is AUX1
+    UINT8 count;  // 1 -> 255 samples
+
+} CAPTURE_RUN, *PCAPTURE_RUN;
+
+//
+// 8 channel logic capture of the J14 aux connector.
+//
+// All 8 aux pins are on PORTK so a single PINK read samples every channel at
+// once. Samples are run length compressed into an SRAM buffer that's allocated
+// for the lifetime of the capture object so slowly changing signals can cover
+// many thousands of samples.
+//
+// The clock master CPUs call sample() on every clockPulse() when a capture is
+// attached as the sampler. For all other CPUs captureTimed() samples at a
+// fixed rate.
+//
+// The result is exported as a VCD file (e.g. for GTKWave or PulseView) on the
+// serial port.
+//
+class CCapture : public ISampler
+{
+    public:
+
+        //
+        // Channels in inputMask (bit 0 is AUX1) are set to INPUT. Other aux
+        // pins are left as they are but are still sampled, e.g. the clock
+        // master output on AUX8.
+        //
+        CCapture(
+            UINT8 inputMask = 0xFF
+        );
+
+        ~CCapture(
+        );
+
+        //
+        // ISampler Interface
+        //
+        // Record a single sample of all 8 channels.
+        //
+        virtual
+        void
+        sample(
+        )
+        {
+            UINT8 value = PINK;
+
+            if ((m_runCount != 0)                          &&
+                (m_run[m_runCount - 1].value == value)     &&
+                (m_run[m_runCount - 1].count != 0xFF))
+            {
+                m_run[m_runCount - 1].count++;
+                m_sampleCount++;
+            }
+            else if (m_runCount < m_maxRuns)
+            {
+                m_run[m_runCount].value = value;
+                m_run[m_runCount].count = 1;
+                m_runCount++;
+                m_sampleCount++;
+            }
+            else
+            {
+                m_droppedCount++;
+            }
+        };
+
+        //
+        // Discard any captured samples and set the time of a single sample
+        // used in the VCD export. 0 means each sample is one CPU clock.
+        //
+        void
+        reset(
+            UINT32 nsPerSample
+        );
+
+        //
+        // Sample at a fixed rate, with no clock synchronization.
+        // A periodUs of 0 samples as fast as possible.
+        //
+        PERROR
+        captureTimed(
+            UINT32 samples,
+            UINT16 periodUs
+        );
+
+        //
+        // The capture result summary for the LCD. A capture that filled the
+        // buffer fails with the number of samples dropped.
+        //
+        PERROR
+        result(
+        );
+
+        //
+        // Export the capture to the supplied stream in VCD format.
+        //
+        void
+        exportVcd(
+            Print &out
+        );
+
+        //
+        // Export the capture in VCD format on the serial port, including a
+        // capture that filled the buffer. Returns the result() summary for
+        // the LCD.
+        //
+        PERROR
+        exportSerial(
+        );
+
+        //
+        // Custom function to capture the aux pins at a fixed rate and export
+        // the result on the serial port. Suitable for any game.
+        //
+        static
+        PERROR
+        captureAux(
+            void *context
+        );
+
+    private:
+
+        static const UINT16 s_maxRuns = 768;
+
+        PCAPTURE_RUN m_run;
+        UINT16       m_maxRuns;
+        UINT16       m_runCount;
+        UINT32       m_sampleCount;
+        UINT32       m_droppedCount;
+        UINT32       m_nsPerSample;
+
+};
+
+#endif
@@ -0,0 +1,356 @@
+//
+// Copyright (c) 2021, Paul R. Swan
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+// OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR
+// TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+// EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+#include "CEventStream.h"
+#include "SerialPort.h"
+
+//
+// The longest event line.
+//
+static const UINT8 s_maxLine = 160;
+
+bool   CEventStream::s_enabled;
+UINT32 CEventStream::s_sequence;
+UINT32 CEventStream::s_cycles;
+UINT16 CEventStream::s_dropped;
+
+CHAR   CEventStream::s_ring[256];
+UINT8  CEventStream::s_head;
+UINT8  CEventStream::s_tail;
+
+//
+// An event line being built.
+//
+typedef struct _LINE {
+
+    CHAR  text[s_maxLine];
+    UINT8 length;
+
+} LINE, *PLINE;
+
+
+//
+// Append a field, commas are swapped for ';' to keep the columns and the
+// space padding of the fixed error descriptions is dropped.
+//
+static void
+appendField(
+    PLINE line,
+    PCSTR text,
+    UINT8 maxLength
+)
+{
+    UINT8 end = line->length;
+
+    for (UINT8 i = 0 ; (i < maxLength) && (text[i] != '\0') && (line->length < (s_maxLine - 3)) ; i++)
+    {
+        line->text[line->length++] = (text[i] == ',') ? ';' : text[i];
+
+        if (text[i] != ' ')
+        {
+            end = line->length;
+        }
+    }
+
+    line->length = end;
+}
+
+
+static void
+appendText(
+    PLINE line,
+    PCSTR text
+)
+{
+    for (UINT8 i = 0 ; (text[i] != '\0') && (line->length < (s_maxLine - 3)) ; i++)
+    {
+        line->text[line->length++] = text[i];
+    }
+}
+
+
+static void
+appendNumber(
+    PLINE  line,
+    UINT32 value,
+    UINT8  base
+)
+{
+    CHAR digits[11];
+    UINT8 count = 0;
+
+    do
+    {
+        UINT8 digit = value % base;
+
+        digits[count++] = (digit < 10) ? ('0' + digit) : ('A' + digit - 10);
+        value /= base;
+    }
+    while (value != 0);
+
+    while ((count > 0) && (line->length < (s_maxLine - 3)))
+    {
+        line->text[line->length++] = digits[--count];
+    }
+}
+
+
+static bool
+isHex(
+    PCSTR text,
+    UINT8 length
+)
+{
+    for (UINT8 i = 0 ; i < length ; i++)
+    {
+        if (!isxdigit(text[i]))
+        {
+            return false;
+        }
+    }
+
+    return (length > 0);
+}
+
+
+void
+CEventStream::enable(
+    bool enable
+)
+{
+    s_enabled = enable;
+
+    if (s_enabled)
+    {
+        ensureSerial();
+        Serial.println("event,seq,ms,test,durationMs,cycles,code,location,address,expected,received,description");
+    }
+}
+
+
+bool
+CEventStream::enabled(
+)
+{
+    return s_enabled;
+}
+
+
+void
+CEventStream::testStart(
+    PCSTR test
+)
+{
+    s_cycles = 0;
+
+    send('S', test, ",,,,,,,");
+}
+
+
+//
+// The value checks describe a failure as e.g. "E:6C 1234 55 AA", which is
+// split into the location, address, expected & received columns. The 16-bit
+// checks have no room for the address, e.g. "E:r22 5555 AAAA", so their
+// address column is left empty.
+//
+void
+CEventStream::testEnd(
+    PCSTR  test,
+    PERROR error,
+    UINT32 durationInMs
+)
+{
+    PCSTR description = error->description;
+    LINE columns = {{0}, 0};
+    UINT8 start[4] = {0};
+    UINT8 length[4] = {0};
+    UINT8 tokens = 0;
+
+    if (FAILED(error) && (description[0] == 'E') && (description[1] == ':'))
+    {
+        for (UINT8 i = 2 ; description[i] != '\0' ; i++)
+        {
+            if (description[i] == ' ')
+            {
+                continue;
+            }
+
+            if ((i == 2) || (description[i-1] == ' '))
+            {
+                if (tokens == 4)
+                {
+                    tokens++;
+                    break;
+                }
+
+                start[tokens++] = i;
+            }
+
+            length[tokens-1]++;
+        }
+    }
+
+    //
+    // Without an address the values move up a token.
+    //
+    if (tokens == 3)
+    {
+        start[3]  = start[2];
+        length[3] = length[2];
+        start[2]  = start[1];
+        length[2] = length[1];
+        length[1] = 0;
+    }
+
+    if (((tokens != 3) && (tokens != 4)) ||
+        ((length[1] != 0) && !isHex(&description[start[1]], length[1])) ||
+        !isHex(&description[start[2]], length[2]) ||
+        !isHex(&description[start[3]], length[3]))
+    {
+        tokens = 0;
+    }
+
+    appendNumber(&columns, durationInMs, 10);
+    appendText(&columns, ",");
+
+    if (s_cycles != 0)
+    {
+        appendNumber(&columns, s_cycles, 10);
+    }
+
+    appendText(&columns, ",");
+    appendNumber(&columns, error->code, 16);
+
+    for (UINT8 i = 0 ; i < 4 ; i++)
+    {
+        appendText(&columns, ",");
+
+        if (tokens != 0)
+        {
+            appendField(&columns, &description[start[i]], length[i]);
+        }
+    }
+
+    appendText(&columns, ",");
+    appendField(&columns, description, 16);
+    columns.text[columns.length] = '\0';
+
+    send('E', test, columns.text);
+
+    s_cycles = 0;
+}
+
+
+void
+CEventStream::cycles(
+    UINT32 count
+)
+{
+    s_cycles = count;
+}
+
+
+void
+CEventStream::pump(
+)
+{
+    while ((s_tail != s_head) && (Serial.availableForWrite() > 0))
+    {
+        Serial.write(s_ring[s_tail++]);
+    }
+}
+
+
+void
+CEventStream::send(
+    CHAR   event,
+    PCSTR  test,
+    PCSTR  columns
+)
+{
+    LINE line = {{0}, 0};
+
+    if (!s_enabled)
+    {
+        return;
+    }
+
+    pump();
+
+    //
+    // Report any dropped events ahead of this one.
+    //
+    if (s_dropped != 0)
+    {
+        line.text[line.length++] = 'D';
+        appendText(&line, ",");
+        appendNumber(&line, s_sequence, 10);
+        appendText(&line, ",");
+        appendNumber(&line, millis(), 10);
+        appendText(&line, ",,,,,,,,,");
+        appendNumber(&line, s_dropped, 10);
+        appendText(&line, " dropped");
+        line.text[line.length++] = '\r';
+        line.text[line.length++] = '\n';
+
+        if (line.length <= (UINT8) (sizeof(s_ring) - 1 - (UINT8) (s_head - s_tail)))
+        {
+            for (UINT8 i = 0 ; i < line.length ; i++)
+            {
+                s_ring[s_head++] = line.text[i];
+            }
+
+            s_dropped = 0;
+        }
+
+        line.length = 0;
+    }
+
+    line.text[line.length++] = event;
+    appendText(&line, ",");
+    appendNumber(&line, s_sequence++, 10);
+    appendText(&line, ",");
+    appendNumber(&line, millis(), 10);
+    appendText(&line, ",");
+    appendField(&line, test, 16);
+    appendText(&line, ",");
+    appendText(&line, columns);
+    line.text[line.length++] = '\r';
+    line.text[line.length++] = '\n';
+
+    if ((s_dropped == 0) &&
+        (line.length <= (UINT8) (sizeof(s_ring) - 1 - (UINT8) (s_head - s_tail))))
+    {
+        for (UINT8 i = 0 ; i < line.length ; i++)
+        {
+            s_ring[s_head++] = line.text[i];
+        }
+    }
+    else
+    {
+        s_dropped++;
+    }
+
+    pump();
+}
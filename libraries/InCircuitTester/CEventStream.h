@@ -0,0 +1,129 @@
+//
+// Copyright (c) 2021, Paul R. Swan
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+// OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR
+// TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+// EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+#ifndef CEventStream_h
+#define CEventStream_h
+
+#include "Arduino.h"
+#include "Types.h"
+#include "Error.h"
+
+//
+// An optional stream of test events over serial for collecting the results
+// of many benches. The CSV lines are the final format, there is no binary
+// form. Every event has the same columns so a capture of the serial port can
+// be loaded as is, tools/ictevents.py pulls them out of a capture that also
+// has other output (e.g. remote control replies) in it:
+//
+//   event,seq,ms,test,durationMs,cycles,code,location,address,expected,received,description
+//
+//   event       - S a test started, E a test ended or D events were dropped
+//                 because the serial port couldn't keep up.
+//   seq         - decimal event number. Dropped events use up a number and
+//                 a D event has the number of the event that follows it.
+//   ms          - decimal millis() when the event was sent.
+//   test        - the menu text of the test, empty for D.
+//   durationMs  - E only, decimal run time of the test.
+//   cycles      - E only, decimal bus cycles if the test reported them.
+//   code        - E only, hex error code, 0 is a pass.
+//   location    - E only, the failing chip location, for example 6C.
+//   address     - E only, hex failing address if the description has one.
+//   expected    - E only, hex expected value.
+//   received    - E only, hex received value.
+//   description - the LCD text of the result for E, "<n> dropped" for D.
+//
+// The location & values are decoded from failures with the forms of the
+// value checks, "E:<location> <address> <exp> <rec>" and "E:<location> <exp>
+// <rec>", and are empty otherwise. Commas in the text fields are sent as ';'.
+//
+// Events are queued in a ring and only handed to the interrupt driven serial
+// driver while it has room, so a test is never held up by the serial port.
+// An event that doesn't fit in the ring is dropped & counted instead.
+// This is a static class.
+//
+class CEventStream
+{
+    public:
+
+        //
+        // Turn the stream on or off, the column names are sent when on.
+        //
+        static void
+        enable(
+            bool enable
+        );
+
+        static bool
+        enabled(
+        );
+
+        static void
+        testStart(
+            PCSTR test
+        );
+
+        static void
+        testEnd(
+            PCSTR  test,
+            PERROR error,
+            UINT32 durationInMs
+        );
+
+        //
+        // Report the bus cycles used by the running test.
+        //
+        static void
+        cycles(
+            UINT32 count
+        );
+
+        //
+        // Hand as much of the ring to the serial driver as it has room for.
+        //
+        static void
+        pump(
+        );
+
+    private:
+
+        static void
+        send(
+            CHAR   event,
+            PCSTR  test,
+            PCSTR  columns
+        );
+
+    private:
+
+        static bool   s_enabled;
+        static UINT32 s_sequence;
+        static UINT32 s_cycles;
+        static UINT16 s_dropped;
+
+        static CHAR   s_ring[256];
+        static UINT8  s_head;
+        static UINT8  s_tail;
+};
+
+#endif
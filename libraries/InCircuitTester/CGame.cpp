@@ -26,6 +26,8 @@
 #include "CRomCheck.h"
 #include "CRamCheck.h"
 #include "CIoCheck.h"
+#include "Depth.h"
+#include "CEventStream.h"
 #include <DFR_Key.h>
 
 #include <avr/pgmspace.h>
@@ -80,24 +82,6 @@ CGame::CGame(
 CGame::~CGame(
 )
 {
-    free( m_romRegion );
-
-    if (m_romData2n != 0)
-    {
-        free( m_romData2n );
-    }
-
-    free( m_ramRegion );
-
-    if (m_ramRegionByteOnly != m_ramRegion)
-    {
-        free( m_ramRegionByteOnly );
-    }
-
-    free( m_ramRegionWriteOnly );
-    free( m_inputRegion );
-    free( m_outputRegion );
-    free( m_customFunction );
 }
 
 
@@ -124,6 +108,248 @@ CGame::busCheck(
 }
 
 
+//
+// The checks run in order of bus cycles used, all of the bus lines first,
+// a single read of each input, the 2^n samples of each ROM, a walking bit
+// on the ends of each RAM region and finally the interrupt check. The bus
+// check is counted as one cycle for each address & data line it checks.
+// The first failure is returned as-is so that it names the chip.
+//
+PERROR
+CGame::triage(
+)
+{
+    PERROR error = errorSuccess;
+    UINT32 cycles = 0;
+
+    error = busCheck();
+
+    for (UINT8 bit = 0 ; m_cpu->busConnection(ICpu::ADDRESS, bit) != NULL ; bit++)
+    {
+        cycles++;
+    }
+
+    for (UINT8 bit = 0 ; m_cpu->busConnection(ICpu::DATA, bit) != NULL ; bit++)
+    {
+        cycles++;
+    }
+
+    if (SUCCESS(error))
+    {
+        CIoCheck ioCheck( m_cpu,
+                          m_inputRegion,
+                          m_outputRegion,
+                          (void *) this );
+
+        for (int index = 0 ; m_inputRegion.valid(index) && !g_abortRequested ; index++)
+        {
+            const INPUT_REGION region = m_inputRegion[index];
+
+            error = ioCheck.input(&region);
+            cycles++;
+
+            if (FAILED(error))
+            {
+                break;
+            }
+        }
+    }
+
+    if (SUCCESS(error))
+    {
+        CRomCheck romCheck( m_cpu,
+                            m_romRegion,
+                            (void *) this );
+
+        for (int index = 0 ; m_romRegion.valid(index) && !g_abortRequested ; index++)
+        {
+            const ROM_REGION region = m_romRegion[index];
+
+            error = romCheck.checkData2n(&region);
+
+            for (UINT32 shift = 0 ; (1UL << shift) < region.length ; shift++)
+            {
+                cycles++;
+            }
+
+            if (FAILED(error))
+            {
+                break;
+            }
+        }
+    }
+
+    if (SUCCESS(error))
+    {
+        CRamCheck ramCheck( m_cpu,
+                            m_delayFunction,
+                            m_ramRegion,
+                            m_ramRegionByteOnly,
+                            m_ramRegionWriteOnly,
+                            (void *) this );
+
+        for (int index = 0 ; m_ramRegion.valid(index) && !g_abortRequested ; index++)
+        {
+            const RAM_REGION region = m_ramRegion[index];
+
+            error = ramCheck.checkWalkingBit(&region, &cycles);
+
+            if (FAILED(error))
+            {
+                break;
+            }
+        }
+    }
+
+    //
+    // The game's own interrupt check knows the expected vector, or if there
+    // is one at all. Its few acknowledge cycles aren't counted.
+    //
+    if (SUCCESS(error) && !g_abortRequested)
+    {
+        error = interruptCheck();
+
+        if (error == errorNotImplemented)
+        {
+            error = errorSuccess;
+        }
+    }
+
+    if (SUCCESS(error) && g_abortRequested)
+    {
+        error = errorAborted;
+    }
+
+    if (SUCCESS(error))
+    {
+        error = errorCustom;
+
+        error->code = ERROR_SUCCESS;
+        error->description = "OK:Cyc ";
+        error->description += cycles;
+    }
+
+    CEventStream::cycles(cycles);
+
+    return error;
+}
+
+
+//
+// The prediction follows the soak test selections, the ROM check, the RAM
+// checks and the RAM writes. The interrupt check is short and not counted.
+// Cycles with random data are costed separately as generating the data
+// takes about as long as the bus cycle itself.
+//
+PERROR
+CGame::predictRunTime(
+    UINT32 *timeInMs
+)
+{
+    PERROR error = errorSuccess;
+    UINT32 busCycles = 0;
+    UINT32 randomCycles = 0;
+    UINT32 holdTimeInMs = 0;
+    UINT32 busCycleInUs = 0;
+    UINT32 randomInUs = 0;
+    UINT32 address = 0;
+    UINT16 data = 0;
+
+    if (m_romRegion.valid(0))
+    {
+        address = m_romRegion[0].start;
+    }
+    else if (m_ramRegion.valid(0))
+    {
+        address = m_ramRegion[0].start;
+    }
+
+    //
+    // Time 64 reads and 64 random numbers, the costs below are per 64.
+    //
+    {
+        UINT32 startTime = micros();
+
+        for (UINT8 i = 0 ; i < 64 ; i++)
+        {
+            error = m_cpu->memoryRead(address, &data);
+
+            if (FAILED(error))
+            {
+                return error;
+            }
+        }
+
+        busCycleInUs = micros() - startTime;
+        startTime    = micros();
+
+        for (UINT8 i = 0 ; i < 64 ; i++)
+        {
+            data += (UINT16) random(0x10000);
+        }
+
+        randomInUs = micros() - startTime;
+    }
+
+    for (int index = 0 ; m_romRegion.valid(index) ; index++)
+    {
+        const ROM_REGION region = m_romRegion[index];
+
+        busCycles += region.length;
+
+        for (UINT32 shift = 0 ; (1UL << shift) < region.length ; shift++)
+        {
+            busCycles++;
+        }
+    }
+
+    for (int index = 0 ; m_ramRegion.valid(index) ; index++)
+    {
+        const RAM_REGION region = m_ramRegion[index];
+        UINT32 stride = m_cpu->dataBusWidth(region.start) * region.step;
+        UINT32 words  = ((region.end - region.start) / stride) + 1;
+
+        // The RAM check, 2 passes of write & read per seed.
+        randomCycles += words * 4 * g_depthProfile->ramSeeds;
+
+        // The chip select check.
+        randomCycles += words * 2;
+
+        // The 3 writes of all the RAM.
+        busCycles += words * 3;
+    }
+
+    for (int index = 0 ; m_ramRegionWriteOnly.valid(index) ; index++)
+    {
+        const RAM_REGION region = m_ramRegionWriteOnly[index];
+        UINT32 stride = m_cpu->dataBusWidth(region.start) * region.step;
+
+        busCycles += (((region.end - region.start) / stride) + 1) * 3;
+    }
+
+    for (int index = 0 ; m_ramRegionByteOnly.valid(index) ; index++)
+    {
+        const RAM_REGION region = m_ramRegionByteOnly[index];
+        UINT32 stride = m_cpu->dataBusWidth(region.start) * region.step;
+        UINT32 regionLength = (region.end - region.start) / region.step;
+        UINT32 cycles = g_depthProfile->ramAccessCycles;
+
+        // The clear, then 2 random passes per cycle.
+        busCycles    += (region.end - region.start) / stride + 1;
+        randomCycles += ((regionLength * 3) / stride) * 2 * cycles;
+
+        // 4 holds of cycle * 200ms in the first pass & cycle * 300ms after it.
+        holdTimeInMs += (((cycles * (cycles - 1)) / 2) * 1100 * g_depthProfile->ramHoldPercent) / 100;
+    }
+
+    *timeInMs = (((busCycles / 64) * busCycleInUs) +
+                 ((randomCycles / 64) * (busCycleInUs + randomInUs))) / 1000 +
+                holdTimeInMs;
+
+    return error;
+}
+
+
 PERROR
 CGame::romCheckAll(
 )
@@ -147,7 +373,7 @@ CGame::ramCheckAll(
     PERROR error = errorNotImplemented;
 
     // Only handle if a region was defined
-    if (m_ramRegion[0].end != 0)
+    if (m_ramRegion.valid(0))
     {
         CRamCheck ramCheck( m_cpu,
                             m_delayFunction,
@@ -170,7 +396,7 @@ CGame::ramCheckAllChipSelect(
     PERROR error = errorNotImplemented;
 
     // Only handle if a region was defined
-    if (m_ramRegion[0].end != 0)
+    if (m_ramRegion.valid(0))
     {
         CRamCheck ramCheck( m_cpu,
                             m_delayFunction,
@@ -193,7 +419,7 @@ CGame::ramCheckAllRandomAccess(
     PERROR error = errorNotImplemented;
 
     // Only handle if a region was defined
-    if (m_ramRegionByteOnly[0].end != 0)
+    if (m_ramRegionByteOnly.valid(0))
     {
         CRamCheck ramCheck( m_cpu,
                             m_delayFunction,
@@ -268,13 +494,13 @@ CGame::romCheck(
 
     if (key == SELECT_KEY)
     {
-        const ROM_REGION *region = &m_romRegion[m_RomReadRegion];
+        const ROM_REGION region = m_romRegion[m_RomReadRegion];
 
         CRomCheck romCheck( m_cpu,
                             m_romRegion,
                             (void *) this );
 
-        error = romCheck.check(region);
+        error = romCheck.check(&region);
     }
     else
     {
@@ -294,7 +520,7 @@ CGame::romCrc(
 
     if (key == SELECT_KEY)
     {
-        const ROM_REGION *region = &m_romRegion[m_RomReadRegion];
+        const ROM_REGION region = m_romRegion[m_RomReadRegion];
 
         CRomCheck romCheck( m_cpu,
                             m_romRegion,
@@ -302,7 +528,7 @@ CGame::romCrc(
 
         UINT32 crc = 0;
 
-        error = romCheck.calculateCrc(region, &crc);
+        error = romCheck.calculateCrc(&region, &crc);
 
         if (SUCCESS(error))
         {
@@ -310,7 +536,7 @@ CGame::romCrc(
 
             error->code = ERROR_SUCCESS;
             error->description = "OK:";
-            error->description += region->location;
+            error->description += region.location;
             STRING_UINT32_HEX(error->description, crc);
         }
     }
@@ -332,13 +558,13 @@ CGame::romRead(
 
     if (key == SELECT_KEY)
     {
-        const ROM_REGION *region = &m_romRegion[m_RomReadRegion];
+        const ROM_REGION region = m_romRegion[m_RomReadRegion];
 
         CRomCheck romCheck( m_cpu,
                             m_romRegion,
                             (void *) this );
 
-        error = romCheck.readData(region);
+        error = romCheck.readData(&region);
     }
     else
     {
@@ -357,11 +583,11 @@ CGame::ramCheck(
     PERROR error = errorNotImplemented;
 
     // Only handle if a region was defined
-    if (m_ramRegion[0].end != 0)
+    if (m_ramRegion.valid(0))
     {
         if (key == SELECT_KEY)
         {
-            const RAM_REGION *region = &m_ramRegion[m_RamWriteReadRegion];
+            const RAM_REGION region = m_ramRegion[m_RamWriteReadRegion];
 
             CRamCheck ramCheck( m_cpu,
                                 m_delayFunction,
@@ -370,7 +596,7 @@ CGame::ramCheck(
                                 m_ramRegionWriteOnly,
                                 (void *) this );
 
-            error = ramCheck.check(region);
+            error = ramCheck.check(&region);
         }
         else
         {
@@ -390,11 +616,11 @@ CGame::ramCheckRandomAccess(
     PERROR error = errorNotImplemented;
 
     // Only handle if a region was defined
-    if (m_ramRegionByteOnly[0].end != 0)
+    if (m_ramRegionByteOnly.valid(0))
     {
         if (key == SELECT_KEY)
         {
-            const RAM_REGION *region = &m_ramRegionByteOnly[m_RamWriteReadByteRegion];
+            const RAM_REGION region = m_ramRegionByteOnly[m_RamWriteReadByteRegion];
 
             CRamCheck ramCheck( m_cpu,
                                 m_delayFunction,
@@ -403,7 +629,7 @@ CGame::ramCheckRandomAccess(
                                 m_ramRegionWriteOnly,
                                 (void *) this );
 
-            error = ramCheck.checkRandomAccess(region);
+            error = ramCheck.checkRandomAccess(&region);
         }
         else
         {
@@ -422,11 +648,11 @@ CGame::ramCheckAddress(
     PERROR error = errorNotImplemented;
 
     // Only handle if a region was defined
-    if (m_ramRegion[0].end != 0)
+    if (m_ramRegion.valid(0))
     {
         if (key == SELECT_KEY)
         {
-            const RAM_REGION *region = &m_ramRegion[m_RamWriteReadRegion];
+            const RAM_REGION region = m_ramRegion[m_RamWriteReadRegion];
 
             CRamCheck ramCheck( m_cpu,
                                 m_delayFunction,
@@ -435,7 +661,7 @@ CGame::ramCheckAddress(
                                 m_ramRegionWriteOnly,
                                 (void *) this );
 
-            error = ramCheck.checkAddress(region);
+            error = ramCheck.checkAddress(&region);
         }
         else
         {
@@ -455,11 +681,11 @@ CGame::ramWriteRead(
     PERROR error = errorNotImplemented;
 
     // Only handle if a region was defined
-    if (m_ramRegion[0].end != 0)
+    if (m_ramRegion.valid(0))
     {
         if (key == SELECT_KEY)
         {
-            const RAM_REGION *region = &m_ramRegion[m_RamWriteReadRegion];
+            const RAM_REGION region = m_ramRegion[m_RamWriteReadRegion];
 
             CRamCheck ramCheck( m_cpu,
                                 m_delayFunction,
@@ -468,7 +694,7 @@ CGame::ramWriteRead(
                                 m_ramRegionWriteOnly,
                                 (void *) this );
 
-            error = ramCheck.writeReadData(region);
+            error = ramCheck.writeReadData(&region);
         }
         else
         {
@@ -594,14 +820,14 @@ CGame::inputRead(
 
     if (key == UP_KEY)
     {
-        if (m_inputRegion[m_inputReadRegion+1].mask != 0)
+        if (m_inputRegion.valid(m_inputReadRegion+1))
         {
             m_inputReadRegion++;
         }
     }
 
     {
-        const INPUT_REGION *region = &m_inputRegion[m_inputReadRegion];
+        const INPUT_REGION region = m_inputRegion[m_inputReadRegion];
 
         if (key == SELECT_KEY)
         {
@@ -610,19 +836,19 @@ CGame::inputRead(
                               m_outputRegion,
                               (void *) this );
 
-            error = ioCheck.input(region);
+            error = ioCheck.input(&region);
         }
         else
         {
-            UINT8 dataAccessWidth = m_cpu->dataAccessWidth(region->address);
+            UINT8 dataAccessWidth = m_cpu->dataAccessWidth(region.address);
 
             if (dataAccessWidth == 1)
             {
-                STRING_IO8_SUMMARY(errorCustom, region->location, region->mask, region->description);
+                STRING_IO8_SUMMARY(errorCustom, region.location, region.mask, region.description);
             }
             else if (dataAccessWidth == 2)
             {
-                STRING_IO16_SUMMARY(errorCustom, region->location, region->mask, region->description);
+                STRING_IO16_SUMMARY(errorCustom, region.location, region.mask, region.description);
             }
             else
             {
@@ -657,15 +883,15 @@ CGame::outputWrite(
 
     if (key == UP_KEY)
     {
-        if (m_outputRegion[m_outputWriteRegion+1].activeMask != 0)
+        if (m_outputRegion.valid(m_outputWriteRegion+1))
         {
             m_outputWriteRegion++;
         }
     }
 
     {
-        const OUTPUT_REGION *region = &m_outputRegion[m_outputWriteRegion];
-        UINT8 dataAccessWidth = m_cpu->dataAccessWidth(region->address);
+        const OUTPUT_REGION region = m_outputRegion[m_outputWriteRegion];
+        UINT8 dataAccessWidth = m_cpu->dataAccessWidth(region.address);
 
         if (key == SELECT_KEY)
         {
@@ -674,7 +900,7 @@ CGame::outputWrite(
                               m_outputRegion,
                               (void *) this );
 
-            error = ioCheck.output(region, m_outputWriteRegionOn);
+            error = ioCheck.output(&region, m_outputWriteRegionOn);
 
             m_outputWriteRegionOn = !m_outputWriteRegionOn;
         }
@@ -682,11 +908,11 @@ CGame::outputWrite(
         {
             if (dataAccessWidth == 1)
             {
-                STRING_IO8_SUMMARY(errorCustom, region->location, region->activeMask, region->description);
+                STRING_IO8_SUMMARY(errorCustom, region.location, region.activeMask, region.description);
             }
             else if (dataAccessWidth == 2)
             {
-                STRING_IO16_SUMMARY(errorCustom, region->location, region->activeMask, region->description);
+                STRING_IO16_SUMMARY(errorCustom, region.location, region.activeMask, region.description);
             }
             else
             {
@@ -715,7 +941,7 @@ CGame::custom(
     // Only handle custom functions if custom functions have been
     // implemented
     //
-    if (m_customFunction[0].function != NULL)
+    if (m_customFunction.valid(0))
     {
         if (key == SELECT_KEY)
         {
@@ -733,6 +959,32 @@ CGame::custom(
 }
 
 
+PERROR
+CGame::customIndex(
+    int index
+)
+{
+    PERROR error = errorNotImplemented;
+
+    if ((index >= 0) && m_customFunction.valid(index))
+    {
+        CustomFunctionCallback function = m_customFunction[index].function;
+
+        error = function(this);
+    }
+
+    return error;
+}
+
+
+ICpu *
+CGame::cpu(
+)
+{
+    return m_cpu;
+}
+
+
 PERROR
 CGame::onRomKeyMove(
     int key
@@ -750,7 +1002,7 @@ CGame::onRomKeyMove(
 
     if (key == UP_KEY)
     {
-        if (m_romRegion[m_RomReadRegion+1].length != 0)
+        if (m_romRegion.valid(m_RomReadRegion+1))
         {
             m_RomReadRegion++;
         }
@@ -758,16 +1010,16 @@ CGame::onRomKeyMove(
 
     if (key != SELECT_KEY)
     {
-        const ROM_REGION *region = &m_romRegion[m_RomReadRegion];
-        UINT8 dataAccessWidth = m_cpu->dataAccessWidth(region->start);
+        const ROM_REGION region = m_romRegion[m_RomReadRegion];
+        UINT8 dataAccessWidth = m_cpu->dataAccessWidth(region.start);
 
         if (dataAccessWidth == 1)
         {
-            STRING_REGION8_SUMMARY(errorCustom, region->start, 0xFF, region->location);
+            STRING_REGION8_SUMMARY(errorCustom, region.start, 0xFF, region.location);
         }
         else if (dataAccessWidth == 2)
         {
-            STRING_REGION16_SUMMARY(errorCustom, region->start, 0xFFFF, region->location);
+            STRING_REGION16_SUMMARY(errorCustom, region.start, 0xFFFF, region.location);
         }
         else
         {
@@ -801,7 +1053,7 @@ CGame::onRamKeyMove(
 
     if (key == UP_KEY)
     {
-        if (m_ramRegion[m_RamWriteReadRegion+1].end != 0)
+        if (m_ramRegion.valid(m_RamWriteReadRegion+1))
         {
             m_RamWriteReadRegion++;
         }
@@ -809,16 +1061,16 @@ CGame::onRamKeyMove(
 
     if (key != SELECT_KEY)
     {
-        const RAM_REGION *region = &m_ramRegion[m_RamWriteReadRegion];
-        UINT8 dataAccessWidth = m_cpu->dataAccessWidth(region->start);
+        const RAM_REGION region = m_ramRegion[m_RamWriteReadRegion];
+        UINT8 dataAccessWidth = m_cpu->dataAccessWidth(region.start);
 
         if (dataAccessWidth == 1)
         {
-            STRING_REGION8_SUMMARY(errorCustom, region->start, region->mask, region->location);
+            STRING_REGION8_SUMMARY(errorCustom, region.start, region.mask, region.location);
         }
         else if (dataAccessWidth == 2)
         {
-            STRING_REGION16_SUMMARY(errorCustom, region->start, region->mask, region->location);
+            STRING_REGION16_SUMMARY(errorCustom, region.start, region.mask, region.location);
         }
         else
         {
@@ -852,7 +1104,7 @@ CGame::onRamByteKeyMove(
 
     if (key == UP_KEY)
     {
-        if (m_ramRegionByteOnly[m_RamWriteReadByteRegion+1].end != 0)
+        if (m_ramRegionByteOnly.valid(m_RamWriteReadByteRegion+1))
         {
             m_RamWriteReadByteRegion++;
         }
@@ -860,16 +1112,16 @@ CGame::onRamByteKeyMove(
 
     if (key != SELECT_KEY)
     {
-        const RAM_REGION *region = &m_ramRegionByteOnly[m_RamWriteReadByteRegion];
-        UINT8 dataAccessWidth = m_cpu->dataAccessWidth(region->start);
+        const RAM_REGION region = m_ramRegionByteOnly[m_RamWriteReadByteRegion];
+        UINT8 dataAccessWidth = m_cpu->dataAccessWidth(region.start);
 
         if (dataAccessWidth == 1)
         {
-            STRING_REGION8_SUMMARY(errorCustom, region->start, region->mask, region->location);
+            STRING_REGION8_SUMMARY(errorCustom, region.start, region.mask, region.location);
         }
         else if (dataAccessWidth == 2)
         {
-            STRING_REGION16_SUMMARY(errorCustom, region->start, region->mask, region->location);
+            STRING_REGION16_SUMMARY(errorCustom, region.start, region.mask, region.location);
         }
         else
         {
@@ -911,11 +1163,11 @@ CGame::onCustomKeyMove(
 
     if (key != SELECT_KEY)
     {
-        const CUSTOM_FUNCTION *customFunction = &m_customFunction[m_customSelect];
+        const CUSTOM_FUNCTION customFunction = m_customFunction[m_customSelect];
 
         errorCustom->code        = ERROR_SUCCESS;
         errorCustom->description = " ";
-        errorCustom->description += customFunction->description;
+        errorCustom->description += customFunction.description;
     }
 
     if (SUCCESS(error))
@@ -950,35 +1202,13 @@ void CGame::constructor(
     m_outputWriteRegionOn    = true;
     m_customSelect           = 0;
 
-    m_romRegion = mallocProgMem(romRegion);
-
-    if (romData2n != 0)
-    {
-        m_romData2n = mallocProgMem(romData2n, m_romRegion);
-    }
-    else
-    {
-        m_romData2n = 0;
-    }
-
-    m_ramRegion = mallocProgMem(ramRegion);
-
-    if (ramRegion != ramRegionByteOnly)
-    {
-        m_ramRegionByteOnly = mallocProgMem(ramRegionByteOnly);
-    }
-    else
-    {
-        m_ramRegionByteOnly = m_ramRegion;
-    }
-
-    m_ramRegionWriteOnly = mallocProgMem(ramRegionWriteOnly);
-
-    m_inputRegion = mallocProgMem(inputRegion);
-
-    m_outputRegion = mallocProgMem(outputRegion);
-
-    m_customFunction = mallocProgMem(customFunction);
+    m_romRegion          = CRomRegionTable(romRegion, (romData2n != 0));
+    m_ramRegion          = CRegionTable<RAM_REGION>(ramRegion);
+    m_ramRegionByteOnly  = CRegionTable<RAM_REGION>(ramRegionByteOnly);
+    m_ramRegionWriteOnly = CRegionTable<RAM_REGION>(ramRegionWriteOnly);
+    m_inputRegion        = CRegionTable<INPUT_REGION>(inputRegion);
+    m_outputRegion       = CRegionTable<OUTPUT_REGION>(outputRegion);
+    m_customFunction     = CRegionTable<CUSTOM_FUNCTION>(customFunction);
 
     // Select the default if none was provided
     if (delayFunction == NO_DELAY_FUNCTION)
@@ -992,192 +1222,6 @@ void CGame::constructor(
 }
 
 
-//
-// Copy the PROGMEM based region into local SRAM.
-// Also updates the romRegion (that must be in SRAM) to
-// point to the SRAM-based entries in romData2n.
-//
-ROM_DATA2N* CGame::mallocProgMem(
-    const ROM_DATA2N *romData2n,
-    ROM_REGION *romRegion
-)
-{
-    ROM_DATA2N *retRomData2n;
-    UINT16 uRegionSize = 0;
-    UINT16 uIndexCount;
-
-    // The number of entries is determined from the romRegion
-    for (uIndexCount = 0 ; (romRegion[uIndexCount].length != 0) ; uIndexCount++) {}
-
-    uRegionSize = sizeof(romData2n[0]) * (uIndexCount+1);
-
-    retRomData2n = (PROM_DATA2N) malloc( uRegionSize );
-
-    memcpy_P(retRomData2n, romData2n, uRegionSize);
-
-    // Update the data2n pointers in the romRegion to reference SRAM
-    for (uIndexCount = 0 ; (romRegion[uIndexCount].length != 0) ; uIndexCount++)
-    {
-        romRegion[uIndexCount].data2n = retRomData2n[uIndexCount].data2n;
-    }
-
-    return retRomData2n;
-}
-
-
-//
-// Copy the PROGMEM based region into local SRAM.
-//
-ROM_REGION* CGame::mallocProgMem(
-    const ROM_REGION *romRegion
-)
-{
-    ROM_REGION *retRomRegion;
-    UINT16 uIndexCount = 0;
-    UINT16 uRegionSize = 0;
-
-    for ( ;
-          ((pgm_read_word_near((UINT16*) (&romRegion[uIndexCount].length) + 0) != 0) ||
-           (pgm_read_word_near((UINT16*) (&romRegion[uIndexCount].length) + 1) != 0)) ;
-          uIndexCount++) {}
-
-    uRegionSize = sizeof(romRegion[0]) * (uIndexCount+1);
-
-    retRomRegion = (PROM_REGION) malloc( uRegionSize );
-
-    memcpy_P(retRomRegion, romRegion, uRegionSize);
-
-    return retRomRegion;
-}
-
-
-// Copy the PROGMEM based region into local SRAM.
-RAM_REGION* CGame::mallocProgMem(
-    const RAM_REGION *ramRegion
-)
-{
-    RAM_REGION *retRamRegion;
-    UINT16 uIndexCount = 0;
-    UINT16 uRegionSize = 0;
-
-    for ( ;
-          ((pgm_read_word_near((UINT16*) (&ramRegion[uIndexCount].end) + 0) != 0) ||
-           (pgm_read_word_near((UINT16*) (&ramRegion[uIndexCount].end) + 1) != 0)) ;
-          uIndexCount++) {}
-
-    uRegionSize = sizeof(ramRegion[0]) * (uIndexCount+1);
-
-    retRamRegion = (PRAM_REGION) malloc( uRegionSize );
-
-    memcpy_P( retRamRegion, ramRegion, uRegionSize );
-
-    return retRamRegion;
-}
-
-
-// Copy the PROGMEM based region into local SRAM.
-INPUT_REGION* CGame::mallocProgMem(
-    const INPUT_REGION *inputRegion
-)
-{
-    INPUT_REGION *retInputRegion;
-    UINT16 uIndexCount = 0;
-    UINT16 uRegionSize = 0;
-
-    for ( ; pgm_read_word_near(&inputRegion[uIndexCount].mask) != 0 ; uIndexCount++) {}
-
-    uRegionSize = sizeof(inputRegion[0]) * (uIndexCount+1);
-
-    retInputRegion = (PINPUT_REGION) malloc( uRegionSize );
-
-    memcpy_P( retInputRegion, inputRegion, uRegionSize );
-
-    return retInputRegion;
-}
-
-
-// Copy the PROGMEM based region into local SRAM.
-OUTPUT_REGION* CGame::mallocProgMem(
-    const OUTPUT_REGION *outputRegion
-)
-{
-    OUTPUT_REGION *retOutputRegion;
-    UINT16 uIndexCount = 0;
-    UINT16 uRegionSize = 0;
-
-    for ( ; pgm_read_word_near(&outputRegion[uIndexCount].activeMask) != 0 ; uIndexCount++) {}
-
-    uRegionSize = sizeof(outputRegion[0]) * (uIndexCount+1);
-
-    retOutputRegion = (POUTPUT_REGION) malloc( uRegionSize );
-
-    memcpy_P( retOutputRegion, outputRegion, uRegionSize );
-
-    return retOutputRegion;
-}
-
-
-// Copy the PROGMEM based region into local SRAM.
-CUSTOM_FUNCTION* CGame::mallocProgMem(
-    const CUSTOM_FUNCTION *customFunction
-)
-{
-    CUSTOM_FUNCTION *retCustomFunction;
-    UINT16 uIndexCount = 0;
-    UINT16 uRegionSize = 0;
-
-    for ( ; pgm_read_ptr_near(&customFunction[uIndexCount].function) != NULL ; uIndexCount++) {}
-
-    uRegionSize = sizeof(customFunction[0]) * (uIndexCount+1);
-
-    retCustomFunction = (PCUSTOM_FUNCTION) malloc( uRegionSize );
-
-    memcpy_P( retCustomFunction, customFunction, uRegionSize );
-
-    return retCustomFunction;
-}
-
-
-// Add an offset to the start and end addresses.
-void CGame::addAddressOffset(
-    RAM_REGION *ramRegion,
-    UINT32 offset
-)
-{
-    for ( UINT16 i = 0 ; ramRegion[i].end != 0 ; i++ )
-    {
-        ramRegion[i].start += offset;
-        ramRegion[i].end   += offset;
-    }
-}
-
-
-// Add an offset to the address.
-void CGame::addAddressOffset(
-    INPUT_REGION *inputRegion,
-    UINT32 offset
-)
-{
-    for ( UINT16 i = 0 ; inputRegion[i].mask != 0 ; i++ )
-    {
-        inputRegion[i].address += offset;
-    }
-}
-
-
-// Add an offset to the address.
-void CGame::addAddressOffset(
-    OUTPUT_REGION *outputRegion,
-    UINT32 offset
-)
-{
-    for ( UINT16 i = 0 ; outputRegion[i].activeMask != 0 ; i++ )
-    {
-        outputRegion[i].address += offset;
-    }
-}
-
-
 // Default delay function
 PERROR CGame::delayFunction(
     void *context,
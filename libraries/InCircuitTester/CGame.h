@@ -27,6 +27,7 @@
 
 #include "IGame.h"
 #include "ICpu.h"
+#include "CRegionTable.h"
 
 class CGame : public IGame
 {
@@ -42,6 +43,13 @@ class CGame : public IGame
         virtual PERROR busCheck(
         );
 
+        virtual PERROR triage(
+        );
+
+        virtual PERROR predictRunTime(
+            UINT32 *timeInMs
+        );
+
         virtual PERROR romCheckAll(
         );
 
@@ -117,6 +125,13 @@ class CGame : public IGame
             int key
         );
 
+        virtual PERROR customIndex(
+            int index
+        );
+
+        virtual ICpu *cpu(
+        );
+
         virtual PERROR onRomKeyMove(
             int key
         );
@@ -137,8 +152,8 @@ class CGame : public IGame
 
         //
         // NOTE: These are all assumed to be defined in PROGMEM since
-        // they are large data structures. The constructor will copy them
-        // over to SRAM.
+        // they are large data structures. They are accessed in place
+        // through region table views rather than copied to SRAM.
         //
 
         CGame(
@@ -166,7 +181,7 @@ class CGame : public IGame
             const DelayFunctionCallback  delayFunction = NO_DELAY_FUNCTION
         );
 
-        ~CGame();
+        virtual ~CGame();
 
         // Factored out common constructor
         void constructor(
@@ -181,55 +196,6 @@ class CGame : public IGame
             const DelayFunctionCallback  delayFunction
         );
 
-        //
-        // These utilities allocate the associated region and perform a
-        // PROGMEM copy from the supplied PROGMEM constant into it.
-        //
-        ROM_DATA2N* mallocProgMem(
-            const ROM_DATA2N *romData2n,
-            ROM_REGION *romRegion
-        );
-
-        ROM_REGION* mallocProgMem(
-            const ROM_REGION *romRegion
-        );
-
-        RAM_REGION* mallocProgMem(
-            const RAM_REGION *ramRegion
-        );
-
-        INPUT_REGION* mallocProgMem(
-            const INPUT_REGION *inputRegion
-        );
-
-        OUTPUT_REGION* mallocProgMem(
-            const OUTPUT_REGION *outputRegion
-        );
-
-        CUSTOM_FUNCTION* mallocProgMem(
-            const CUSTOM_FUNCTION *customFunction
-        );
-
-        //
-        // These utilities add a simple address offset to the supplied
-        // region to allow the whole address space to be dynamically moved.
-        //
-
-        void addAddressOffset(
-            RAM_REGION *ramRegion,
-            UINT32 offset
-        );
-
-        void addAddressOffset(
-            INPUT_REGION *inputRegion,
-            UINT32 offset
-        );
-
-        void addAddressOffset(
-            OUTPUT_REGION *outputRegion,
-            UINT32 offset
-        );
-
         //
         // Default implementation of the delay function that just
         // uses the built-in function.
@@ -240,18 +206,18 @@ class CGame : public IGame
         );
 
         //
-        // These are filled in by the derived concrete game and are SRAM copies
-        // of the supplied PROGMEM source data.
+        // These are views of the PROGMEM source data supplied by the derived
+        // concrete game. A derived game can add an address offset to move
+        // the whole address space.
         //
 
-        ROM_DATA2N      *m_romData2n;
-        ROM_REGION      *m_romRegion;
-        RAM_REGION      *m_ramRegion;
-        RAM_REGION      *m_ramRegionByteOnly;
-        RAM_REGION      *m_ramRegionWriteOnly;
-        INPUT_REGION    *m_inputRegion;
-        OUTPUT_REGION   *m_outputRegion;
-        CUSTOM_FUNCTION *m_customFunction;
+        CRomRegionTable                m_romRegion;
+        CRegionTable<RAM_REGION>       m_ramRegion;
+        CRegionTable<RAM_REGION>       m_ramRegionByteOnly;
+        CRegionTable<RAM_REGION>       m_ramRegionWriteOnly;
+        CRegionTable<INPUT_REGION>     m_inputRegion;
+        CRegionTable<OUTPUT_REGION>    m_outputRegion;
+        CRegionTable<CUSTOM_FUNCTION>  m_customFunction;
 
         //
         // The delay function to use for some tests
@@ -23,11 +23,14 @@
 // EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 //
 #include "CGameCallback.h"
+#include "Depth.h"
 
 
 static const SELECTOR s_selectorGame[] = { //"0123456789abcdef"
                                             {"Bus Idle",        CGameCallback::onSelectBusIdle,        (void*) &CGameCallback::game, false},
                                             {"Bus Check",       CGameCallback::onSelectBusCheck,       (void*) &CGameCallback::game, false},
+                                            {"Triage",          CGameCallback::onSelectTriage,         (void*) &CGameCallback::game, false},
+                                            {"Soak Run Time",   CGameCallback::onSelectRunTime,        (void*) &CGameCallback::game, false},
                                             {"ROM Check All",   CGameCallback::onSelectRomCheckAll,    (void*) &CGameCallback::game, false},
                                             {"RAM Check All",   CGameCallback::onSelectRamCheckAll,    (void*) &CGameCallback::game, false},
                                             {"RAM Check All RA",CGameCallback::onSelectRamCheckAllRA,  (void*) &CGameCallback::game, false},
@@ -56,6 +59,7 @@ const SELECTOR *CGameCallback::selectorGame = s_selectorGame;
 static const SELECTOR s_selectorGeneric[] = { //"0123456789abcdef"
                                                {"Bus Idle",        CGameCallback::onSelectBusIdle,        (void*) &CGameCallback::game, false},
                                                {"Bus Check",       CGameCallback::onSelectBusCheck,       (void*) &CGameCallback::game, false},
+                                               {"Triage",          CGameCallback::onSelectTriage,         (void*) &CGameCallback::game, false},
                                                {"ROM CRC",         CGameCallback::onSelectRomCrc,         (void*) &CGameCallback::game, true},
                                                {"ROM Read",        CGameCallback::onSelectRomRead,        (void*) &CGameCallback::game, true},
                                                {"RAM Check",       CGameCallback::onSelectRamCheck,       (void*) &CGameCallback::game, true},
@@ -106,6 +110,46 @@ CGameCallback::onSelectBusCheck(
     return game->busCheck();
 }
 
+PERROR
+CGameCallback::onSelectTriage(
+    void *iGame,
+    int  key
+)
+{
+    IGame *game = *((IGame **) iGame);
+
+    return game->triage();
+}
+
+//
+// 0123456789abcdef
+// OK:~12m05s Quick
+//
+PERROR
+CGameCallback::onSelectRunTime(
+    void *iGame,
+    int  key
+)
+{
+    IGame *game = *((IGame **) iGame);
+    UINT32 timeInMs = 0;
+
+    PERROR error = game->predictRunTime(&timeInMs);
+
+    if (SUCCESS(error))
+    {
+        error = errorCustom;
+
+        error->code = ERROR_SUCCESS;
+        error->description = "OK:~";
+        appendDuration(error->description, timeInMs);
+        error->description += " ";
+        error->description += g_depthProfile->name;
+    }
+
+    return error;
+}
+
 PERROR
 CGameCallback::onSelectRomCheckAll(
     void *iGame,
@@ -73,6 +73,16 @@ class CGameCallback
             int  key
         );
 
+        static PERROR onSelectTriage(
+            void *iGame,
+            int  key
+        );
+
+        static PERROR onSelectRunTime(
+            void *iGame,
+            int  key
+        );
+
         static PERROR onSelectRomCheckAll(
             void *iGame,
             int  key
@@ -0,0 +1,70 @@
+//
+// Copyright (c) 2021, Paul R. Swan
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+// OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR
+// TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+// EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+#include "CGoertzel.h"
+#include <math.h>
+
+
+CGoertzel::CGoertzel(
+) : m_frequencyHz(0),
+    m_coeff(0),
+    m_s1(0),
+    m_s2(0)
+{
+}
+
+
+//
+// The coefficient is 2*cos(2*pi*f/fs). It's only calculated once per block
+// so floating point is used here but not in the per sample filter.
+//
+void
+CGoertzel::begin(
+    UINT16 frequencyHz,
+    UINT16 sampleRateHz
+)
+{
+    double omega = (2.0 * M_PI * (double) frequencyHz) / (double) sampleRateHz;
+
+    m_frequencyHz = frequencyHz;
+    m_coeff = (INT32) floor((2.0 * cos(omega) * 4096.0) + 0.5);
+    m_s1 = 0;
+    m_s2 = 0;
+}
+
+
+//
+// |X|^2 = s1^2 + s2^2 - coeff*s1*s2 with the state scaled down by 16 so the
+// products fit in 32 bits.
+//
+UINT32
+CGoertzel::power(
+)
+{
+    INT32 s1 = m_s1 >> 4;
+    INT32 s2 = m_s2 >> 4;
+    INT32 power = (s1 * s1) + (s2 * s2) - (((m_coeff * s1) >> 12) * s2);
+
+    return (power > 0) ? (UINT32) power : 0;
+}
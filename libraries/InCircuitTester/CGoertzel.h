@@ -0,0 +1,103 @@
+//
+// Copyright (c) 2021, Paul R. Swan
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+// OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR
+// TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+// EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+#ifndef CGoertzel_h
+#define CGoertzel_h
+
+//
+// Plain C++ so the filter can be built on a host and fed recorded sample
+// streams as well as on the tester. The host types are sized to match the
+// AVR so the fixed-point overflow behaviour is the same.
+//
+#ifdef ARDUINO
+#include "Types.h"
+#else
+#include <stdint.h>
+typedef int16_t  INT16;
+typedef int32_t  INT32;
+typedef uint8_t  UINT8;
+typedef uint16_t UINT16;
+typedef uint32_t UINT32;
+#endif
+
+//
+// Streaming fixed-point Goertzel filter that measures the energy of a single
+// frequency in a block of samples without storing them.
+//
+// The coefficient is Q12 and the state 32-bit. Samples are expected to be
+// within +/-256 and blocks no longer than 256 samples. To keep the state
+// within range the frequency should be between 1/16 and 7/16 of the sample rate.
+//
+class CGoertzel
+{
+    public:
+
+        CGoertzel(
+        );
+
+        //
+        // Set the frequency and clear the state for a new block.
+        //
+        void
+        begin(
+            UINT16 frequencyHz,
+            UINT16 sampleRateHz
+        );
+
+        inline
+        void
+        sample(
+            INT16 x
+        )
+        {
+            INT32 s = (INT32) x + ((m_coeff * m_s1) >> 12) - m_s2;
+
+            m_s2 = m_s1;
+            m_s1 = s;
+        };
+
+        //
+        // The squared magnitude of the frequency over the block, divided by 256.
+        //
+        UINT32
+        power(
+        );
+
+        UINT16
+        frequency(
+        )
+        {
+            return m_frequencyHz;
+        };
+
+    private:
+
+        UINT16 m_frequencyHz;
+        INT32  m_coeff;
+        INT32  m_s1;
+        INT32  m_s2;
+
+};
+
+#endif
@@ -28,8 +28,8 @@
 
 CIoCheck::CIoCheck(
     ICpu *cpu,
-    const INPUT_REGION  inputRegion[],
-    const OUTPUT_REGION outputRegion[],
+    const CRegionTable<INPUT_REGION>  &inputRegion,
+    const CRegionTable<OUTPUT_REGION> &outputRegion,
     void *bankSwitchContext
 ) : m_cpu(cpu),
     m_inputRegion(inputRegion),
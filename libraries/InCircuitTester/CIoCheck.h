@@ -28,6 +28,7 @@
 #include "Arduino.h"
 #include "Types.h"
 #include "ICpu.h"
+#include "CRegionTable.h"
 
 
 class CIoCheck
@@ -36,8 +37,8 @@ class CIoCheck
 
         CIoCheck(
             ICpu *cpu,
-            const INPUT_REGION  inputRegion[],
-            const OUTPUT_REGION outputRegion[],
+            const CRegionTable<INPUT_REGION>  &inputRegion,
+            const CRegionTable<OUTPUT_REGION> &outputRegion,
             void *bankSwitchContext
         );
 
@@ -58,10 +59,10 @@ class CIoCheck
 
    private:
 
-        ICpu                *m_cpu;
-        const INPUT_REGION  *m_inputRegion;
-        const OUTPUT_REGION *m_outputRegion;
-        void                *m_bankSwitchContext;
+        ICpu                        *m_cpu;
+        CRegionTable<INPUT_REGION>   m_inputRegion;
+        CRegionTable<OUTPUT_REGION>  m_outputRegion;
+        void                        *m_bankSwitchContext;
 
 };
 
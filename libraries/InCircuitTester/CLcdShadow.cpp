@@ -0,0 +1,195 @@
+//
+// Copyright (c) 2021, Paul R. Swan
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+// OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR
+// TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+// EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+#include "CLcdShadow.h"
+
+//
+// Used to mark the display cursor position as unknown.
+//
+static const UINT8 s_unknown = 0xFF;
+
+
+CLcdShadow::CLcdShadow(
+    LiquidCrystal &lcd
+) : m_lcd(lcd),
+    m_column(0),
+    m_row(0),
+    m_displayColumn(s_unknown),
+    m_displayRow(s_unknown),
+    m_statusReserved(false)
+{
+    memset(m_shadow,  ' ', sizeof(m_shadow));
+    memset(m_display, ' ', sizeof(m_display));
+}
+
+
+void
+CLcdShadow::begin(
+)
+{
+    m_lcd.begin(s_columns, s_rows);
+    m_lcd.clear();
+
+    memset(m_shadow,  ' ', sizeof(m_shadow));
+    memset(m_display, ' ', sizeof(m_display));
+
+    m_column         = 0;
+    m_row            = 0;
+    m_displayColumn  = s_unknown;
+    m_displayRow     = s_unknown;
+    m_statusReserved = false;
+}
+
+
+void
+CLcdShadow::clear(
+)
+{
+    for (UINT8 row = 0 ; row < s_rows ; row++)
+    {
+        for (UINT8 column = 0 ; column < s_columns ; column++)
+        {
+            if (!isStatusCell(column, row))
+            {
+                m_shadow[row][column] = ' ';
+            }
+        }
+    }
+
+    m_column = 0;
+    m_row    = 0;
+}
+
+
+void
+CLcdShadow::setCursor(
+    UINT8 column,
+    UINT8 row
+)
+{
+    m_column = column;
+    m_row    = (row < s_rows) ? row : (s_rows - 1);
+}
+
+
+void
+CLcdShadow::print(
+    PCSTR text
+)
+{
+    for ( ; (*text != '\0') && (m_column < s_columns) ; text++, m_column++)
+    {
+        if (!isStatusCell(m_column, m_row))
+        {
+            m_shadow[m_row][m_column] = *text;
+        }
+    }
+}
+
+
+void
+CLcdShadow::print(
+    const String &text
+)
+{
+    print(text.c_str());
+}
+
+
+void
+CLcdShadow::update(
+)
+{
+    for (UINT8 row = 0 ; row < s_rows ; row++)
+    {
+        for (UINT8 column = 0 ; column < s_columns ; column++)
+        {
+            if (m_shadow[row][column] != m_display[row][column])
+            {
+                send(column, row);
+            }
+        }
+    }
+}
+
+
+void
+CLcdShadow::status(
+    CHAR value
+)
+{
+    const UINT8 column = s_columns - 1;
+    const UINT8 row    = 0;
+
+    m_statusReserved = (value != '\0');
+
+    m_shadow[row][column] = m_statusReserved ? value : ' ';
+
+    if (m_shadow[row][column] != m_display[row][column])
+    {
+        send(column, row);
+    }
+}
+
+
+bool
+CLcdShadow::isStatusCell(
+    UINT8 column,
+    UINT8 row
+)
+{
+    return m_statusReserved && (row == 0) && (column == (s_columns - 1));
+}
+
+
+void
+CLcdShadow::send(
+    UINT8 column,
+    UINT8 row
+)
+{
+    if ((column != m_displayColumn) || (row != m_displayRow))
+    {
+        m_lcd.setCursor(column, row);
+    }
+
+    m_lcd.write((uint8_t) m_shadow[row][column]);
+    m_display[row][column] = m_shadow[row][column];
+
+    //
+    // The display cursor moves on to the next cell but wraps
+    // to a different line at the end so that's left unknown.
+    //
+    if (column < (s_columns - 1))
+    {
+        m_displayColumn = column + 1;
+        m_displayRow    = row;
+    }
+    else
+    {
+        m_displayColumn = s_unknown;
+        m_displayRow    = s_unknown;
+    }
+}
+
@@ -0,0 +1,137 @@
+//
+// Copyright (c) 2021, Paul R. Swan
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+// OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR
+// TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+// EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+#ifndef CLcdShadow_h
+#define CLcdShadow_h
+
+#include "Arduino.h"
+#include "Types.h"
+#include <LiquidCrystal.h>
+
+//
+// A shadow of the 16 x 2 LCD so only the characters that changed are sent.
+//
+// Text is drawn into the shadow with the same calls as LiquidCrystal (clear
+// doesn't touch the display) and update() then moves the cursor and writes
+// just the cells that differ from what the display holds. A 4-bit write is
+// ~50us per character and a clear is ~2ms so an unchanged or mostly
+// unchanged screen costs almost nothing to redraw.
+//
+// The last cell of the top line can be reserved as a status cell for a
+// progress indicator that is written straight through, e.g. once per test
+// iteration, without touching the rest of the display.
+//
+class CLcdShadow
+{
+    public:
+
+        static const UINT8 s_columns = 16;
+        static const UINT8 s_rows    = 2;
+
+        CLcdShadow(
+            LiquidCrystal &lcd
+        );
+
+        void
+        begin(
+        );
+
+        //
+        // Blank the shadow (but not the status cell when it's reserved).
+        //
+        void
+        clear(
+        );
+
+        void
+        setCursor(
+            UINT8 column,
+            UINT8 row
+        );
+
+        //
+        // Draw text from the cursor, clipped at the end of the line.
+        //
+        void
+        print(
+            PCSTR text
+        );
+
+        void
+        print(
+            const String &text
+        );
+
+        //
+        // Send the changed characters to the display.
+        //
+        void
+        update(
+        );
+
+        //
+        // Reserve the status cell and show the character in it immediately.
+        // A NUL releases the cell back to the text.
+        //
+        void
+        status(
+            CHAR value
+        );
+
+    private:
+
+        bool
+        isStatusCell(
+            UINT8 column,
+            UINT8 row
+        );
+
+        void
+        send(
+            UINT8 column,
+            UINT8 row
+        );
+
+    private:
+
+        LiquidCrystal &m_lcd;
+
+        CHAR  m_shadow[s_rows][s_columns];
+        CHAR  m_display[s_rows][s_columns];
+
+        UINT8 m_column;
+        UINT8 m_row;
+
+        //
+        // Where the display's own cursor is after the last write so runs of
+        // changed characters don't need a setCursor each.
+        //
+        UINT8 m_displayColumn;
+        UINT8 m_displayRow;
+
+        bool  m_statusReserved;
+
+};
+
+#endif
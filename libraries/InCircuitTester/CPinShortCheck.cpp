@@ -0,0 +1,311 @@
+//
+// Copyright (c) 2021, Paul R. Swan
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+// OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR
+// TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+// EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+#include "CPinShortCheck.h"
+
+//
+// Time allowed for an undriven pin to be pulled back up through the weak
+// internal pullup and the board capacitance.
+//
+static const unsigned int s_settleUs = 20;
+
+
+CPinShortCheck::CPinShortCheck(
+    const UINT8            *pinMap,
+    const CONNECTION_GROUP *groups,
+    UINT8                  groupCount
+) : m_pinMap(pinMap),
+    m_count(0),
+    m_bits(0)
+{
+    for (UINT8 group = 0 ; group < groupCount ; group++)
+    {
+        for (UINT8 i = 0 ; (i < groups[group].count) && (m_count < s_maxPins) ; i++)
+        {
+            // Pin 0 is used for signals not present on the probe.
+            if (groups[group].connection[i].pin != 0)
+            {
+                m_pin[m_count]    = &groups[group].connection[i];
+                m_strobe[m_count] = groups[group].strobe;
+                m_count++;
+            }
+        }
+    }
+
+    while ((1 << m_bits) < m_count)
+    {
+        m_bits++;
+    }
+};
+
+
+PERROR
+CPinShortCheck::check(
+)
+{
+    PERROR error = errorSuccess;
+    UINT8 fullMask = (1 << m_bits) - 1;
+
+    //
+    // With nothing driven every pin should float high. A low here is either a
+    // short to ground or to a board driver and would mask the group tests.
+    //
+
+    release();
+
+    for (UINT8 i = 0 ; i < m_count ; i++)
+    {
+        if (isLow(i))
+        {
+            error = errorCustom;
+            error->code = ERROR_FAILED;
+            error->description = "E:";
+            error->description += m_pin[i]->name;
+            error->description += " p";
+            error->description += m_pin[i]->pin;
+            error->description += " Lo";
+            goto Exit;
+        }
+    }
+
+    //
+    // For each index bit drive the pins with that bit clear and then the pins
+    // with it set. Any undriven pin that reads low is shorted into the group.
+    //
+
+    for (UINT8 bit = 0 ; bit < m_bits ; bit++)
+    {
+        for (UINT8 phase = 0 ; phase < 2 ; phase++)
+        {
+            UINT8 mask  = (1 << bit);
+            UINT8 value = (phase << bit);
+
+            drive(mask, value);
+
+            for (UINT8 i = 0 ; i < m_count ; i++)
+            {
+                UINT8 partner;
+
+                if ((((i & mask) == value) && !m_strobe[i]) || !isLow(i))
+                {
+                    continue;
+                }
+
+                if (findPartner(i, mask, value, &partner))
+                {
+                    error = shorted(i, partner);
+                    goto Exit;
+                }
+
+                // The search moved the drive so restore this test's group.
+                drive(mask, value);
+            }
+        }
+    }
+
+    //
+    // Drive each strobe on its own. A short to a strobe from another pin has
+    // been seen above but not one between two strobes.
+    //
+
+    for (UINT8 strobe = 0 ; strobe < m_count ; strobe++)
+    {
+        if (!m_strobe[strobe])
+        {
+            continue;
+        }
+
+        drive(fullMask, strobe);
+
+        for (UINT8 i = 0 ; i < m_count ; i++)
+        {
+            if ((i == strobe) || !isLow(i))
+            {
+                continue;
+            }
+
+            // Confirm the pair the other way round, as findPartner() does.
+            drive(fullMask, i);
+
+            if (isLow(strobe))
+            {
+                error = shorted(strobe, i);
+                goto Exit;
+            }
+
+            drive(fullMask, strobe);
+        }
+    }
+
+Exit:
+    release();
+
+    return error;
+}
+
+
+void
+CPinShortCheck::release(
+)
+{
+    for (UINT8 i = 0 ; i < m_count ; i++)
+    {
+        ::pinMode(m_pinMap[m_pin[i]->pin], INPUT_PULLUP);
+    }
+
+    ::delayMicroseconds(s_settleUs);
+}
+
+
+//
+// Drive the pins whose index matches value under mask low and leave the
+// rest on INPUT_PULLUP. The undriven pins are released first so that no
+// two driven pins are ever momentarily fighting through a short. Strobes
+// are only driven when they're the single pin selected.
+//
+void
+CPinShortCheck::drive(
+    UINT8 mask,
+    UINT8 value
+)
+{
+    bool single = (mask == ((1 << m_bits) - 1));
+
+    for (UINT8 i = 0 ; i < m_count ; i++)
+    {
+        if (((i & mask) != value) || (m_strobe[i] && !single))
+        {
+            ::pinMode(m_pinMap[m_pin[i]->pin], INPUT_PULLUP);
+        }
+    }
+
+    for (UINT8 i = 0 ; i < m_count ; i++)
+    {
+        if (((i & mask) == value) && (!m_strobe[i] || single))
+        {
+            ::digitalWrite(m_pinMap[m_pin[i]->pin], LOW);
+            ::pinMode(m_pinMap[m_pin[i]->pin], OUTPUT);
+        }
+    }
+
+    ::delayMicroseconds(s_settleUs);
+}
+
+
+bool
+CPinShortCheck::isLow(
+    UINT8 index
+)
+{
+    return (::digitalRead(m_pinMap[m_pin[index]->pin]) == LOW);
+}
+
+
+PERROR
+CPinShortCheck::shorted(
+    UINT8 first,
+    UINT8 second
+)
+{
+    PERROR error = errorCustom;
+
+    if (first > second)
+    {
+        UINT8 swap = first;
+
+        first  = second;
+        second = swap;
+    }
+
+    error->code = ERROR_FAILED;
+    error->description = "E:";
+    error->description += m_pin[first]->name;
+    error->description += "=";
+    error->description += m_pin[second]->name;
+    error->description += " Sh";
+
+    return error;
+}
+
+
+//
+// Binary search the driven group (mask/value) for the single pin that pulls
+// the given undriven pin low. The result is confirmed by driving each pin of
+// the pair on its own so that a combined effect of several driven pins (e.g.
+// a read strobe plus an address enabling a buffer onto the data bus) is not
+// reported as a short.
+//
+bool
+CPinShortCheck::findPartner(
+    UINT8 index,
+    UINT8 mask,
+    UINT8 value,
+    UINT8 *partner
+)
+{
+    UINT8 fullMask = (1 << m_bits) - 1;
+
+    for (UINT8 bit = 0 ; bit < m_bits ; bit++)
+    {
+        UINT8 bitMask = (1 << bit);
+
+        if (mask & bitMask)
+        {
+            continue;
+        }
+
+        mask |= bitMask;
+
+        drive(mask, value);
+
+        if (!isLow(index))
+        {
+            value |= bitMask;
+        }
+    }
+
+    if ((value >= m_count) || (value == index))
+    {
+        return false;
+    }
+
+    drive(fullMask, value);
+
+    if (!isLow(index))
+    {
+        return false;
+    }
+
+    drive(fullMask, index);
+
+    if (!isLow(value))
+    {
+        return false;
+    }
+
+    *partner = value;
+
+    return true;
+}
+
@@ -0,0 +1,130 @@
+//
+// Copyright (c) 2021, Paul R. Swan
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+// OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR
+// TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+// EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+#ifndef CPinShortCheck_h
+#define CPinShortCheck_h
+
+#include "Arduino.h"
+#include "Types.h"
+#include "Error.h"
+
+//
+// A table of probe connections to include in the short check.
+// A single pin is described with a count of 1.
+//
+// Bus strobes (e.g. /MREQ, /RD & /WR) are marked so that they're never
+// driven low together, which would run a bus cycle on the board. They are
+// only driven one at a time and are otherwise receivers.
+//
+typedef struct _CONNECTION_GROUP {
+
+    const CONNECTION *connection;
+    UINT8             count;
+    bool              strobe;
+
+} CONNECTION_GROUP, *PCONNECTION_GROUP;
+
+//
+// Detects pin to pin shorts on the probe socket (e.g. solder bridges between
+// adjacent CPU pins) before any bus cycles are attempted.
+//
+// Each test drives a group of pins low with the remainder left on INPUT_PULLUP.
+// Groups are formed from the bits of each pin's index so that any two pins are
+// on opposite sides of at least one partition. N pins are therefore covered by
+// 2*log2(N) group tests rather than N*N pairwise tests. When an undriven pin is
+// pulled low the driven group is halved until a single partner remains, and the
+// pair is then confirmed by driving each pin on its own.
+//
+// Strobes are left out of the driven groups and each is then driven on its
+// own with every other pin as a receiver.
+//
+// Only pins the board never drives should be included, i.e. CPU outputs and
+// buses. Power, clock and CPU input pins are excluded by the caller.
+//
+// 0123456789abcdef
+// E:A6=A7 Sh         - A6 & A7 are shorted together.
+// E:_RD p21 Lo       - _RD is held low with nothing driving it.
+//
+class CPinShortCheck
+{
+    public:
+
+        CPinShortCheck(
+            const UINT8            *pinMap,
+            const CONNECTION_GROUP *groups,
+            UINT8                  groupCount
+        );
+
+        //
+        // On exit all of the pins are left as INPUT_PULLUP and the
+        // caller is expected to idle the CPU to restore its pin modes.
+        //
+        PERROR
+        check(
+        );
+
+    private:
+
+        void
+        release(
+        );
+
+        void
+        drive(
+            UINT8 mask,
+            UINT8 value
+        );
+
+        bool
+        isLow(
+            UINT8 index
+        );
+
+        PERROR
+        shorted(
+            UINT8 first,
+            UINT8 second
+        );
+
+        bool
+        findPartner(
+            UINT8 index,
+            UINT8 mask,
+            UINT8 value,
+            UINT8 *partner
+        );
+
+    private:
+
+        static const UINT8 s_maxPins = 40;
+
+        const UINT8      *m_pinMap;
+        const CONNECTION *m_pin[s_maxPins];
+        bool             m_strobe[s_maxPins];
+        UINT8            m_count;
+        UINT8            m_bits;
+
+};
+
+#endif
@@ -23,18 +23,20 @@
 // EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 //
 #include "CRamCheck.h"
+#include "CBusLineCheck.h"
+#include "Depth.h"
 #include "zutil.h"
 
-static const long s_randomSeed[] = {7, 144};
+static const long s_randomSeed[] = {7, 144, 1021, 30011};
 static const long s_randomSize = 0x10000;
 
 
 CRamCheck::CRamCheck(
     ICpu *cpu,
     const DelayFunctionCallback delayFunction,
-    const RAM_REGION ramRegion[],
-    const RAM_REGION ramRegionByteOnly[],
-    const RAM_REGION ramRegionWriteOnly[],
+    const CRegionTable<RAM_REGION> &ramRegion,
+    const CRegionTable<RAM_REGION> &ramRegionByteOnly,
+    const CRegionTable<RAM_REGION> &ramRegionWriteOnly,
     void *bankSwitchContext
 ) : m_cpu(cpu),
     m_delayFunction(delayFunction),
@@ -54,9 +56,17 @@ CRamCheck::check(
 {
     PERROR error = errorSuccess;
 
-    for (int i = 0 ; m_ramRegion[i].end != 0 ; i++)
+    for (int i = 0 ; m_ramRegion.valid(i) ; i++)
     {
-        error = check( &m_ramRegion[i] );
+        RAM_REGION ramRegion = m_ramRegion[i];
+
+        if (g_abortRequested)
+        {
+            error = errorAborted;
+            break;
+        }
+
+        error = check( &ramRegion );
 
         if (FAILED(error))
         {
@@ -87,10 +97,12 @@ CRamCheck::checkChipSelect(
     // Step 1 - Write all the regions
     //
 
-    for (int i = 0 ; m_ramRegion[i].end != 0 ; i++)
+    for (int i = 0 ; m_ramRegion.valid(i) ; i++)
     {
-        error = writeRandom( &m_ramRegion[i],
-                             (m_ramRegion[i].start & 0xFFFE) + 1,
+        RAM_REGION ramRegion = m_ramRegion[i];
+
+        error = writeRandom( &ramRegion,
+                             (ramRegion.start & 0xFFFE) + 1,
                              true );
 
         if (FAILED(error))
@@ -105,10 +117,12 @@ CRamCheck::checkChipSelect(
 
     if (SUCCESS(error))
     {
-        for (int i = 0 ; m_ramRegion[i].end != 0 ; i++)
+        for (int i = 0 ; m_ramRegion.valid(i) ; i++)
         {
-            error = readVerifyRandom( &m_ramRegion[i],
-                                      (m_ramRegion[i].start & 0xFFFE) + 1,
+            RAM_REGION ramRegion = m_ramRegion[i];
+
+            error = readVerifyRandom( &ramRegion,
+                                      (ramRegion.start & 0xFFFE) + 1,
                                       true );
 
             if (FAILED(error))
@@ -130,9 +144,17 @@ CRamCheck::checkRandomAccess(
 {
     PERROR error = errorSuccess;
 
-    for (int i = 0 ; m_ramRegionByteOnly[i].end != 0 ; i++)
+    for (int i = 0 ; m_ramRegionByteOnly.valid(i) ; i++)
     {
-        error = checkRandomAccess( &m_ramRegionByteOnly[i] );
+        RAM_REGION ramRegion = m_ramRegionByteOnly[i];
+
+        if (g_abortRequested)
+        {
+            error = errorAborted;
+            break;
+        }
+
+        error = checkRandomAccess( &ramRegion );
 
         if (FAILED(error))
         {
@@ -153,9 +175,11 @@ CRamCheck::write(
 {
     PERROR error = errorSuccess;
 
-    for (int i = 0 ; m_ramRegion[i].end != 0 ; i++)
+    for (int i = 0 ; m_ramRegion.valid(i) ; i++)
     {
-        error = write( &m_ramRegion[i] );
+        RAM_REGION ramRegion = m_ramRegion[i];
+
+        error = write( &ramRegion );
 
         if (FAILED(error))
         {
@@ -165,9 +189,11 @@ CRamCheck::write(
 
     if (SUCCESS(error))
     {
-        for (int i = 0 ; m_ramRegionWriteOnly[i].end != 0 ; i++)
+        for (int i = 0 ; m_ramRegionWriteOnly.valid(i) ; i++)
         {
-            error = write( &m_ramRegionWriteOnly[i] );
+            RAM_REGION ramRegion = m_ramRegionWriteOnly[i];
+
+            error = write( &ramRegion );
 
             if (FAILED(error))
             {
@@ -190,9 +216,11 @@ CRamCheck::write(
 {
     PERROR error = errorSuccess;
 
-    for (int i = 0 ; m_ramRegion[i].end != 0 ; i++)
+    for (int i = 0 ; m_ramRegion.valid(i) ; i++)
     {
-        error = write( &m_ramRegion[i],
+        RAM_REGION ramRegion = m_ramRegion[i];
+
+        error = write( &ramRegion,
                        value );
 
         if (FAILED(error))
@@ -203,9 +231,11 @@ CRamCheck::write(
 
     if (SUCCESS(error))
     {
-        for (int i = 0 ; m_ramRegionWriteOnly[i].end != 0 ; i++)
+        for (int i = 0 ; m_ramRegionWriteOnly.valid(i) ; i++)
         {
-            error = write( &m_ramRegionWriteOnly[i],
+            RAM_REGION ramRegion = m_ramRegionWriteOnly[i];
+
+            error = write( &ramRegion,
                            value );
 
             if (FAILED(error))
@@ -227,9 +257,11 @@ CRamCheck::read(
 {
     PERROR error = errorSuccess;
 
-    for (int i = 0 ; m_ramRegion[i].end != 0 ; i++)
+    for (int i = 0 ; m_ramRegion.valid(i) ; i++)
     {
-        error = read( &m_ramRegion[i] );
+        RAM_REGION ramRegion = m_ramRegion[i];
+
+        error = read( &ramRegion );
 
         if (FAILED(error))
         {
@@ -525,13 +557,36 @@ CRamCheck::check(
 {
     PERROR error = errorSuccess;
 
-    for (int j = 0 ; j < ARRAYSIZE(s_randomSeed) ; j++)
+    //
+    // An empty socket or dead chip reads back the tester's pullups so check
+    // for that first rather than running the full random pass.
+    //
+    {
+        CBusLineCheck busLineCheck( m_cpu,
+                                    m_bankSwitchContext );
+
+        error = busLineCheck.checkRamFloating( ramRegion );
+
+        if (FAILED(error))
+        {
+            return error;
+        }
+    }
+
+    for (int j = 0 ; (j < ARRAYSIZE(s_randomSeed)) && (j < g_depthProfile->ramSeeds) ; j++)
     {
+        if (g_abortRequested)
+        {
+            error = errorAborted;
+            break;
+        }
+
         error = checkRandom( ramRegion,
                              s_randomSeed[j] );
 
         if (FAILED(error))
         {
+            error = checkBusLine( ramRegion, error );
             break;
         }
     }
@@ -582,8 +637,14 @@ CRamCheck::checkRandomAccess(
     // Outer loop to periodically reset the region back to 0 to restart
     // with different seeds for the address & data values.
     //
-    for (UINT8 cycle = 0 ; (cycle < 8) && SUCCESS(error) ; cycle++)
+    for (UINT8 cycle = 0 ; (cycle < g_depthProfile->ramAccessCycles) && SUCCESS(error) ; cycle++)
     {
+        if (g_abortRequested)
+        {
+            error = errorAborted;
+            break;
+        }
+
         //
         // Pass 1 - write/read/verify, random access
         //
@@ -609,7 +670,13 @@ CRamCheck::checkRandomAccess(
             //
             if ((count % (countLength / 4)) == 0)
             {
-                error = m_delayFunction(m_cpu, cycle * 200);
+                if (g_abortRequested)
+                {
+                    error = errorAborted;
+                    break;
+                }
+
+                error = m_delayFunction(m_cpu, ((unsigned long) cycle * 200 * g_depthProfile->ramHoldPercent) / 100);
 
                 if (FAILED(error))
                 {
@@ -687,13 +754,18 @@ CRamCheck::checkRandomAccess(
             }
         }
 
+        if (FAILED(error))
+        {
+            break;
+        }
+
         //
         // Add in a variable delay between cycles.
         // This is to detect a very specific failure mode encountered on TMS4060
         // DRAM used on Space Invaders where the RAM fails a few seconds after the
         // data is written.
         //
-        error = m_delayFunction(m_cpu, cycle * 300);
+        error = m_delayFunction(m_cpu, ((unsigned long) cycle * 300 * g_depthProfile->ramHoldPercent) / 100);
 
         if (FAILED(error))
         {
@@ -843,6 +915,9 @@ CRamCheck::checkAddress(
                 STRING_UINT16_HEX(error->description, (1UL << ((shift - 1) + dataBusWidthAndStepShift)));
             }
 
+            // Narrow it down further to the physical line if possible.
+            error = checkBusLine( ramRegion, error );
+
             break;
         }
     }
@@ -984,3 +1059,107 @@ CRamCheck::readVerifyRandom(
     return error;
 }
 
+
+//
+// The first and last location of a region catch a dead chip, a stuck data
+// line or a missing chip select at either end of the range quickly.
+//
+PERROR
+CRamCheck::checkWalkingBit(
+    const RAM_REGION *ramRegion,
+    UINT32           *cycles
+)
+{
+    PERROR error = errorSuccess;
+
+    //
+    // Check if we need to perform a bank switch for this region.
+    // and do that now for all the testing to be done upon it.
+    //
+
+    if (ramRegion->bankSwitch != NO_BANK_SWITCH)
+    {
+        error = ramRegion->bankSwitch( m_bankSwitchContext );
+    }
+
+    if (SUCCESS(error))
+    {
+        UINT8  dataBusWidth    = m_cpu->dataBusWidth(ramRegion->start);
+        UINT8  dataAccessWidth = m_cpu->dataAccessWidth(ramRegion->start);
+        UINT32 stride          = dataBusWidth * ramRegion->step;
+        UINT32 address[2]      = { ramRegion->start,
+                                   ramRegion->start + (((ramRegion->end - ramRegion->start) / stride) * stride) };
+
+        for (UINT8 cell = 0 ; (cell < 2) && SUCCESS(error) ; cell++)
+        {
+            for (UINT8 bit = 0 ; bit < 16 ; bit++)
+            {
+                UINT16 expData = (1 << bit);
+                UINT16 recData = 0;
+
+                if ((expData & ramRegion->mask) == 0)
+                {
+                    continue;
+                }
+
+                error = m_cpu->memoryWrite(address[cell], expData);
+
+                if (FAILED(error))
+                {
+                    break;
+                }
+
+                error = m_cpu->memoryRead(address[cell], &recData);
+
+                if (FAILED(error))
+                {
+                    break;
+                }
+
+                *cycles += 2;
+
+                recData &= ramRegion->mask;
+
+                if (dataAccessWidth == 1)
+                {
+                    CHECK_VALUE_UINT8_BREAK(error, ramRegion->location, address[cell], expData, recData);
+                }
+                else if (dataAccessWidth == 2)
+                {
+                    CHECK_VALUE_UINT16_BREAK(error, ramRegion->location, address[cell], expData, recData);
+                }
+                else
+                {
+                    error = errorNotImplemented;
+                    break;
+                }
+            }
+        }
+    }
+
+    return error;
+}
+
+
+//
+// Attempt to localise a failure to a single stuck or shorted bus line.
+// The supplied error is returned if no single line explains it.
+//
+PERROR
+CRamCheck::checkBusLine(
+    const RAM_REGION *ramRegion,
+    PERROR           error
+)
+{
+    CBusLineCheck busLineCheck( m_cpu,
+                                m_bankSwitchContext );
+
+    PERROR lineError = busLineCheck.checkRam( ramRegion );
+
+    if (FAILED(lineError))
+    {
+        error = lineError;
+    }
+
+    return error;
+}
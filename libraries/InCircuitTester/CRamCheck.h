@@ -28,6 +28,7 @@
 #include "Arduino.h"
 #include "Types.h"
 #include "ICpu.h"
+#include "CRegionTable.h"
 
 
 class CRamCheck
@@ -37,9 +38,9 @@ class CRamCheck
         CRamCheck(
             ICpu  *cpu,
             const DelayFunctionCallback delayFunction,
-            const RAM_REGION ramRegion[],
-            const RAM_REGION ramRegionByteOnly[],
-            const RAM_REGION ramRegionWriteOnly[],
+            const CRegionTable<RAM_REGION> &ramRegion,
+            const CRegionTable<RAM_REGION> &ramRegionByteOnly,
+            const CRegionTable<RAM_REGION> &ramRegionWriteOnly,
             void *bankSwitchContext
         );
 
@@ -110,6 +111,16 @@ class CRamCheck
             const RAM_REGION *ramRegion
         );
 
+        //
+        // Walk a bit through the first and last locations of the region,
+        // adding the bus cycles used to the count.
+        //
+        PERROR
+        checkWalkingBit(
+            const RAM_REGION *ramRegion,
+            UINT32           *cycles
+        );
+
         PERROR
         writeRandom(
             const RAM_REGION *ramRegion,
@@ -124,14 +135,22 @@ class CRamCheck
             bool  invert
         );
 
+    private:
+
+        PERROR
+        checkBusLine(
+            const RAM_REGION *ramRegion,
+            PERROR           error
+        );
+
     private:
 
         ICpu                        *m_cpu;
         const DelayFunctionCallback  m_delayFunction;
 
-        const RAM_REGION            *m_ramRegion;
-        const RAM_REGION            *m_ramRegionByteOnly;
-        const RAM_REGION            *m_ramRegionWriteOnly;
+        CRegionTable<RAM_REGION>     m_ramRegion;
+        CRegionTable<RAM_REGION>     m_ramRegionByteOnly;
+        CRegionTable<RAM_REGION>     m_ramRegionWriteOnly;
         void                        *m_bankSwitchContext;
 };
 
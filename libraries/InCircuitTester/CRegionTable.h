@@ -0,0 +1,151 @@
+//
+// Copyright (c) 2021, Paul R. Swan
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+// OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR
+// TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+// EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+#ifndef CRegionTable_h
+#define CRegionTable_h
+
+#include "Arduino.h"
+#include "Types.h"
+#include <avr/pgmspace.h>
+
+//
+// The region tables are large and kept in PROGMEM. Rather than copying a
+// whole table into SRAM this is a view of the table that copies out one
+// entry at a time on demand. An address offset can be added to the view to
+// move the whole address space of a table (e.g. Hustler on Scramble).
+//
+
+//
+// End of list detection for each region type, read from PROGMEM.
+//
+inline bool regionEndOfList(const ROM_REGION *region)      { return (pgm_read_dword_near(&region->length) == 0); }
+inline bool regionEndOfList(const RAM_REGION *region)      { return (pgm_read_dword_near(&region->end) == 0); }
+inline bool regionEndOfList(const INPUT_REGION *region)    { return (pgm_read_word_near(&region->mask) == 0); }
+inline bool regionEndOfList(const OUTPUT_REGION *region)   { return (pgm_read_word_near(&region->activeMask) == 0); }
+inline bool regionEndOfList(const CUSTOM_FUNCTION *region) { return (pgm_read_ptr_near(&region->function) == NULL); }
+
+//
+// Address offset for each region type. ROM regions and custom functions don't move.
+//
+inline void regionAddAddressOffset(ROM_REGION *region, UINT32 offset)      {}
+inline void regionAddAddressOffset(RAM_REGION *region, UINT32 offset)      { region->start += offset; region->end += offset; }
+inline void regionAddAddressOffset(INPUT_REGION *region, UINT32 offset)    { region->address += offset; }
+inline void regionAddAddressOffset(OUTPUT_REGION *region, UINT32 offset)   { region->address += offset; }
+inline void regionAddAddressOffset(CUSTOM_FUNCTION *region, UINT32 offset) {}
+
+
+template <class T>
+class CRegionTable
+{
+    public:
+
+        CRegionTable(
+            const T *table = NULL
+        ) : m_table(table),
+            m_addressOffset(0)
+        {
+        };
+
+        //
+        // True if the index is before the end of list entry.
+        //
+        bool
+        valid(
+            int index
+        ) const
+        {
+            return ((m_table != NULL) && !regionEndOfList(&m_table[index]));
+        };
+
+        //
+        // A copy of the entry at the index with any address offset applied.
+        //
+        T
+        operator[](
+            int index
+        ) const
+        {
+            T region;
+
+            memcpy_P(&region, &m_table[index], sizeof(region));
+
+            if (m_addressOffset != 0)
+            {
+                regionAddAddressOffset(&region, m_addressOffset);
+            }
+
+            return region;
+        };
+
+        void
+        addAddressOffset(
+            UINT32 offset
+        )
+        {
+            m_addressOffset += offset;
+        };
+
+    private:
+
+        const T *m_table;
+        UINT32   m_addressOffset;
+
+};
+
+
+//
+// The ROM region table also supplies the data2n samples of its regions.
+// These are in PROGMEM when the game supplied a ROM_DATA2N table and
+// in SRAM for games using the legacy constructor.
+//
+class CRomRegionTable : public CRegionTable<ROM_REGION>
+{
+    public:
+
+        CRomRegionTable(
+            const ROM_REGION *table = NULL,
+            bool data2nProgMem = false
+        ) : CRegionTable<ROM_REGION>(table),
+            m_data2nProgMem(data2nProgMem)
+        {
+        };
+
+        UINT16
+        data2n(
+            const ROM_REGION *region,
+            UINT32 shift
+        ) const
+        {
+            return m_data2nProgMem ? pgm_read_word_near(&region->data2n[shift]) :
+                                     region->data2n[shift];
+        };
+
+    private:
+
+        bool m_data2nProgMem;
+
+};
+
+#endif
+
@@ -0,0 +1,448 @@
+//
+// Copyright (c) 2021, Paul R. Swan
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+// OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR
+// TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+// EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+#include "CRemote.h"
+#include "CGameCallback.h"
+#include "CEventStream.h"
+#include "SerialPort.h"
+#include <DFR_Key.h>
+
+//
+// The most arguments of a command and values of a reply.
+//
+static const UINT8 s_maxArguments = 4;
+static const UINT8 s_maxValues    = 16;
+
+//
+// The serial receive buffer size of the Arduino core. If it fills while a
+// packet runs characters may have been lost.
+//
+#ifndef SERIAL_RX_BUFFER_SIZE
+#define SERIAL_RX_BUFFER_SIZE 64
+#endif
+
+bool                     CRemote::s_enabled;
+RemoteSelectGameCallback CRemote::s_selectGame;
+
+CHAR                     CRemote::s_packet[128];
+UINT8                    CRemote::s_length;
+bool                     CRemote::s_overrun;
+
+
+//
+// The number of arguments a command requires, T's key being optional.
+//
+static
+UINT8
+requiredArguments(
+    CHAR command
+)
+{
+    switch (command)
+    {
+        case 'W' : { return 2; }
+        case 'D' : { return 2; }
+        case 'F' : { return 3; }
+        case 'V' : { return 3; }
+        default  : { return 1; }
+    }
+}
+
+
+void
+CRemote::enable(
+    bool                     enable,
+    RemoteSelectGameCallback selectGame
+)
+{
+    s_enabled    = enable;
+    s_selectGame = selectGame;
+    s_length     = 0;
+    s_overrun    = false;
+
+    if (s_enabled)
+    {
+        ensureSerial();
+    }
+}
+
+
+bool
+CRemote::enabled(
+)
+{
+    return s_enabled;
+}
+
+
+void
+CRemote::poll(
+)
+{
+    if (!s_enabled)
+    {
+        return;
+    }
+
+    while (Serial.available() > 0)
+    {
+        CHAR c = (CHAR) Serial.read();
+
+        if ((c != '\n') && (c != '\r'))
+        {
+            if (s_length < (sizeof(s_packet) - 1))
+            {
+                s_packet[s_length++] = c;
+            }
+            else
+            {
+                s_overrun = true;
+            }
+
+            continue;
+        }
+
+        if ((s_length == 0) && !s_overrun)
+        {
+            continue;
+        }
+
+        s_packet[s_length] = '\0';
+        s_length = 0;
+
+        //
+        // A packet that's been cut short isn't run as garbage.
+        //
+        if (s_overrun)
+        {
+            PERROR error = errorCustom;
+
+            error->code = ERROR_FAILED;
+            error->description = "E:Overrun";
+
+            reply(0, error, NULL, 0, 0);
+            Serial.println(".");
+
+            s_overrun = false;
+            continue;
+        }
+
+        //
+        // Split the packet at each ';' and run the commands in turn.
+        //
+        {
+            CHAR  *command = s_packet;
+            UINT8 index = 0;
+
+            g_abortRequested = false;
+
+            while (command != NULL)
+            {
+                CHAR *next = strchr(command, ';');
+
+                if (next != NULL)
+                {
+                    *next++ = '\0';
+                }
+
+                while (*command == ' ')
+                {
+                    command++;
+                }
+
+                if (*command != '\0')
+                {
+                    execute(command, index++);
+                }
+
+                command = next;
+            }
+
+            //
+            // If the receive buffer filled while the packet ran, the next
+            // packet may have lost characters.
+            //
+            if (Serial.available() >= (SERIAL_RX_BUFFER_SIZE - 1))
+            {
+                s_overrun = true;
+            }
+
+            Serial.println(".");
+        }
+    }
+}
+
+
+void
+CRemote::execute(
+    PCSTR command,
+    UINT8 index
+)
+{
+    PERROR error = errorSuccess;
+    UINT32 argument[s_maxArguments] = {0};
+    UINT8  arguments = 0;
+    UINT32 values[s_maxValues] = {0};
+    UINT8  numValues = 0;
+    UINT8  digits = 2;
+    IGame  *game = CGameCallback::game;
+    CHAR   *next = (CHAR *) &command[1];
+
+    while (arguments < s_maxArguments)
+    {
+        CHAR *end;
+
+        argument[arguments] = strtoul(next, &end, 16);
+
+        if (end == next)
+        {
+            break;
+        }
+
+        next = end;
+        arguments++;
+    }
+
+    while (*next == ' ')
+    {
+        next++;
+    }
+
+    if ((strchr("GTCRWFVD", command[0]) != NULL) &&
+        ((arguments < requiredArguments(command[0])) || (*next != '\0')))
+    {
+        error = errorCustom;
+        error->code = ERROR_FAILED;
+        error->description = "E:Syntax";
+    }
+    else if ((game == NULL) && (strchr("TCRWFVD", command[0]) != NULL))
+    {
+        error = errorCustom;
+        error->code = ERROR_FAILED;
+        error->description = "E:No game";
+    }
+    else
+    {
+        switch (command[0])
+        {
+            case 'G' :
+            {
+                error = s_selectGame(argument[0]);
+                break;
+            }
+
+            case 'T' :
+            {
+                const SELECTOR *selector = CGameCallback::selectorGame;
+                UINT32 selection = 0;
+
+                while ((selection < argument[0]) && (selector[selection].function != NULL))
+                {
+                    selection++;
+                }
+
+                if (selector[selection].function == NULL)
+                {
+                    error = errorNotImplemented;
+                    break;
+                }
+
+                {
+                    UINT32 startTime = millis();
+
+                    CEventStream::testStart(selector[selection].description);
+
+                    error = selector[selection].function(selector[selection].context,
+                                                          (arguments > 1) ? (int) argument[1] : SELECT_KEY);
+
+                    CEventStream::testEnd(selector[selection].description, error, millis() - startTime);
+                }
+                break;
+            }
+
+            case 'C' :
+            {
+                error = game->customIndex((int) argument[0]);
+                break;
+            }
+
+            case 'R' :
+            case 'W' :
+            {
+                ICpu *cpu = game->cpu();
+                UINT16 data = (UINT16) argument[1];
+
+                digits = cpu->dataAccessWidth(argument[0]) * 2;
+
+                if (command[0] == 'W')
+                {
+                    error = cpu->memoryWrite(argument[0], data);
+                }
+                else
+                {
+                    error = cpu->memoryRead(argument[0], &data);
+
+                    if (SUCCESS(error))
+                    {
+                        values[numValues++] = data;
+                    }
+                }
+                break;
+            }
+
+            case 'F' :
+            case 'V' :
+            case 'D' :
+            {
+                digits = game->cpu()->dataAccessWidth(argument[0]) * 2;
+
+                error = block(command[0],
+                              argument[0],
+                              argument[1],
+                              (UINT16) argument[2],
+                              values,
+                              &numValues);
+                break;
+            }
+
+            default :
+            {
+                error = errorNotImplemented;
+                break;
+            }
+        }
+    }
+
+    //
+    // Reply with the values, or the description if there are none. Only a
+    // failed verify has values, the address and the expected & received.
+    //
+    if (FAILED(error) && (command[0] != 'V'))
+    {
+        numValues = 0;
+    }
+
+    reply(index, error, values, numValues, digits);
+}
+
+
+void
+CRemote::reply(
+    UINT8        index,
+    PERROR       error,
+    const UINT32 *values,
+    UINT8        numValues,
+    UINT8        digits
+)
+{
+    Serial.print(index, HEX);
+    Serial.print(' ');
+    Serial.print(error->code, HEX);
+
+    if (numValues == 0)
+    {
+        Serial.print(' ');
+        Serial.println((PCSTR) error->description);
+    }
+    else
+    {
+        for (UINT8 i = 0 ; i < numValues ; i++)
+        {
+            CHAR formatted[10];
+
+            Serial.print(formatHex(formatted,
+                                   values[i],
+                                   (FAILED(error) && (i == 0)) ? 6 : digits));
+        }
+
+        Serial.println();
+    }
+}
+
+
+//
+// The block operations step by the data bus width as the RAM checks do.
+//
+PERROR
+CRemote::block(
+    CHAR   command,
+    UINT32 address,
+    UINT32 count,
+    UINT16 data,
+    UINT32 *values,
+    UINT8  *numValues
+)
+{
+    PERROR error = errorSuccess;
+    ICpu   *cpu = CGameCallback::game->cpu();
+    UINT8  stride = cpu->dataBusWidth(address);
+
+    if ((command == 'D') && (count > s_maxValues))
+    {
+        count = s_maxValues;
+    }
+
+    for (UINT32 i = 0 ; (i < count) && !g_abortRequested ; i++, address += stride)
+    {
+        UINT16 recData = 0;
+
+        if (command == 'F')
+        {
+            error = cpu->memoryWrite(address, data);
+        }
+        else
+        {
+            error = cpu->memoryRead(address, &recData);
+        }
+
+        if (FAILED(error))
+        {
+            break;
+        }
+
+        if (command == 'D')
+        {
+            values[(*numValues)++] = recData;
+        }
+
+        if ((command == 'V') && (recData != data))
+        {
+            error = errorCustom;
+            error->code = ERROR_FAILED;
+            error->description = "E:Verify";
+
+            values[(*numValues)++] = address;
+            values[(*numValues)++] = data;
+            values[(*numValues)++] = recData;
+            break;
+        }
+    }
+
+    if (SUCCESS(error) && g_abortRequested)
+    {
+        error = errorAborted;
+    }
+
+    return error;
+}
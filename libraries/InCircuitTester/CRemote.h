@@ -0,0 +1,142 @@
+//
+// Copyright (c) 2021, Paul R. Swan
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+// OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR
+// TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+// EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+#ifndef CRemote_h
+#define CRemote_h
+
+#include "Arduino.h"
+#include "Types.h"
+#include "Error.h"
+#include "IGame.h"
+
+//
+// This is used as the callback to select game n of the game list. It's
+// supplied by the main loop so its menus follow a remote game selection.
+//
+typedef PERROR (*RemoteSelectGameCallback)(UINT32 game);
+
+//
+// Remote control of the tester over serial for running scripted tests.
+//
+// A packet is a line of commands separated by ';'. The whole packet is run
+// before the next is read so the bus accesses of a packet aren't held up
+// by the serial port, with a reply line sent as each command completes and
+// a "." line at the end of the packet.
+//
+// The "." line is the flow control. A host must wait for it before sending
+// the next packet since only the serial receive buffer (63 characters)
+// holds what's sent while a packet runs. A packet that's longer than 127
+// characters, or that may have lost characters because the receive buffer
+// filled, isn't run and replies "0 1 E:Overrun" and ".".
+//
+// Arguments are hex and all but T's key are required. A command with
+// missing or unparsable arguments replies "E:Syntax".
+//
+//   G n          - select game n of the game list.
+//   T n [k]      - run selection n of the game's selector with key k
+//                  (default SELECT, UP=3, DOWN=4 step a sub menu).
+//   C n          - run custom function n of the game.
+//   R a          - read address a.
+//   W a d        - write d to address a.
+//   F a n d      - fill n locations from address a with d.
+//   V a n d      - verify n locations from address a read d.
+//   D a n        - read n (up to 16) locations from address a.
+//
+// Replies are the command index in the packet, the error code and either
+// the values read or the error description, e.g.
+//
+//   "R 4000;D 4000 4;T 2"  ->  "0 0 3e"
+//                              "1 0 3e 00 c3 11"
+//                              "2 0 OK:Cyc 1234"
+//                              "."
+//
+// A failed verify replies with the address, expected & received values.
+//
+// tools/ictremote.py runs a bench script of these commands from a host.
+//
+// This is a static class.
+//
+class CRemote
+{
+    public:
+
+        //
+        // Turn the remote control on or off. The callback is used to select
+        // a game.
+        //
+        static void
+        enable(
+            bool                     enable,
+            RemoteSelectGameCallback selectGame
+        );
+
+        static bool
+        enabled(
+        );
+
+        //
+        // Read any received characters and run a packet when complete.
+        //
+        static void
+        poll(
+        );
+
+    private:
+
+        static void
+        execute(
+            PCSTR command,
+            UINT8 index
+        );
+
+        static void
+        reply(
+            UINT8        index,
+            PERROR       error,
+            const UINT32 *values,
+            UINT8        numValues,
+            UINT8        digits
+        );
+
+        static PERROR
+        block(
+            CHAR   command,
+            UINT32 address,
+            UINT32 count,
+            UINT16 data,
+            UINT32 *values,
+            UINT8  *numValues
+        );
+
+    private:
+
+        static bool                     s_enabled;
+        static RemoteSelectGameCallback s_selectGame;
+
+        static CHAR                     s_packet[128];
+        static UINT8                    s_length;
+        static bool                     s_overrun;
+};
+
+#endif
@@ -23,12 +23,13 @@
 // EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 //
 #include "CRomCheck.h"
+#include "CBusLineCheck.h"
 #include "zutil.h"
 
 
 CRomCheck::CRomCheck(
     ICpu *cpu,
-    const ROM_REGION romRegion[],
+    const CRomRegionTable &romRegion,
     void *bankSwitchContext
 ) : m_cpu(cpu),
     m_romRegion(romRegion),
@@ -46,9 +47,17 @@ CRomCheck::check(
 {
     PERROR error = errorSuccess;
 
-    for (int index = 0 ; m_romRegion[index].length != 0 ; index++)
+    for (int index = 0 ; m_romRegion.valid(index) ; index++)
     {
-        error = check( &m_romRegion[index] );
+        ROM_REGION romRegion = m_romRegion[index];
+
+        if (g_abortRequested)
+        {
+            error = errorAborted;
+            break;
+        }
+
+        error = check( &romRegion );
 
         if (FAILED(error))
         {
@@ -69,9 +78,17 @@ CRomCheck::read(
 {
     PERROR error = errorSuccess;
 
-    for (int index = 0 ; m_romRegion[index].length != 0 ; index++)
+    for (int index = 0 ; m_romRegion.valid(index) ; index++)
     {
-        error = read( &m_romRegion[index] );
+        ROM_REGION romRegion = m_romRegion[index];
+
+        if (g_abortRequested)
+        {
+            error = errorAborted;
+            break;
+        }
+
+        error = read( &romRegion );
 
         if (FAILED(error))
         {
@@ -112,7 +129,7 @@ CRomCheck::checkData2n(
         for (UINT32 shift = 0 ; (1UL << shift) < romRegion->length ; shift++)
         {
             UINT32 address = romRegion->start + (1UL << (shift + dataBusWidthShift));
-            UINT16 expData = romRegion->data2n[shift];
+            UINT16 expData = m_romRegion.data2n(romRegion, shift);
             UINT16 recData = 0;
 
             error = m_cpu->memoryRead(address, &recData);
@@ -176,6 +193,15 @@ CRomCheck::calculateCrc(
              address < (romRegion->start + (romRegion->length * dataBusWidth));
              address += dataBusWidth)
         {
+            //
+            // Check for an abort at every 1KB block.
+            //
+            if (((address & 0x3FF) == 0) && g_abortRequested)
+            {
+                error = errorAborted;
+                break;
+            }
+
             error = m_cpu->memoryRead(address, &data);
 
             if (FAILED(error))
@@ -364,7 +390,42 @@ CRomCheck::check(
     const ROM_REGION *romRegion
 )
 {
-    PERROR error = checkData2n( romRegion );
+    PERROR error = errorSuccess;
+
+    //
+    // An empty socket or dead chip reads back the tester's pullups so check
+    // for that first rather than reporting it as a data or CRC mismatch.
+    //
+    {
+        CBusLineCheck busLineCheck( m_cpu,
+                                    m_bankSwitchContext );
+
+        error = busLineCheck.checkRomFloating( romRegion );
+
+        if (FAILED(error))
+        {
+            return error;
+        }
+    }
+
+    error = checkData2n( romRegion );
+
+    //
+    // If the data2n check failed see if it can be narrowed down
+    // to a single stuck or shorted bus line.
+    //
+    if (FAILED(error))
+    {
+        CBusLineCheck busLineCheck( m_cpu,
+                                    m_bankSwitchContext );
+
+        PERROR lineError = busLineCheck.checkRom( m_romRegion, romRegion );
+
+        if (FAILED(lineError))
+        {
+            error = lineError;
+        }
+    }
 
     if (SUCCESS(error))
     {
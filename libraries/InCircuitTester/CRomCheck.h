@@ -28,6 +28,7 @@
 #include "Arduino.h"
 #include "Types.h"
 #include "ICpu.h"
+#include "CRegionTable.h"
 
 
 class CRomCheck
@@ -36,7 +37,7 @@ class CRomCheck
 
         CRomCheck(
             ICpu *cpu,
-            const ROM_REGION romRegion[],
+            const CRomRegionTable &romRegion,
             void *bankSwitchContext
         );
 
@@ -90,7 +91,7 @@ class CRomCheck
    private:
 
         ICpu             *m_cpu;
-        const ROM_REGION *m_romRegion;
+        CRomRegionTable   m_romRegion;
         void             *m_bankSwitchContext;
 
 };
@@ -0,0 +1,146 @@
+//
+// Copyright (c) 2021, Paul R. Swan
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+// OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR
+// TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+// EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+#include "CSignature.h"
+#include "PinMap.h"
+
+//
+// The HP 5004A display alphabet, chosen to avoid B & D that look like 8 & 0
+// on a 7-segment display.
+//
+static const char s_alphabet[] = "0123456789ACFHPU";
+
+
+CSignature::CSignature(
+) : m_head(0),
+    m_gateMask(0),
+    m_gateActive(0),
+    m_last(0),
+    m_state(WINDOW_OPEN),
+    m_clocks(0)
+{
+    memset(m_reg, 0, sizeof(m_reg));
+}
+
+
+void
+CSignature::begin(
+    UINT8 inputMask,
+    UINT8 gateChannel,
+    bool  gateRising
+)
+{
+    for (UINT8 channel = 0 ; channel < 8 ; channel++)
+    {
+        if (inputMask & (1 << channel))
+        {
+            ::pinMode(g_pinMap8Aux[channel + 1], INPUT);
+        }
+    }
+
+    memset(m_reg, 0, sizeof(m_reg));
+
+    m_head   = 0;
+    m_clocks = 0;
+
+    if (gateChannel == 0)
+    {
+        m_gateMask   = 0;
+        m_gateActive = 0;
+        m_state      = WINDOW_OPEN;
+    }
+    else
+    {
+        m_gateMask   = 1 << (gateChannel - 1);
+        m_gateActive = gateRising ? m_gateMask : 0;
+        m_state      = WINDOW_WAITING;
+    }
+
+    m_last = PINK;
+}
+
+
+UINT16
+CSignature::signature(
+    UINT8 channel
+)
+{
+    UINT8  mask = 1 << (channel - 1);
+    UINT16 signature = 0;
+
+    for (UINT8 bit = 0 ; bit < 16 ; bit++)
+    {
+        if (m_reg[(m_head - bit) & 0x0F] & mask)
+        {
+            signature |= (1 << bit);
+        }
+    }
+
+    return signature;
+}
+
+
+PERROR
+CSignature::result(
+    UINT8 channel
+)
+{
+    PERROR error = errorCustom;
+
+    if (m_state == WINDOW_WAITING)
+    {
+        error->code = ERROR_FAILED;
+        error->description = "E:No Start";
+    }
+    else if ((m_state == WINDOW_OPEN) && (m_gateMask != 0))
+    {
+        error->code = ERROR_FAILED;
+        error->description = "E:No Stop";
+    }
+    else
+    {
+        error->code = ERROR_SUCCESS;
+        error->description = "OK:";
+        error->description += channel;
+        error->description += " ";
+        appendSignature(error->description, signature(channel));
+        error->description += " ";
+        error->description += m_clocks;
+    }
+
+    return error;
+}
+
+
+void
+CSignature::appendSignature(
+    CDescription &string,
+    UINT16       signature
+)
+{
+    for (INT8 shift = 12 ; shift >= 0 ; shift -= 4)
+    {
+        string += s_alphabet[(signature >> shift) & 0x0F];
+    }
+}
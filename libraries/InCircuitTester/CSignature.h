@@ -0,0 +1,166 @@
+//
+// Copyright (c) 2021, Paul R. Swan
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+// OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR
+// TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+// EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+#ifndef CSignature_h
+#define CSignature_h
+
+#include "Arduino.h"
+#include "Types.h"
+#include "Error.h"
+#include "ISampler.h"
+
+//
+// HP 5004A style signature analyser on the 8 J14 aux pins.
+//
+// Each aux pin is folded into its own 16-bit LFSR (feedback taps 7, 9, 12 & 16)
+// on every clock while the window is open, giving the signatures published in
+// service manuals for test nodes. The 8 registers are held bit sliced, i.e. byte
+// n holds bit n of every channel's register, so a single PINK read and 4 XORs
+// advance all 8 signatures at once.
+//
+// The window is either every clock while attached or, with a gate channel, from
+// one active edge of the gate to the next (the common HP setup of START & STOP
+// on the same signal).
+//
+// Signatures are displayed using the 0-9ACFHPU alphabet.
+//
+// 0123456789abcdef
+// OK:1 HP7C 4096     - AUX1 signature HP7C over a 4096 clock window.
+// E:No Start         - The gate channel didn't produce a start edge.
+// E:No Stop          - The gate channel didn't produce a stop edge.
+//
+class CSignature : public ISampler
+{
+    public:
+
+        CSignature(
+        );
+
+        //
+        // Clear the signatures and set the window. Channels in inputMask
+        // (bit 0 is AUX1) are set to INPUT. A gateChannel of 0 opens the
+        // window immediately, otherwise it's the aux pin (1 -> 8) used for
+        // the start & stop edges.
+        //
+        void
+        begin(
+            UINT8 inputMask,
+            UINT8 gateChannel,
+            bool  gateRising
+        );
+
+        //
+        // ISampler Interface
+        //
+        virtual
+        void
+        sample(
+        )
+        {
+            UINT8 value = PINK;
+
+            if (m_gateMask != 0)
+            {
+                UINT8 gate = value & m_gateMask;
+
+                if ((gate != (m_last & m_gateMask)) &&
+                    (gate == m_gateActive)             &&
+                    (m_state != WINDOW_CLOSED))
+                {
+                    m_state++;
+                }
+
+                m_last = value;
+            }
+
+            if (m_state == WINDOW_OPEN)
+            {
+                UINT8 head = m_head;
+                UINT8 feedback = value                     ^
+                                 m_reg[(head -  6) & 0x0F] ^
+                                 m_reg[(head -  8) & 0x0F] ^
+                                 m_reg[(head - 11) & 0x0F] ^
+                                 m_reg[(head + 1)  & 0x0F];
+
+                m_head = (head + 1) & 0x0F;
+                m_reg[m_head] = feedback;
+
+                m_clocks++;
+            }
+        };
+
+        //
+        // True once the stop edge has closed the window.
+        //
+        bool
+        done(
+        )
+        {
+            return (m_state > WINDOW_OPEN);
+        };
+
+        UINT16
+        signature(
+            UINT8 channel
+        );
+
+        //
+        // The window result and signature of the aux pin (1 -> 8) for the LCD.
+        //
+        PERROR
+        result(
+            UINT8 channel
+        );
+
+        //
+        // Append the 4 character signature to the string.
+        //
+        static
+        void
+        appendSignature(
+            CDescription &string,
+            UINT16       signature
+        );
+
+    private:
+
+        enum {
+            WINDOW_WAITING = 0,
+            WINDOW_OPEN    = 1,
+            WINDOW_CLOSED  = 2
+        };
+
+        UINT8  m_reg[16];
+        UINT8  m_head;
+
+        UINT8  m_gateMask;
+        UINT8  m_gateActive;
+        UINT8  m_last;
+        UINT8  m_state;
+
+        UINT32 m_clocks;
+
+};
+
+#endif
@@ -0,0 +1,216 @@
+//
+// Copyright (c) 2021, Paul R. Swan
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+// OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR
+// TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+// EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+#include "CSoakScheduler.h"
+
+//
+// A selection is forced once it has waited this many rounds.
+//
+static const UINT8 s_maxWaitRounds = 4;
+
+//
+// The weight of a selection is this divided by its average duration so the
+// cheapest (~1ms) fit comfortably in 32 bits when scaled by failures.
+//
+static const UINT32 s_weightScale = 1000000UL;
+
+//
+// Failures add to the score and each pass decays it by a quarter. The weight
+// is scaled by (1 + score / s_failureDivisor) so a failing selection is run
+// up to 8x more often.
+//
+static const UINT8 s_failureStep    = 64;
+static const UINT8 s_failureDivisor = 32;
+
+
+CSoakScheduler::CSoakScheduler(
+    UINT8  numSelections,
+    bool   interleave,
+    UINT32 seed
+) : m_numSelections((numSelections < s_maxSelections) ? numSelections : s_maxSelections),
+    m_interleave(interleave && (numSelections > 1)),
+    m_random((seed != 0) ? seed : 1),
+    m_picks(0),
+    m_last(0)
+{
+    for (UINT8 selection = 0 ; selection < s_maxSelections ; selection++)
+    {
+        m_averageMs[selection]    = 0;
+        m_lastPick[selection]     = 0;
+        m_failureScore[selection] = 0;
+        m_timed[selection]        = false;
+        m_excluded[selection]     = false;
+    }
+}
+
+
+UINT8
+CSoakScheduler::next(
+)
+{
+    UINT16 maxWait = (UINT16) s_maxWaitRounds * m_numSelections;
+    UINT8  chosen  = m_numSelections;
+
+    //
+    // Untimed selections first, then any that have waited too long (the
+    // longest waiting first).
+    //
+    for (UINT8 selection = 0 ; selection < m_numSelections ; selection++)
+    {
+        if (m_excluded[selection])
+        {
+            continue;
+        }
+
+        if (!m_timed[selection])
+        {
+            chosen = selection;
+            break;
+        }
+
+        if (((UINT16) (m_picks - m_lastPick[selection]) >= maxWait) &&
+            ((chosen == m_numSelections) ||
+             ((UINT16) (m_picks - m_lastPick[selection]) > (UINT16) (m_picks - m_lastPick[chosen]))))
+        {
+            chosen = selection;
+        }
+    }
+
+    //
+    // Otherwise a weighted random choice.
+    //
+    if (chosen == m_numSelections)
+    {
+        UINT32 total = 0;
+
+        for (UINT8 selection = 0 ; selection < m_numSelections ; selection++)
+        {
+            total += weight(selection);
+        }
+
+        //
+        // Only the last selection is left when interleaving, so run it again.
+        //
+        if (total == 0)
+        {
+            chosen = m_last;
+        }
+        else
+        {
+            UINT32 pick = random(total);
+
+            for (chosen = 0 ; chosen < (m_numSelections - 1) ; chosen++)
+            {
+                UINT32 w = weight(chosen);
+
+                if (pick < w)
+                {
+                    break;
+                }
+
+                pick -= w;
+            }
+        }
+    }
+
+    m_lastPick[chosen] = m_picks++;
+    m_last = chosen;
+
+    return chosen;
+}
+
+
+void
+CSoakScheduler::record(
+    UINT32 durationMs,
+    bool   failed
+)
+{
+    UINT8 selection = m_last;
+
+    //
+    // Exponential average over ~4 runs.
+    //
+    if (!m_timed[selection])
+    {
+        m_averageMs[selection] = durationMs;
+        m_timed[selection]     = true;
+    }
+    else
+    {
+        m_averageMs[selection] = m_averageMs[selection] - (m_averageMs[selection] / 4) + (durationMs / 4);
+    }
+
+    if (failed)
+    {
+        m_failureScore[selection] = (m_failureScore[selection] > (255 - s_failureStep)) ?
+                                    255 : (m_failureScore[selection] + s_failureStep);
+    }
+    else
+    {
+        m_failureScore[selection] -= m_failureScore[selection] / 4;
+    }
+}
+
+
+void
+CSoakScheduler::exclude(
+)
+{
+    m_excluded[m_last] = true;
+}
+
+
+//
+// xorshift32
+//
+UINT32
+CSoakScheduler::random(
+    UINT32 range
+)
+{
+    m_random ^= m_random << 13;
+    m_random ^= m_random >> 17;
+    m_random ^= m_random << 5;
+
+    return (range == 0) ? 0 : (m_random % range);
+}
+
+
+UINT32
+CSoakScheduler::weight(
+    UINT8 selection
+)
+{
+    if (m_excluded[selection] ||
+        (m_interleave && (selection == m_last) && (m_picks != 0)))
+    {
+        return 0;
+    }
+
+    UINT32 weight = (s_weightScale / (m_averageMs[selection] + 1)) + 1;
+
+    return weight + ((weight / s_failureDivisor) * m_failureScore[selection]);
+}
+
@@ -0,0 +1,110 @@
+//
+// Copyright (c) 2021, Paul R. Swan
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+// OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR
+// TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+// EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+#ifndef CSoakScheduler_h
+#define CSoakScheduler_h
+
+#include "Arduino.h"
+#include "Types.h"
+
+//
+// Chooses the next selection for the soak test.
+//
+// Each selection is weighted by the inverse of its recent duration, so
+// every selection gets a similar share of the soak time rather than the
+// same number of runs, and scaled up by its recent failures so that a
+// marginal chip is hit more often. Any selection that hasn't run in
+// s_maxWaitRounds rounds (of as many picks as selections) is run next, so
+// none can starve. Selections that haven't been timed yet are run first
+// and those the game doesn't implement are excluded.
+//
+// When interleaved, the last selection isn't picked again straight away so
+// consecutive runs exercise different chips.
+//
+// The scheduler has its own random number generator because the tests
+// reseed the Arduino one.
+//
+class CSoakScheduler
+{
+    public:
+
+        static const UINT8 s_maxSelections = 8;
+
+        CSoakScheduler(
+            UINT8  numSelections,
+            bool   interleave,
+            UINT32 seed
+        );
+
+        UINT8
+        next(
+        );
+
+        //
+        // The result of a run of the selection last returned by next().
+        //
+        void
+        record(
+            UINT32 durationMs,
+            bool   failed
+        );
+
+        //
+        // The selection last returned by next() isn't implemented by the
+        // game, so it isn't picked again.
+        //
+        void
+        exclude(
+        );
+
+    private:
+
+        UINT32
+        random(
+            UINT32 range
+        );
+
+        UINT32
+        weight(
+            UINT8 selection
+        );
+
+    private:
+
+        UINT8  m_numSelections;
+        bool   m_interleave;
+        UINT32 m_random;
+
+        UINT16 m_picks;
+        UINT8  m_last;
+
+        UINT32 m_averageMs[s_maxSelections];
+        UINT16 m_lastPick[s_maxSelections];
+        UINT8  m_failureScore[s_maxSelections];
+        bool   m_timed[s_maxSelections];
+        bool   m_excluded[s_maxSelections];
+
+};
+
+#endif
@@ -0,0 +1,402 @@
+//
+// Copyright (c) 2021, Paul R. Swan
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+// OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR
+// TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+// EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+#include "CSoakStats.h"
+#include "SerialPort.h"
+#include <EEPROM.h>
+#include "zutil.h"
+
+//
+// The part of the EEPROM used for the snapshot slots.
+//
+static const UINT16 s_eepromBase   = 0;
+static const UINT16 s_eepromLength = 2048;
+
+//
+// Marks a slot as holding a snapshot ("SK").
+//
+static const UINT16 s_slotMagic = 0x534B;
+
+//
+// How often a snapshot is saved unless forced.
+//
+static const UINT32 s_saveIntervalMs = 60000;
+
+//
+// The size of a slot, header + statistics + CRC.
+//
+#define SLOT_SIZE (sizeof(SLOT_HEADER) + sizeof(m_stats) + sizeof(UINT32))
+
+
+CSoakStats::CSoakStats(
+) : m_game(s_noGame),
+    m_sequence(0),
+    m_slot(0),
+    m_lastSaveTime(0),
+    m_dirty(false),
+    m_firstFailure(false)
+{
+    memset(m_stats, 0, sizeof(m_stats));
+}
+
+
+//
+// The ring position comes from the newest snapshot of any game so saving
+// carries on after it, the statistics from the newest one of this game.
+//
+void
+CSoakStats::load(
+    UINT16 game
+)
+{
+    bool   found = false;
+    bool   foundGame = false;
+    UINT16 gameSequence = 0;
+    UINT16 gameSlot = 0;
+
+    memset(m_stats, 0, sizeof(m_stats));
+
+    for (UINT16 slot = 0 ; slot < slotCount() ; slot++)
+    {
+        SLOT_HEADER header;
+        UINT32      crc;
+
+        EEPROM.get(slotAddress(slot), header);
+        EEPROM.get(slotAddress(slot) + SLOT_SIZE - sizeof(crc), crc);
+
+        if ((header.magic != s_slotMagic) ||
+            (crc != slotCrc(slot)))
+        {
+            continue;
+        }
+
+        //
+        // The sequence wraps so the newest is the one ahead of the rest.
+        //
+        if (!found || ((INT16) (header.sequence - m_sequence) > 0))
+        {
+            found      = true;
+            m_sequence = header.sequence;
+            m_slot     = slot;
+        }
+
+        if ((header.game == game) &&
+            (!foundGame || ((INT16) (header.sequence - gameSequence) > 0)))
+        {
+            foundGame    = true;
+            gameSequence = header.sequence;
+            gameSlot     = slot;
+        }
+    }
+
+    if (foundGame)
+    {
+        EEPROM.get(slotAddress(gameSlot) + sizeof(SLOT_HEADER), m_stats);
+    }
+
+    m_game         = game;
+    m_dirty        = false;
+    m_firstFailure = false;
+    m_lastSaveTime = millis();
+}
+
+
+void
+CSoakStats::save(
+    bool force
+)
+{
+    if (!m_dirty)
+    {
+        return;
+    }
+
+    if (!force && !m_firstFailure && ((millis() - m_lastSaveTime) < s_saveIntervalMs))
+    {
+        return;
+    }
+
+    m_slot = (m_slot + 1) % slotCount();
+    m_sequence++;
+
+    {
+        SLOT_HEADER header = {s_slotMagic, m_sequence, m_game};
+        UINT16      address = slotAddress(m_slot);
+
+        EEPROM.put(address, header);
+        EEPROM.put(address + sizeof(SLOT_HEADER), m_stats);
+        EEPROM.put(address + SLOT_SIZE - sizeof(UINT32), slotCrc(m_slot));
+    }
+
+    m_dirty        = false;
+    m_firstFailure = false;
+    m_lastSaveTime = millis();
+}
+
+
+void
+CSoakStats::clear(
+)
+{
+    memset(m_stats, 0, sizeof(m_stats));
+    m_dirty = true;
+}
+
+
+void
+CSoakStats::record(
+    UINT8  selection,
+    UINT32 durationMs,
+    PERROR error
+)
+{
+    if (selection >= s_maxSelections)
+    {
+        return;
+    }
+
+    PSOAK_STATS stats = &m_stats[selection];
+
+    if ((stats->runs == 0) || (durationMs < stats->minMs))
+    {
+        stats->minMs = durationMs;
+    }
+
+    if (durationMs > stats->maxMs)
+    {
+        stats->maxMs = durationMs;
+    }
+
+    stats->runs++;
+    stats->totalMs += durationMs;
+
+    if (FAILED(error))
+    {
+        if (stats->failures == 0)
+        {
+            m_firstFailure = true;
+        }
+
+        if (stats->failures != 0xFFFF)
+        {
+            stats->failures++;
+        }
+
+        strncpy(stats->lastError, error->description, sizeof(stats->lastError));
+    }
+
+    m_dirty = true;
+}
+
+
+//
+// 0123456789abcdef
+// OK:R1234 F0
+// E:R1234 F3
+//
+PERROR
+CSoakStats::summary(
+)
+{
+    PERROR error = errorCustom;
+    UINT32 runs = 0;
+    UINT32 failures = 0;
+
+    for (UINT8 selection = 0 ; selection < s_maxSelections ; selection++)
+    {
+        runs     += m_stats[selection].runs;
+        failures += m_stats[selection].failures;
+    }
+
+    error->code = (failures == 0) ? ERROR_SUCCESS : ERROR_FAILED;
+    error->description = (failures == 0) ? "OK:R" : "E:R";
+    error->description += runs;
+    error->description += " F";
+    error->description += failures;
+
+    return error;
+}
+
+
+//
+// 0123456789abcdef
+// RAM Check All
+// E:R1234 F3
+// OK:A12 N10 X15s
+// E:RAM 1234 55 AA
+//
+PERROR
+CSoakStats::report(
+    const SELECTOR *selector,
+    UINT8          selection,
+    UINT8          page
+)
+{
+    PERROR error = errorCustom;
+    const SOAK_STATS *stats = &m_stats[selection];
+
+    error->code = ERROR_SUCCESS;
+
+    switch (page)
+    {
+        case 0 :
+        {
+            error->description = selector[selection].description;
+            break;
+        }
+
+        case 1 :
+        {
+            error->code = (stats->failures == 0) ? ERROR_SUCCESS : ERROR_FAILED;
+            error->description = (stats->failures == 0) ? "OK:R" : "E:R";
+            error->description += stats->runs;
+            error->description += " F";
+            error->description += stats->failures;
+            break;
+        }
+
+        case 2 :
+        {
+            if (stats->runs == 0)
+            {
+                error->description = "OK:No Runs";
+                break;
+            }
+
+            error->description = "OK:A";
+            error->description += (stats->totalMs / stats->runs) / 1000;
+            error->description += " N";
+            error->description += stats->minMs / 1000;
+            error->description += " X";
+            error->description += stats->maxMs / 1000;
+            error->description += "s";
+            break;
+        }
+
+        default :
+        {
+            CHAR lastError[sizeof(stats->lastError) + 1];
+
+            if (stats->failures == 0)
+            {
+                error->description = "OK:No Errors";
+                break;
+            }
+
+            memcpy(lastError, stats->lastError, sizeof(stats->lastError));
+            lastError[sizeof(stats->lastError)] = '\0';
+
+            error->code = ERROR_FAILED;
+            error->description = lastError;
+            break;
+        }
+    }
+
+    return error;
+}
+
+
+PERROR
+CSoakStats::exportSerial(
+    const SELECTOR *selector
+)
+{
+    PERROR error = errorCustom;
+    UINT8 selection;
+
+    ensureSerial();
+    Serial.println("selection,description,runs,failures,totalMs,minMs,maxMs,lastError");
+
+    for (selection = 0 ;
+         (selection < s_maxSelections) && (selector[selection].function != NULL) ;
+         selection++)
+    {
+        const SOAK_STATS *stats = &m_stats[selection];
+        CHAR lastError[sizeof(stats->lastError) + 1];
+
+        memcpy(lastError, stats->lastError, sizeof(stats->lastError));
+        lastError[sizeof(stats->lastError)] = '\0';
+
+        Serial.print(selection);
+        Serial.print(',');
+        Serial.print(selector[selection].description);
+        Serial.print(',');
+        Serial.print(stats->runs);
+        Serial.print(',');
+        Serial.print(stats->failures);
+        Serial.print(',');
+        Serial.print(stats->totalMs);
+        Serial.print(',');
+        Serial.print(stats->minMs);
+        Serial.print(',');
+        Serial.print(stats->maxMs);
+        Serial.print(',');
+        Serial.println(lastError);
+    }
+
+    Serial.flush();
+
+    error->code = ERROR_SUCCESS;
+    error->description = "OK:Sent ";
+    error->description += selection;
+
+    return error;
+}
+
+
+UINT16
+CSoakStats::slotCount(
+)
+{
+    return s_eepromLength / SLOT_SIZE;
+}
+
+
+UINT16
+CSoakStats::slotAddress(
+    UINT16 slot
+)
+{
+    return s_eepromBase + (slot * SLOT_SIZE);
+}
+
+
+UINT32
+CSoakStats::slotCrc(
+    UINT16 slot
+)
+{
+    UINT16 address = slotAddress(slot);
+    UINT32 crc = 0;
+
+    for (UINT16 offset = 0 ; offset < (SLOT_SIZE - sizeof(UINT32)) ; offset++)
+    {
+        UINT8 data = EEPROM.read(address + offset);
+
+        crc = crc32(crc, &data, sizeof(data));
+    }
+
+    return crc;
+}
+
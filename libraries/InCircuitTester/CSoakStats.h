@@ -0,0 +1,182 @@
+//
+// Copyright (c) 2021, Paul R. Swan
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+// OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR
+// TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+// EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+#ifndef CSoakStats_h
+#define CSoakStats_h
+
+#include "Arduino.h"
+#include "Types.h"
+#include "Error.h"
+
+//
+// Statistics of each selection run by the soak test.
+//
+typedef struct _SOAK_STATS {
+
+    UINT32 runs;
+    UINT16 failures;
+    UINT32 totalMs;
+    UINT32 minMs;
+    UINT32 maxMs;
+    CHAR   lastError[16];   // Not terminated.
+
+} SOAK_STATS, *PSOAK_STATS;
+
+//
+// Collects the per selection statistics of the soak test and keeps them in
+// EEPROM so an overnight soak survives a power blip.
+//
+// The statistics are saved as a whole snapshot appended to the next slot of
+// a ring of slots, each with a sequence number and CRC, and the newest valid
+// one is loaded on start up. Appending spreads the writes over all the slots
+// and a torn write (power lost mid save) only loses the latest snapshot.
+// To keep the cost (and the EEPROM wear) down a snapshot is only saved once
+// a minute, when forced or on the first failure of a selection. Later
+// failures wait for the next minute so a test that keeps failing doesn't
+// rewrite the EEPROM on every run.
+//
+// Each snapshot is tagged with the game it belongs to, the index in the game
+// list, so the selections of one game are never reported against another.
+//
+class CSoakStats
+{
+    public:
+
+        static const UINT8 s_maxSelections = 8;
+
+        //
+        // The game before one is selected.
+        //
+        static const UINT16 s_noGame = 0xFFFF;
+
+        CSoakStats(
+        );
+
+        //
+        // Load the newest valid snapshot of the game from EEPROM, or start
+        // empty if there isn't one.
+        //
+        void
+        load(
+            UINT16 game
+        );
+
+        //
+        // Save a snapshot if one is due, or always if forced and changed.
+        //
+        void
+        save(
+            bool force
+        );
+
+        void
+        clear(
+        );
+
+        //
+        // Add the result of one run of a selection.
+        //
+        void
+        record(
+            UINT8  selection,
+            UINT32 durationMs,
+            PERROR error
+        );
+
+        //
+        // Total runs & failures of all the selections.
+        //
+        PERROR
+        summary(
+        );
+
+        //
+        // The LCD view of a selection, one of s_pages pages:
+        //  0 - the selection description.
+        //  1 - runs & failures.
+        //  2 - average, min & max duration in seconds.
+        //  3 - the last error.
+        //
+        static const UINT8 s_pages = 4;
+
+        PERROR
+        report(
+            const SELECTOR *selector,
+            UINT8          selection,
+            UINT8          page
+        );
+
+        //
+        // Write the statistics to the serial port as CSV.
+        //
+        PERROR
+        exportSerial(
+            const SELECTOR *selector
+        );
+
+    private:
+
+        UINT16
+        slotCount(
+        );
+
+        UINT16
+        slotAddress(
+            UINT16 slot
+        );
+
+        //
+        // The CRC of the slot stored in EEPROM, excluding the CRC itself.
+        //
+        UINT32
+        slotCrc(
+            UINT16 slot
+        );
+
+    private:
+
+        //
+        // The header of each slot in EEPROM, followed by the statistics
+        // and then the CRC.
+        //
+        typedef struct _SLOT_HEADER {
+
+            UINT16 magic;
+            UINT16 sequence;
+            UINT16 game;
+
+        } SLOT_HEADER;
+
+        SOAK_STATS m_stats[s_maxSelections];
+
+        UINT16     m_game;
+        UINT16     m_sequence;
+        UINT16     m_slot;
+        UINT32     m_lastSaveTime;
+        bool       m_dirty;
+        bool       m_firstFailure;
+
+};
+
+#endif
@@ -0,0 +1,118 @@
+//
+// Copyright (c) 2021, Paul R. Swan
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+// OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR
+// TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+// EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+#include "CToneBlock.h"
+
+
+CToneBlock::CToneBlock(
+) : m_count(0),
+    m_samples(0),
+    m_sum(0),
+    m_sumSq(0),
+    m_energy(0)
+{
+}
+
+
+void
+CToneBlock::begin(
+    const UINT16 *frequencyHz,
+    UINT8        count,
+    UINT16       sampleRateHz
+)
+{
+    m_count = (count > s_maxFrequencies) ? s_maxFrequencies : count;
+
+    for (UINT8 index = 0 ; index < m_count ; index++)
+    {
+        m_filter[index].begin(frequencyHz[index], sampleRateHz);
+    }
+
+    m_samples = 0;
+    m_sum     = 0;
+    m_sumSq   = 0;
+    m_energy  = 0;
+}
+
+
+//
+// Remove the DC bias to leave the AC energy, scaled to match power().
+//
+void
+CToneBlock::end(
+)
+{
+    if (m_samples != 0)
+    {
+        INT32 mean = m_sum / (INT32) m_samples;
+
+        m_energy = (m_sumSq - (UINT32) (mean * m_sum)) >> 8;
+    }
+}
+
+
+bool
+CToneBlock::quiet(
+)
+{
+    return (m_energy < ((s_quietVariance * m_samples) >> 8));
+}
+
+
+//
+// For a sine wave exactly at the frequency power() is N^2.A^2/(4*256) and the
+// energy N.A^2/(2*256) so the ratio is scaled by 200/N to give 100%.
+//
+UINT8
+CToneBlock::percent(
+    UINT8 index
+)
+{
+    UINT32 percent = 0;
+
+    if ((index < m_count) && (m_energy != 0))
+    {
+        percent = (m_filter[index].power() / m_samples) * 200 / m_energy;
+    }
+
+    return (percent > 100) ? 100 : (UINT8) percent;
+}
+
+
+UINT8
+CToneBlock::peak(
+)
+{
+    UINT8 peak = 0;
+
+    for (UINT8 index = 1 ; index < m_count ; index++)
+    {
+        if (m_filter[index].power() > m_filter[peak].power())
+        {
+            peak = index;
+        }
+    }
+
+    return peak;
+}
@@ -0,0 +1,123 @@
+//
+// Copyright (c) 2021, Paul R. Swan
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+// OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR
+// TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+// EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+#ifndef CToneBlock_h
+#define CToneBlock_h
+
+#include "CGoertzel.h"
+
+//
+// The analysis of one block of audio samples by CToneCheck. A bank of
+// streaming Goertzel filters is run along with the total signal energy so
+// each frequency is measured as a percentage of the whole.
+//
+// Plain C++ so recorded and synthetic sample streams can be checked on a
+// host (see test/CToneBlockTest.cpp). Samples are expected to be centred
+// on 0 within +/-256 and blocks no longer than 256 samples.
+//
+class CToneBlock
+{
+    public:
+
+        static const UINT8 s_maxFrequencies = 6;
+
+        CToneBlock(
+        );
+
+        //
+        // Clear the state for a new block of the supplied frequencies.
+        //
+        void
+        begin(
+            const UINT16 *frequencyHz,
+            UINT8        count,
+            UINT16       sampleRateHz
+        );
+
+        inline
+        void
+        sample(
+            INT16 x
+        )
+        {
+            for (UINT8 index = 0 ; index < m_count ; index++)
+            {
+                m_filter[index].sample(x);
+            }
+
+            m_sum   += x;
+            m_sumSq += (UINT32) ((INT32) x * x);
+            m_samples++;
+        };
+
+        //
+        // Complete the block after the last sample.
+        //
+        void
+        end(
+        );
+
+        //
+        // True if the block variance is too low to measure.
+        //
+        bool
+        quiet(
+        );
+
+        //
+        // The percentage of the signal energy at a measured frequency.
+        //
+        UINT8
+        percent(
+            UINT8 index
+        );
+
+        //
+        // The index of the measured frequency with the most energy.
+        //
+        UINT8
+        peak(
+        );
+
+        UINT8
+        count(
+        )
+        {
+            return m_count;
+        };
+
+    private:
+
+        static const UINT32 s_quietVariance = 4;
+
+        CGoertzel m_filter[s_maxFrequencies];
+        UINT8     m_count;
+        UINT16    m_samples;
+        INT32     m_sum;
+        UINT32    m_sumSq;
+        UINT32    m_energy;
+
+};
+
+#endif
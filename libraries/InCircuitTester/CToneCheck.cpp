@@ -0,0 +1,144 @@
+//
+// Copyright (c) 2021, Paul R. Swan
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+// OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR
+// TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+// EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+#include "CToneCheck.h"
+#include "PinMap.h"
+#include <DFR_Key.h>
+
+
+CToneCheck::CToneCheck(
+)
+{
+    pinMode(g_pinMap8Aux[1], INPUT);
+}
+
+
+//
+// The ADC result is centred and halved to keep the samples within the
+// filter's +/-256 range. Sampling is paced with micros() because analogRead()
+// takes ~112us of the 200us period, leaving enough for six filters. The
+// keypad's interrupt sampling of the ADC is paused meanwhile.
+//
+void
+CToneCheck::measure(
+    const UINT16 *frequencyHz,
+    UINT8        count
+)
+{
+    m_block.begin(frequencyHz, count, s_sampleRateHz);
+
+    UINT32 periodUs = 1000000UL / s_sampleRateHz;
+    UINT32 nextUs   = micros();
+
+    DFR_Key::pause();
+
+    for (UINT16 sample = 0 ; sample < s_samples ; sample++)
+    {
+        while ((INT32) (micros() - nextUs) < 0);
+        nextUs += periodUs;
+
+        m_block.sample((INT16) (analogRead(g_pinMap8Aux[1]) - 512) >> 1);
+    }
+
+    DFR_Key::resume();
+
+    m_block.end();
+}
+
+
+bool
+CToneCheck::quiet(
+)
+{
+    return m_block.quiet();
+}
+
+
+UINT8
+CToneCheck::percent(
+    UINT8 index
+)
+{
+    return m_block.percent(index);
+}
+
+
+UINT8
+CToneCheck::peak(
+)
+{
+    return m_block.peak();
+}
+
+
+//
+// 0123456789abcdef
+// E:AY2 A Quiet
+// E:AY2 A 1400 40%
+//
+PERROR
+CToneCheck::check(
+    const UINT16 *frequencyHz,
+    UINT8        count,
+    UINT8        expected,
+    const char   *label
+)
+{
+    PERROR error = errorSuccess;
+
+    measure(frequencyHz, count);
+
+    if (quiet())
+    {
+        error = errorCustom;
+        error->code = ERROR_FAILED;
+        error->description = "E:";
+        error->description += label;
+        error->description += " Quiet";
+    }
+    else
+    {
+        for (UINT8 index = 0 ; index < m_block.count() ; index++)
+        {
+            UINT8 measured = percent(index);
+
+            if (( (index == expected) && (measured < s_passPercent))   ||
+                ( (index != expected) && (measured > s_rejectPercent)))
+            {
+                error = errorCustom;
+                error->code = ERROR_FAILED;
+                error->description = "E:";
+                error->description += label;
+                error->description += " ";
+                error->description += frequencyHz[index];
+                error->description += " ";
+                error->description += measured;
+                error->description += "%";
+                break;
+            }
+        }
+    }
+
+    return error;
+}
@@ -0,0 +1,105 @@
+//
+// Copyright (c) 2021, Paul R. Swan
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+// OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR
+// TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+// EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+#ifndef CToneCheck_h
+#define CToneCheck_h
+
+#include "Arduino.h"
+#include "Types.h"
+#include "Error.h"
+#include "CToneBlock.h"
+
+//
+// Audio verification of sound board outputs using the ADC.
+//
+// The amplified sound output is connected to AUX1 (A8) via a DC blocking
+// capacitor and a resistor divider biased to mid-rail. A block of samples is
+// fed through a CToneBlock so each frequency is measured as a percentage of
+// the whole signal energy. No samples are stored.
+//
+class CToneCheck
+{
+    public:
+
+        static const UINT8  s_maxFrequencies = CToneBlock::s_maxFrequencies;
+        static const UINT16 s_sampleRateHz   = 5000;
+
+        CToneCheck(
+        );
+
+        //
+        // Sample the input and measure each of the supplied frequencies.
+        //
+        void
+        measure(
+            const UINT16 *frequencyHz,
+            UINT8        count
+        );
+
+        //
+        // True if the input variance is too low to measure.
+        //
+        bool
+        quiet(
+        );
+
+        //
+        // The percentage of the signal energy at a measured frequency.
+        //
+        UINT8
+        percent(
+            UINT8 index
+        );
+
+        //
+        // The index of the measured frequency with the most energy.
+        //
+        UINT8
+        peak(
+        );
+
+        //
+        // Measure and check that the expected frequency is dominant and
+        // the other frequencies are mostly absent. The label is at most
+        // 5 characters, e.g. "AY2 A".
+        //
+        PERROR
+        check(
+            const UINT16 *frequencyHz,
+            UINT8        count,
+            UINT8        expected,
+            const char   *label
+        );
+
+    private:
+
+        static const UINT16 s_samples        = 200;
+        static const UINT8  s_passPercent    = 50;
+        static const UINT8  s_rejectPercent  = 10;
+
+        CToneBlock m_block;
+
+};
+
+#endif
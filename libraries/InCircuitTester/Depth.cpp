@@ -0,0 +1,68 @@
+//
+// Copyright (c) 2021, Paul R. Swan
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+// OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR
+// TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+// EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+#include "Depth.h"
+
+//
+// Standard is the depth the tests have always run at.
+//
+const DEPTH_PROFILE g_depthProfiles[] = { // name        seeds cycles hold%  soak
+                                          { "Quick",     1,    2,     25,    15 },
+                                          { "Standard",  2,    8,     100,   0  },
+                                          { "Thorough",  4,    16,    200,   0  }
+                                        };
+
+const UINT8 g_numDepthProfiles = ARRAYSIZE(g_depthProfiles);
+
+const DEPTH_PROFILE *g_depthProfile = &g_depthProfiles[1];
+
+
+void
+appendDuration(
+    CDescription &string,
+    UINT32       timeInMs
+)
+{
+    UINT32 seconds = (timeInMs + 500) / 1000;
+
+    if (seconds < 60)
+    {
+        string += seconds;
+        string += "s";
+    }
+    else if (seconds < (60UL * 60))
+    {
+        string += (seconds / 60);
+        string += ((seconds % 60) < 10) ? "m0" : "m";
+        string += (seconds % 60);
+        string += "s";
+    }
+    else
+    {
+        string += (seconds / (60UL * 60));
+        string += (((seconds / 60) % 60) < 10) ? "h0" : "h";
+        string += ((seconds / 60) % 60);
+        string += "m";
+    }
+}
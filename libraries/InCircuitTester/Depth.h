@@ -0,0 +1,79 @@
+//
+// Copyright (c) 2021, Paul R. Swan
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+// OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR
+// TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+// EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+#ifndef Depth_h
+#define Depth_h
+
+#include "Arduino.h"
+#include "Types.h"
+
+
+//
+// A test depth profile scales how hard the long running tests work so that
+// a bench operator can pick one that fits the time they have.
+//
+typedef struct _DEPTH_PROFILE {
+
+    PCSTR  name;
+
+    //
+    // The number of random seeds the RAM check runs on each region.
+    //
+    UINT8  ramSeeds;
+
+    //
+    // The number of cycles the RAM random access check runs on each region.
+    //
+    UINT8  ramAccessCycles;
+
+    //
+    // The percentage the RAM retention delays are scaled by.
+    //
+    UINT16 ramHoldPercent;
+
+    //
+    // The time the soak test runs for, 0 runs until stopped.
+    //
+    UINT16 soakMinutes;
+
+} DEPTH_PROFILE, *PDEPTH_PROFILE;
+
+//
+// The profiles, Quick, Standard & Thorough, and the one in use.
+//
+
+extern const DEPTH_PROFILE g_depthProfiles[];
+extern const UINT8         g_numDepthProfiles;
+extern const DEPTH_PROFILE *g_depthProfile;
+
+//
+// Append a run time as e.g. "45s", "12m05s" or "3h20m".
+//
+void
+appendDuration(
+    CDescription &string,
+    UINT32       timeInMs
+);
+
+#endif
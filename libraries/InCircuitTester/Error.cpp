@@ -31,11 +31,13 @@ static const ERROR s_errorSuccess          = { 0x0000, "OK!             " };
 static const ERROR s_errorNotImplemented   = { 0x0001, "E:Not Impl.     " };
 static const ERROR s_errorUnexpected       = { 0x0002, "E:Unexpected    " };
 static const ERROR s_errorTimeout          = { 0x0003, "E:Timeout       " };
+static const ERROR s_errorAborted          = { 0x0004, "E:Aborted       " };
 
 PERROR errorSuccess        = (PERROR) &s_errorSuccess;
 PERROR errorNotImplemented = (PERROR) &s_errorNotImplemented;
 PERROR errorUnexpected     = (PERROR) &s_errorUnexpected;
 PERROR errorTimeout        = (PERROR) &s_errorTimeout;
+PERROR errorAborted        = (PERROR) &s_errorAborted;
 
 //
 // Programmable error.
@@ -43,3 +45,160 @@ PERROR errorTimeout        = (PERROR) &s_errorTimeout;
 static ERROR s_errorCustom = { 0, "" };
 PERROR errorCustom         = &s_errorCustom;
 
+//
+// Abort request from the keypad.
+//
+volatile bool g_abortRequested = false;
+
+
+CDescription::CDescription(
+    PCSTR text
+) : m_length(0)
+{
+    m_text[0] = '\0';
+    *this += text;
+}
+
+
+CDescription&
+CDescription::operator=(
+    PCSTR text
+)
+{
+    m_length = 0;
+    m_text[0] = '\0';
+
+    return (*this += text);
+}
+
+
+CDescription&
+CDescription::operator=(
+    const String &text
+)
+{
+    return (*this = text.c_str());
+}
+
+
+CDescription&
+CDescription::operator+=(
+    PCSTR text
+)
+{
+    while ((*text != '\0') && (m_length < s_capacity))
+    {
+        m_text[m_length++] = *text++;
+    }
+
+    m_text[m_length] = '\0';
+
+    return *this;
+}
+
+
+CDescription&
+CDescription::operator+=(
+    const String &text
+)
+{
+    return (*this += text.c_str());
+}
+
+
+CDescription&
+CDescription::operator+=(
+    char value
+)
+{
+    CHAR text[2] = {value, '\0'};
+
+    return (*this += text);
+}
+
+
+CDescription&
+CDescription::operator+=(
+    unsigned char value
+)
+{
+    return (*this += (unsigned long) value);
+}
+
+
+CDescription&
+CDescription::operator+=(
+    int value
+)
+{
+    return (*this += (long) value);
+}
+
+
+CDescription&
+CDescription::operator+=(
+    unsigned int value
+)
+{
+    return (*this += (unsigned long) value);
+}
+
+
+CDescription&
+CDescription::operator+=(
+    long value
+)
+{
+    if (value < 0)
+    {
+        *this += '-';
+        return (*this += (0UL - (unsigned long) value));
+    }
+
+    return (*this += (unsigned long) value);
+}
+
+
+CDescription&
+CDescription::operator+=(
+    unsigned long value
+)
+{
+    CHAR text[11];
+    UINT8 index = sizeof(text) - 1;
+
+    text[index] = '\0';
+
+    do
+    {
+        text[--index] = '0' + (value % 10);
+        value /= 10;
+    }
+    while (value != 0);
+
+    return (*this += &text[index]);
+}
+
+
+PCSTR
+formatHex(
+    CHAR   *buffer,
+    UINT32 value,
+    UINT8  digits
+)
+{
+    buffer[0] = ' ';
+
+    for (UINT8 index = digits ; index > 0 ; index--)
+    {
+        UINT8 nibble = value & 0xF;
+
+        buffer[index] = (nibble < 10) ? ('0' + nibble) : ('a' + nibble - 10);
+        value >>= 4;
+    }
+
+    buffer[digits + 1] = '\0';
+
+    return buffer;
+}
+
@@ -37,6 +37,7 @@ extern PERROR errorSuccess;
 extern PERROR errorNotImplemented;
 extern PERROR errorUnexpected;
 extern PERROR errorTimeout;
+extern PERROR errorAborted;
 
 //
 // This error is intended to be a programmable one that returns specific status.
@@ -44,6 +45,13 @@ extern PERROR errorTimeout;
 
 extern PERROR errorCustom;
 
+//
+// Set by a key press to ask a long running test to stop. The test loops
+// poll it between blocks and return errorAborted.
+//
+
+extern volatile bool g_abortRequested;
+
 #define SUCCESS(e) (e->code == ERROR_SUCCESS)
 #define FAILED(e)  (e->code != ERROR_SUCCESS)
 
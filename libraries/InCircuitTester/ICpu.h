@@ -32,6 +32,12 @@ class ICpu
 {
     public:
 
+        //
+        // Games delete their CPU through this interface.
+        //
+        virtual ~ICpu(
+        ) {};
+
         //
         // Interrupt definitions. Most CPU's have an non-maskable & normal interrupt.
         // Additional less common interrupt sources are CPU specific with a general
@@ -52,6 +58,14 @@ class ICpu
             IRQ7
         } Interrupt;
 
+        //
+        // Bus definitions used to identify a logical bus line, e.g. A5 or D3.
+        //
+        typedef enum {
+            ADDRESS,
+            DATA
+        } Bus;
+
         //
         // Set the CPU pins into default idle/inactive state.
         //
@@ -115,6 +129,21 @@ class ICpu
             UINT16  *data
         ) = 0;
 
+        //
+        // Read one "data" byte from a memory "address" twice, first with the data
+        // bus pre-charged high and then pre-charged low. Bits that follow the
+        // pre-charge are not driven by anything and are returned set in "floating".
+        // Returns errorNotImplemented if the data bus can't be pre-charged, e.g.
+        // when it's multiplexed with the address.
+        //
+        virtual
+        PERROR
+        memoryReadFloating(
+            UINT32 address,
+            UINT16 *data,
+            UINT16 *floating
+        ) = 0;
+
         //
         // Write one "data" byte to a memory "address".
         // 8-bit access is always in the lower 8 bits.
@@ -151,6 +180,18 @@ class ICpu
             UINT16 *response
         ) = 0;
 
+        //
+        // Returns the probe connection for the logical "bit" of the address or data bus
+        // (e.g. A5 is ADDRESS bit 5, D3 is DATA bit 3) so that a bus fault can be reported
+        // against the physical pin. Multiplexed buses return the shared pin.
+        // NULL is returned if the bit is not directly connected to the probe.
+        //
+        virtual
+        const CONNECTION *
+        busConnection(
+            Bus   bus,
+            UINT8 bit
+        ) = 0;
 
 };
 
@@ -27,11 +27,18 @@
 
 #include "Arduino.h"
 #include "Error.h"
+#include "ICpu.h"
 
 class IGame
 {
     public:
 
+        //
+        // Games are deleted through this interface when another game is selected.
+        //
+        virtual ~IGame(
+        ) {};
+
         //
         // Set the CPU pins into default idle/inactive state.
         //
@@ -45,6 +52,21 @@ class IGame
         virtual PERROR busCheck(
         ) = 0;
 
+        //
+        // A quick smoke test of the board, cheapest checks first, that
+        // stops at the first failing chip.
+        //
+        virtual PERROR triage(
+        ) = 0;
+
+        //
+        // Predict the time one round of the soak test takes at the current
+        // test depth, from the region sizes and the measured bus cycle time.
+        //
+        virtual PERROR predictRunTime(
+            UINT32 *timeInMs
+        ) = 0;
+
         //
         // Performs a check of all the ROM.
         //
@@ -184,6 +206,19 @@ class IGame
             int key
         ) = 0;
 
+        //
+        // Invokes the game specific custom function at the index.
+        //
+        virtual PERROR customIndex(
+            int index
+        ) = 0;
+
+        //
+        // The CPU of the game, for raw bus access.
+        //
+        virtual ICpu *cpu(
+        ) = 0;
+
 };
 
 #endif
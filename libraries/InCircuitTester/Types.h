@@ -65,16 +65,66 @@ typedef const char *PCSTR;
 // System wide types.
 //
 
+//
+// Fixed size text of an error description, one LCD line plus terminator.
+// It appends like a String (integers in decimal) but never allocates and
+// anything past the 16th character is dropped. This keeps the error path
+// of a long soak test off the heap.
+//
+class CDescription
+{
+    public:
+
+        CDescription(
+            PCSTR text = ""
+        );
+
+        CDescription& operator=(PCSTR text);
+        CDescription& operator=(const String &text);
+
+        CDescription& operator+=(PCSTR text);
+        CDescription& operator+=(const String &text);
+        CDescription& operator+=(char value);
+        CDescription& operator+=(unsigned char value);
+        CDescription& operator+=(int value);
+        CDescription& operator+=(unsigned int value);
+        CDescription& operator+=(long value);
+        CDescription& operator+=(unsigned long value);
+
+        operator PCSTR() const { return m_text; }
+
+        UINT8 length() const { return m_length; }
+
+        static const UINT8 s_capacity = 16;
+
+    private:
+
+        UINT8 m_length;
+        CHAR  m_text[s_capacity + 1];
+};
+
 //
 // Representation of an error as a code plus description to print.
 //
 typedef struct _ERROR {
 
-    UINT16 code;
-    String description;
+    UINT16       code;
+    CDescription description;
 
 } ERROR, *PERROR;
 
+//
+// Format a value as a space followed by 'digits' lower case hex digits with
+// leading zeros into a buffer of at least 10 characters, returning it.
+// Higher digits than requested are dropped.
+//
+PCSTR
+formatHex(
+    CHAR   *buffer,
+    UINT32 value,
+    UINT8  digits
+);
+
 //
 // This is used as the call made based on a button selection.
 //
@@ -312,125 +362,22 @@ typedef struct _INTERRUPT_DEFINITION {
 
 
 //
-// Macro to format a UINT8 hex value into a string with leading zeros.
-// The Arduino String library does not appear to have an option to do this.
+// Macros to format a hex value into a string with leading zeros.
+// The Arduino String library does not appear to have an option to do this
+// so these all share the out-of-line formatter rather than expanding a
+// chain of String concatenations at every use.
 //
 
-#define STRING_UINT8_HEX(string, value)                     \
+#define STRING_HEX(string, value, digits)                   \
     {                                                       \
-        UINT8 value8 = (UINT8) value;                       \
-                                                            \
-        if (value8 <= 0xF)                                  \
-        {                                                   \
-            string += " 0" + String(value8, HEX);           \
-        }                                                   \
-        else                                                \
-        {                                                   \
-            string += " "  + String(value8, HEX);           \
-        }                                                   \
+        CHAR formatted[10];                                 \
+        string += formatHex(formatted, (value), (digits));  \
     }                                                       \
 
-//
-// Macro to format a UINT16 hex value into a string with leading zeros.
-// The Arduino String library does not appear to have an option to do this.
-//
-
-#define STRING_UINT16_HEX(string, value)                      \
-    {                                                         \
-        UINT16 value16 = (UINT16) value;                      \
-                                                              \
-        if (value16 <= 0xF)                                   \
-        {                                                     \
-            string += " 000" + String(value16, HEX);          \
-        }                                                     \
-        else if (value16 <= 0xFF)                             \
-        {                                                     \
-            string += " 00" + String(value16, HEX);           \
-        }                                                     \
-        else if (value16 <= 0xFFF)                            \
-        {                                                     \
-            string += " 0" + String(value16, HEX);            \
-        }                                                     \
-        else                                                  \
-        {                                                     \
-            string += " " + String(value16, HEX);             \
-        }                                                     \
-    }                                                         \
-
-//
-// Macro to format a UINT32 24-bit hex value into a string with leading zeros.
-// The Arduino String library does not appear to have an option to do this.
-//
-
-#define STRING_UINT32_24_HEX(string, value)                  \
-    {                                                        \
-        if (value <= 0xF)                                    \
-        {                                                    \
-            string += " 00000" + String(value, HEX);         \
-        }                                                    \
-        else if (value <= 0xFF)                              \
-        {                                                    \
-            string += " 0000" + String(value, HEX);          \
-        }                                                    \
-        else if (value <= 0xFFF)                             \
-        {                                                    \
-            string += " 000" + String(value, HEX);           \
-        }                                                    \
-        else if (value <= 0xFFFF)                            \
-        {                                                    \
-            string += " 00" + String(value, HEX);            \
-        }                                                    \
-        else if (value <= 0xFFFFF)                           \
-        {                                                    \
-            string += " 0" + String(value, HEX);             \
-        }                                                    \
-        else                                                 \
-        {                                                    \
-            string += " " + String((value & 0xFFFFFF), HEX); \
-        }                                                    \
-    }                                                        \
-
-
-//
-// Macro to format a UINT32 hex value into a string with leading zeros.
-// The Arduino String library does not appear to have an option to do this.
-//
-
-#define STRING_UINT32_HEX(string, value)               \
-    {                                                  \
-        if (value <= 0xF)                              \
-        {                                              \
-            string += " 0000000" + String(value, HEX); \
-        }                                              \
-        else if (value <= 0xFF)                        \
-        {                                              \
-            string += " 000000" + String(value, HEX);  \
-        }                                              \
-        else if (value <= 0xFFF)                       \
-        {                                              \
-            string += " 00000" + String(value, HEX);   \
-        }                                              \
-        else if (value <= 0xFFFF)                      \
-        {                                              \
-            string += " 0000" + String(value, HEX);    \
-        }                                              \
-        else if (value <= 0xFFFFF)                     \
-        {                                              \
-            string += " 000" + String(value, HEX);     \
-        }                                              \
-        else if (value <= 0xFFFFFF)                    \
-        {                                              \
-            string += " 00" + String(value, HEX);      \
-        }                                              \
-        else if (value <= 0xFFFFFFF)                   \
-        {                                              \
-            string += " 0" + String(value, HEX);       \
-        }                                              \
-        else                                           \
-        {                                              \
-            string += " " + String(value, HEX);        \
-        }                                              \
-    }                                                  \
+#define STRING_UINT8_HEX(string, value)      STRING_HEX(string, (UINT8)  (value), 2)
+#define STRING_UINT16_HEX(string, value)     STRING_HEX(string, (UINT16) (value), 4)
+#define STRING_UINT32_24_HEX(string, value)  STRING_HEX(string, (UINT32) (value), 6)
+#define STRING_UINT32_HEX(string, value)     STRING_HEX(string, (UINT32) (value), 8)
 
 //
 // Macro perform a CPU memory read and exit on error
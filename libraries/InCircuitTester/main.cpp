@@ -29,14 +29,29 @@
 #include <LiquidCrystal.h>
 #include <DFR_Key.h>
 #include <CGameCallback.h>
+#include "CLcdShadow.h"
+#include "CSoakStats.h"
+#include "CSoakScheduler.h"
+#include "Depth.h"
+#include "CEventStream.h"
+#include "CRemote.h"
 
 //
-// Basic LCD diplay object (in this case, Sain 16 x 2).
+// Basic LCD diplay object (in this case, Sain 16 x 2) that is drawn
+// through the shadow so that only changed characters are sent.
 //
-static LiquidCrystal lcd(8, 9, 4, 5, 6, 7);
+static LiquidCrystal lcdDisplay(8, 9, 4, 5, 6, 7);
+static CLcdShadow    lcd(lcdDisplay);
 
 //
-// Sain supplied keypad driver.
+// Progress characters cycled through in the status cell while a
+// selection is repeated.
+//
+static const CHAR s_progress[] = "-+*+";
+
+//
+// Sain supplied keypad driver, sampled from the ADC interrupt so that a
+// key press can abort a running test.
 //
 static DFR_Key keypad;
 
@@ -47,25 +62,54 @@ static DFR_Key keypad;
 static const UINT8 led = 13;
 
 //
-// This is the current selector.
+// This is the current selector. NULL selects the top level menu of the
+// config selector followed by the game selector, both read from PROGMEM.
 //
 static const SELECTOR *s_currentSelector;
 
 //
-// This is the game selector.
+// This is the game selector (in PROGMEM).
 //
-static SELECTOR *s_gameSelector;
+static const SELECTOR *s_gameSelector;
 
 //
 // This is the current selection.
 //
 static int s_currentSelection;
 
+//
+// The top level menu selection of the game that was last loaded, where
+// backing out of the game's menus returns to.
+//
+static int s_gameSelection;
+
+//
+// The number of config selections that precede the game selections in the
+// top level menu.
+//
+static int s_configSelections;
+
+//
+// The top level menu entry last read from PROGMEM and its selection.
+//
+static SELECTOR s_selectorCache;
+static int      s_selectorCacheSelection = -1;
+
 //
 // When true causes the soak test to run as soon as a game is selected.
 //
 bool s_runSoakTest;
 
+//
+// When true the soak test doesn't run the same selection twice in a row.
+//
+static bool s_soakInterleave;
+
+//
+// The soak test scheduler's seed, fixed so a soak is repeatable.
+//
+static const UINT32 s_soakSeed = 0x1C7;
+
 //
 // When set (none-zero) causes the select to repeat the selection callback
 // for the set number of seconds.
@@ -77,16 +121,111 @@ int s_repeatSelectTimeInS;
 //
 bool s_repeatIgnoreError;
 
+//
+// When true the start & end of each test is sent as an event over serial.
+//
+static bool s_eventStream;
+
+//
+// When true commands are accepted over serial to run tests remotely.
+//
+static bool s_remote;
+
+//
+// The per selection statistics of the soak test, kept in EEPROM.
+//
+static CSoakStats s_soakStats;
+
+//
+// The soak statistics page shown, 0 is the summary followed by the pages
+// of each selection.
+//
+static int s_soakStatsPage;
+
 //
 // The selector used for the general tester configuration options.
 //
 static const SELECTOR s_configSelector[] PROGMEM = {//0123456789abcde
-                                                    {"- Soak Test    ",  onSelectConfig, (void*) (&s_runSoakTest),           false},
-                                                    {"- Set Repeat   ",  onSelectConfig, (void*) (&s_repeatSelectTimeInS),   false},
-                                                    {"- Set Error    ",  onSelectConfig, (void*) (&s_repeatIgnoreError),     false},
+                                                    {"- Soak Test    ",  onSelectConfig,    (void*) (&s_runSoakTest),           false},
+                                                    {"- Soak Order   ",  onSelectConfig,    (void*) (&s_soakInterleave),        false},
+                                                    {"- Test Depth   ",  onSelectConfig,    (void*) (&g_depthProfile),          false},
+                                                    {"- Set Repeat   ",  onSelectConfig,    (void*) (&s_repeatSelectTimeInS),   false},
+                                                    {"- Set Error    ",  onSelectConfig,    (void*) (&s_repeatIgnoreError),     false},
+                                                    {"- Event Stream ",  onSelectConfig,    (void*) (&s_eventStream),           false},
+                                                    {"- Remote Ctrl  ",  onSelectConfig,    (void*) (&s_remote),                false},
+                                                    {"- Soak Stats   ",  onSelectSoakStats, (void*) (&s_soakStats),             true},
+                                                    {"- Clear Stats  ",  onSelectConfig,    (void*) (&s_soakStats),             false},
                                                     { 0, 0 }
                                                    };
 
+//
+// Returns the entry of the current selector at the selection. Top level menu
+// entries are read from PROGMEM into the cache, so the entry is only valid
+// until the next call.
+//
+static const SELECTOR *
+selectorEntry(
+    int selection
+)
+{
+    if (s_currentSelector != NULL)
+    {
+        return &s_currentSelector[selection];
+    }
+
+    if (selection != s_selectorCacheSelection)
+    {
+        const SELECTOR *entry = (selection < s_configSelections) ?
+                                &s_configSelector[selection] :
+                                &s_gameSelector[selection - s_configSelections];
+
+        memcpy_P(&s_selectorCache, entry, sizeof(s_selectorCache));
+        s_selectorCacheSelection = selection;
+    }
+
+    return &s_selectorCache;
+}
+
+
+//
+// Handler for the remote control callback to select game n of the game
+// list. The game is selected from the top level menu as if by key so
+// backing out of its menus returns to it.
+//
+static PERROR
+onRemoteSelectGame(
+    UINT32 game
+)
+{
+    PERROR error = errorNotImplemented;
+    const SELECTOR *selector = s_currentSelector;
+    int selection = s_configSelections;
+
+    s_currentSelector = NULL;
+
+    // Step along the list so a game past its end isn't read.
+    for (UINT32 index = 0 ; (index < game) && (selectorEntry(selection)->function != NULL) ; index++)
+    {
+        selection++;
+    }
+
+    const SELECTOR *entry = selectorEntry(selection);
+
+    if (entry->function == NULL)
+    {
+        s_currentSelector = selector;
+    }
+    else
+    {
+        s_currentSelection = selection;
+
+        error = entry->function(entry->context, SELECT_KEY);
+    }
+
+    return error;
+}
+
+
 //
 // Handler for the configuration callback to set options.
 //
@@ -149,10 +288,106 @@ onSelectConfig(
         errorCustom->code = ERROR_SUCCESS;
     }
 
+    if (context == (void *) &s_soakInterleave)
+    {
+        if (s_soakInterleave == false)
+        {
+            s_soakInterleave = true;
+            errorCustom->description = "OK: Interleaved";
+        }
+        else
+        {
+            s_soakInterleave = false;
+            errorCustom->description = "OK: Weighted";
+        }
+
+        errorCustom->code = ERROR_SUCCESS;
+    }
+
+    if (context == (void *) &s_eventStream)
+    {
+        s_eventStream = !s_eventStream;
+        CEventStream::enable(s_eventStream);
+
+        errorCustom->description = s_eventStream ? "OK: Events on" : "OK: Events off";
+        errorCustom->code = ERROR_SUCCESS;
+    }
+
+    if (context == (void *) &s_remote)
+    {
+        s_remote = !s_remote;
+        CRemote::enable(s_remote, onRemoteSelectGame);
+
+        errorCustom->description = s_remote ? "OK: Remote on" : "OK: Remote off";
+        errorCustom->code = ERROR_SUCCESS;
+    }
+
+    if (context == (void *) &g_depthProfile)
+    {
+        if (++g_depthProfile == &g_depthProfiles[g_numDepthProfiles])
+        {
+            g_depthProfile = &g_depthProfiles[0];
+        }
+
+        errorCustom->description = "OK: ";
+        errorCustom->description += g_depthProfile->name;
+        errorCustom->code = ERROR_SUCCESS;
+    }
+
+    if (context == (void *) &s_soakStats)
+    {
+        s_soakStats.clear();
+        s_soakStats.save(true);
+
+        errorCustom->code = ERROR_SUCCESS;
+        errorCustom->description = "OK: Cleared";
+    }
+
     return error;
 }
 
 
+//
+// Handler for the soak statistics view. UP & DOWN step through the summary
+// and the pages of each soak test selection, SELECT exports them to serial.
+//
+PERROR
+onSelectSoakStats(
+    void *context,
+    int  key
+)
+{
+    CSoakStats *soakStats = (CSoakStats *) context;
+    const SELECTOR *selector = CGameCallback::selectorSoakTest;
+    int numPages = 1;
+
+    for (int selection = 0 ;
+         (selection < CSoakStats::s_maxSelections) && (selector[selection].function != NULL) ;
+         selection++)
+    {
+        numPages += CSoakStats::s_pages;
+    }
+
+    switch (key)
+    {
+        case NO_KEY     : { s_soakStatsPage = 0; break; }
+        case UP_KEY     : { s_soakStatsPage = (s_soakStatsPage + numPages - 1) % numPages; break; }
+        case DOWN_KEY   : { s_soakStatsPage = (s_soakStatsPage + 1) % numPages; break; }
+        case SELECT_KEY : { return soakStats->exportSerial(selector); }
+        default         : { break; }
+    }
+
+    if (s_soakStatsPage == 0)
+    {
+        return soakStats->summary();
+    }
+
+    return soakStats->report(selector,
+                             (s_soakStatsPage - 1) / CSoakStats::s_pages,
+                             (s_soakStatsPage - 1) % CSoakStats::s_pages);
+}
+
+
 //
 // Handler for the game select callback that will switch the current
 // game to the one supplied.
@@ -166,18 +401,18 @@ onSelectGameCallback(
 {
     PERROR error = errorSuccess;
     GameConstructor gameConstructor = (GameConstructor) context;
+    int freeBefore;
+
+    // Remember the game list entry to back out to.
+    if (s_currentSelector == NULL)
+    {
+        s_gameSelection = s_currentSelection;
+    }
 
     // Assign the new selector for the game
     s_currentSelector  = selector;
     s_currentSelection = 0;
 
-    // Free the game selector memory before we construct the game.
-    if (s_gameSelector != NULL)
-    {
-        free(s_gameSelector);
-        s_gameSelector = NULL;
-    }
-
     if (CGameCallback::game != NULL)
     {
         delete CGameCallback::game;
@@ -185,18 +420,24 @@ onSelectGameCallback(
     }
 
     // Construct the game object
+    freeBefore = freeMemory();
     CGameCallback::game = (IGame *) gameConstructor();
 
-    // After game construction check the free memory
+    s_soakStats.load((UINT16) (s_gameSelection - s_configSelections));
+
+    // After game construction show the free memory before and after
     {
         String description = " ";
 
+        description += freeBefore;
+        description += ">";
         description += freeMemory();
         description += "b free";
 
         lcd.clear();
         lcd.setCursor(0, 0);
         lcd.print(description);
+        lcd.update();
 
         delay(1000);
     }
@@ -246,7 +487,9 @@ onSelectGeneric(
 
 //
 // Handler for the soak test select callback that will run the soak test
-// for the current game forever (if no error occurs).
+// for the current game forever (if no error occurs, or errors are ignored)
+// until a key is pressed or the soak time of the test depth is up. The
+// result of each selection is recorded in the soak statistics.
 //
 PERROR
 onSelectSoakTest(
@@ -259,6 +502,9 @@ onSelectSoakTest(
     int numSelections = 0;
     int selection = 0;
     int loop = 1;
+    UINT32 lastTimeInMs = 0;
+    UINT32 soakStartTime = 0;
+    UINT32 soakTimeInMs = (UINT32) g_depthProfile->soakMinutes * 60 * 1000;
 
     //
     // Count up how many selections were provided.
@@ -268,35 +514,81 @@ onSelectSoakTest(
         numSelections++;
     }
 
+    CSoakScheduler scheduler(numSelections, s_soakInterleave, s_soakSeed);
+
     //
-    // Loop to execute selections in random order forever.
+    // Show the test depth and the predicted time of a round before starting.
     //
-    do
     {
-        String status = "* ";
+        CDescription description = "~";
+        UINT32 roundTimeInMs = 0;
 
-        //
-        // The random function seems to be averse to selecting 0
-        // so this adjusts the range to skew a bit more towards 0
-        //
-        selection = random(numSelections + 1);
-        if (selection != 0)
+        if (SUCCESS(CGameCallback::game->predictRunTime(&roundTimeInMs)))
         {
-            selection--;
+            appendDuration(description, roundTimeInMs);
+            description += " a round";
         }
 
+        lcd.clear();
+        lcd.setCursor(0, 0);
+        lcd.print("Soak ");
+        lcd.print(g_depthProfile->name);
+        lcd.setCursor(0, 1);
+        lcd.print((PCSTR) description);
+        lcd.update();
+
+        delay(2000);
+    }
+
+    soakStartTime = millis();
+
+    //
+    // Loop to execute selections in the scheduled order forever.
+    //
+    do
+    {
+        CDescription status = "* ";
+        UINT32 startTime;
+
+        selection = scheduler.next();
+
         lcd.clear();
         lcd.setCursor(0, 0);
         lcd.print(selector[selection].description);
 
+        //
+        // The loop count and the time taken by the last test.
+        //
         lcd.setCursor(0, 1);
         status += loop;
+        status += " ";
+        status += lastTimeInMs;
+        status += "ms";
         lcd.print(status);
+        lcd.status(s_progress[loop % (sizeof(s_progress) - 1)]);
+        lcd.update();
+
+        CEventStream::testStart(selector[selection].description);
+
+        startTime = millis();
 
         error = selector[selection].function(
                    selector[selection].context,
                    SELECT_KEY );
 
+        lastTimeInMs = millis() - startTime;
+
+        CEventStream::testEnd(selector[selection].description, error, lastTimeInMs);
+
+        if (error == errorNotImplemented)
+        {
+            scheduler.exclude();
+        }
+        else if (error != errorAborted)
+        {
+            scheduler.record(lastTimeInMs, FAILED(error));
+        }
+
         //
         // Some games may not implement all the selections so account for
         // not implemented errors as benign.
@@ -305,16 +597,26 @@ onSelectSoakTest(
         {
             error = errorSuccess;
         }
+        else if (error != errorAborted)
+        {
+            s_soakStats.record(selection, lastTimeInMs, error);
+            s_soakStats.save(false);
+        }
 
-        //
-        // The reset of the seed based on the loop count is done because the
-        // tests reset the random seed so on exit the result of "random" could
-        // select the same test again and cause the soak test to get stuck
-        // running one selection.
-        //
-        randomSeed(loop++);
+        loop++;
+    }
+    while ((s_repeatIgnoreError || SUCCESS(error)) &&
+           ((soakTimeInMs == 0) || ((millis() - soakStartTime) < soakTimeInMs)) &&
+           !g_abortRequested);
+
+    s_soakStats.save(true);
+
+    lcd.status('\0');
+
+    if (g_abortRequested && SUCCESS(error))
+    {
+        error = errorAborted;
     }
-    while (SUCCESS(error));
 
     //
     // If we get an error, leave the selector set and parked at the failing
@@ -332,39 +634,26 @@ void mainSetup(
     const SELECTOR *gameSelector
 )
 {
-    lcd.begin(16, 2);
-    lcd.clear();
+    lcd.begin();
     lcd.setCursor(0, 0);
     lcd.print("In Circuit Test");
+    lcd.update();
     pinMode(led, OUTPUT);
     digitalWrite(led, LOW);
 
     delay(2000);
 
     keypad.setRate(10);
+    keypad.begin(&g_abortRequested);
 
-    // Copy the PROGMEM based selectors into a single local SRAM selector
-    {
-        UINT16 uConfigRegionSize = 0;
-        UINT16 uConfigIndexCount = 0;
-
-        UINT16 uGameRegionSize   = 0;
-        UINT16 uGameIndexCount   = 0;
-
-        for ( ; pgm_read_word_near(&s_configSelector[uConfigIndexCount].function) != 0 ; uConfigIndexCount++) {}
-
-        for ( ; pgm_read_word_near(&gameSelector[uGameIndexCount].function) != 0 ; uGameIndexCount++) {}
+    // Find where the snapshot ring is up to, the statistics come with a game.
+    s_soakStats.load(CSoakStats::s_noGame);
 
-        uConfigRegionSize += sizeof(s_configSelector[0]) * uConfigIndexCount;
-        uGameRegionSize += sizeof(gameSelector[0]) * (uGameIndexCount+1); // +1 to include the null terminator.
+    // The top level menu is read from the PROGMEM selectors on demand.
+    for ( ; pgm_read_word_near(&s_configSelector[s_configSelections].function) != 0 ; s_configSelections++) {}
 
-        s_gameSelector = (PSELECTOR) malloc( uConfigRegionSize + uGameRegionSize );
-
-        memcpy_P( &s_gameSelector[0], s_configSelector, uConfigRegionSize );
-        memcpy_P( &s_gameSelector[uConfigIndexCount], gameSelector, uGameRegionSize );
-    }
-
-    s_currentSelector = s_gameSelector;
+    s_gameSelector    = gameSelector;
+    s_currentSelector = NULL;
 }
 
 void mainLoop()
@@ -386,9 +675,10 @@ void mainLoop()
         if ( (currentKey == SAMPLE_WAIT) ||
              (currentKey == previousKey) )
         {
-            digitalWrite(led, LOW);
-            delay(100);
-            digitalWrite(led, HIGH);
+            digitalWrite(led, ((millis() / 100) & 1) ? HIGH : LOW);
+
+            CEventStream::pump();
+            CRemote::poll();
 
             continue;
         }
@@ -403,15 +693,23 @@ void mainLoop()
                 {
                     s_currentSelection--;
                 }
+                else if (s_currentSelector != NULL)
+                {
+                    // Back out of the game's menus to the game list.
+                    s_currentSelector  = NULL;
+                    s_currentSelection = s_gameSelection;
+                }
+
+                const SELECTOR *entry = selectorEntry(s_currentSelection);
 
                 lcd.clear();
                 lcd.setCursor(0, 0);
-                lcd.print(s_currentSelector[s_currentSelection].description);
+                lcd.print(entry->description);
 
-                if (s_currentSelector[s_currentSelection].subMenu)
+                if (entry->subMenu)
                 {
-                    PERROR error = s_currentSelector[s_currentSelection].function(
-                        s_currentSelector[s_currentSelection].context,
+                    PERROR error = entry->function(
+                        entry->context,
                         NO_KEY );
 
                     lcd.setCursor(0, 1);
@@ -423,19 +721,21 @@ void mainLoop()
 
             case RIGHT_KEY :
             {
-                if (s_currentSelector[s_currentSelection+1].function != NULL)
+                if (selectorEntry(s_currentSelection+1)->function != NULL)
                 {
                     s_currentSelection++;
                 }
 
+                const SELECTOR *entry = selectorEntry(s_currentSelection);
+
                 lcd.clear();
                 lcd.setCursor(0, 0);
-                lcd.print(s_currentSelector[s_currentSelection].description);
+                lcd.print(entry->description);
 
-                if (s_currentSelector[s_currentSelection].subMenu)
+                if (entry->subMenu)
                 {
-                    PERROR error = s_currentSelector[s_currentSelection].function(
-                        s_currentSelector[s_currentSelection].context,
+                    PERROR error = entry->function(
+                        entry->context,
                         NO_KEY );
 
                     lcd.setCursor(0, 1);
@@ -448,13 +748,16 @@ void mainLoop()
             case UP_KEY     :
             case DOWN_KEY   :
             {
-                if (s_currentSelector[s_currentSelection].subMenu)
+                const SELECTOR *entry = selectorEntry(s_currentSelection);
+
+                if (entry->subMenu)
                 {
                     lcd.setCursor(0, 1);
                     lcd.print(BLANK_LINE_16);
+                    lcd.update();
 
-                    PERROR error = s_currentSelector[s_currentSelection].function(
-                                    s_currentSelector[s_currentSelection].context,
+                    PERROR error = entry->function(
+                                    entry->context,
                                     currentKey );
 
                     lcd.setCursor(0, 1);
@@ -469,26 +772,73 @@ void mainLoop()
                 unsigned long endTime = startTime + ((unsigned long) s_repeatSelectTimeInS * 1000);
                 const SELECTOR *inSelector = s_currentSelector;
                 PERROR error = errorSuccess;
+                UINT32 repeat = 0;
 
                 lcd.setCursor(0, 1);
                 lcd.print(BLANK_LINE_16);
+                lcd.update();
+
+                g_abortRequested = false;
 
                 do {
 
-                    error = s_currentSelector[s_currentSelection].function(
-                               s_currentSelector[s_currentSelection].context,
-                               currentKey );
+                    const SELECTOR *entry = selectorEntry(s_currentSelection);
+
+                    //
+                    // Show the progress of a repeat in the status cell.
+                    //
+                    if (repeat++ > 0)
+                    {
+                        lcd.status(s_progress[repeat % (sizeof(s_progress) - 1)]);
+                    }
+
+                    //
+                    // Only the game's selections are tests to report.
+                    //
+                    if (inSelector != NULL)
+                    {
+                        UINT32 runStartTime = millis();
+
+                        CEventStream::testStart(entry->description);
+
+                        error = entry->function(
+                                   entry->context,
+                                   currentKey );
+
+                        CEventStream::testEnd(entry->description, error, millis() - runStartTime);
+                    }
+                    else
+                    {
+                        error = entry->function(
+                                   entry->context,
+                                   currentKey );
+                    }
                 }
                 while ( (s_repeatIgnoreError || SUCCESS(error)) &&  // Ignoring or no failures
                         (millis() < endTime)                    &&  // Times not up.
-                        (inSelector != s_gameSelector) );           // The input selector wasn't the game selector.
+                        (inSelector != NULL)                    &&  // The input selector wasn't the game list.
+                        !g_abortRequested );                        // No key pressed to stop.
+
+                //
+                // The key that aborted the test isn't also used to navigate.
+                //
+                if (g_abortRequested)
+                {
+                    keypad.flush();
+
+                    if (SUCCESS(error))
+                    {
+                        error = errorAborted;
+                    }
+                }
 
                 //
                 // The selection may have changed so update the whole display.
                 //
+                lcd.status('\0');
                 lcd.clear();
                 lcd.setCursor(0, 0);
-                lcd.print(s_currentSelector[s_currentSelection].description);
+                lcd.print(selectorEntry(s_currentSelection)->description);
 
                 lcd.setCursor(0, 1);
                 lcd.print(error->description);
@@ -497,6 +847,8 @@ void mainLoop()
             default : { break; };
         }
 
+        lcd.update();
+
         previousKey = currentKey;
 
     } while (1);
@@ -46,6 +46,15 @@ onSelectConfig(
     int  key
 );
 
+//
+// Handler for the soak test statistics view.
+//
+PERROR
+onSelectSoakStats(
+    void *context,
+    int  key
+);
+
 
 //
 // Handler for the game select callback that will switch the current
@@ -69,7 +78,8 @@ onSelectGeneric(
 
 //
 // Handler for the soak test select callback that will run the soak test
-// for the current game forever (if no error occurs).
+// for the current game forever (if no error occurs, or errors are ignored)
+// until a key is pressed.
 //
 PERROR
 onSelectSoakTest(
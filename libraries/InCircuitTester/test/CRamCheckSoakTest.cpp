@@ -0,0 +1,198 @@
+//
+// Copyright (c) 2021, Paul R. Swan
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+// OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR
+// TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+// EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//
+// Host soak of the error formatting path, e.g.
+//
+//   make -C libraries/InCircuitTester/test soak
+//
+// CRamCheck is run over and over on a 1KB RAM with a stuck data bit on every
+// other pass, so half of the passes fail through the value check macros.
+// The run lasts the given number of hours of simulated board time (default
+// 24), where every bus access takes s_usPerAccess, and fails if anything was
+// allocated from the heap after the first pass.
+//
+#include "CRamCheck.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+extern unsigned long g_stubMicros;
+
+//
+// A fast bus access for the Mega, so a simulated run is if anything more
+// passes than the board would manage in the same time.
+//
+static const unsigned long s_usPerAccess = 2;
+
+//
+// Heap allocations, counted by wrapping malloc & realloc at link time.
+//
+static unsigned long s_allocations;
+
+extern "C" void *__real_malloc(size_t size);
+extern "C" void *__real_realloc(void *pointer, size_t size);
+
+extern "C" void *__wrap_malloc(size_t size)                { s_allocations++; return __real_malloc(size); }
+extern "C" void *__wrap_realloc(void *pointer, size_t size) { s_allocations++; return __real_realloc(pointer, size); }
+
+void *operator new(size_t size)   { s_allocations++; return __real_malloc(size); }
+void *operator new[](size_t size) { s_allocations++; return __real_malloc(size); }
+void operator delete(void *pointer) noexcept           { free(pointer); }
+void operator delete[](void *pointer) noexcept         { free(pointer); }
+void operator delete(void *pointer, size_t) noexcept   { free(pointer); }
+void operator delete[](void *pointer, size_t) noexcept { free(pointer); }
+
+//
+// 1KB of RAM with an optional stuck high data bit at one address.
+//
+class CFakeCpu : public ICpu
+{
+    public:
+
+        CFakeCpu(
+        ) : m_faultAddress(0),
+            m_faultMask(0)
+        {
+            memset(m_ram, 0, sizeof(m_ram));
+        };
+
+        virtual PERROR idle() { return errorSuccess; };
+        virtual PERROR check() { return errorSuccess; };
+        virtual UINT8 dataBusWidth(UINT32 address) { return 1; };
+        virtual UINT8 dataAccessWidth(UINT32 address) { return 1; };
+
+        virtual PERROR memoryRead(
+            UINT32 address,
+            UINT16 *data
+        )
+        {
+            g_stubMicros += s_usPerAccess;
+
+            *data = m_ram[address & 0x3FF];
+
+            if ((address & 0x3FF) == m_faultAddress)
+            {
+                *data |= m_faultMask;
+            }
+
+            return errorSuccess;
+        };
+
+        virtual PERROR memoryReadFloating(
+            UINT32 address,
+            UINT16 *data,
+            UINT16 *floating
+        )
+        {
+            *floating = 0;
+            return memoryRead(address, data);
+        };
+
+        virtual PERROR memoryWrite(
+            UINT32 address,
+            UINT16 data
+        )
+        {
+            g_stubMicros += s_usPerAccess;
+
+            m_ram[address & 0x3FF] = (UINT8) data;
+
+            return errorSuccess;
+        };
+
+        virtual PERROR waitForInterrupt(Interrupt interrupt, bool active, UINT32 timeoutInMs) { return errorSuccess; };
+        virtual PERROR acknowledgeInterrupt(UINT16 *response) { return errorSuccess; };
+        virtual const CONNECTION *busConnection(Bus bus, UINT8 bit) { return NULL; };
+
+        UINT32 m_faultAddress;
+        UINT8  m_faultMask;
+
+    private:
+
+        UINT8 m_ram[0x400];
+};
+
+static const RAM_REGION s_ramRegion[] = { {NO_BANK_SWITCH, 0x0000, 0x03FF, 1, 0xFF, "1A", "Prog"},
+                                          {0} };
+
+static const RAM_REGION s_noRegion[] = { {0} };
+
+
+int
+main(
+    int argc,
+    char *argv[]
+)
+{
+    double hours = (argc > 1) ? atof(argv[1]) : 24.0;
+    unsigned long long endMicros = (unsigned long long) (hours * 3600.0 * 1000000.0);
+    unsigned long long simulatedMicros = 0;
+    unsigned long passes = 0;
+    unsigned long failures = 0;
+    unsigned long allocations = 0;
+    char lastError[CDescription::s_capacity + 1] = "";
+    clock_t start = clock();
+
+    CFakeCpu cpu;
+    CRamCheck ramCheck(&cpu, NO_DELAY_FUNCTION, s_ramRegion, s_noRegion, s_noRegion, NULL);
+
+    //
+    // Anything allocated on the first pass, e.g. a static, isn't growth.
+    //
+    (void) ramCheck.check();
+    allocations = s_allocations;
+
+    while (simulatedMicros < endMicros)
+    {
+        unsigned long before = g_stubMicros;
+        PERROR error;
+
+        cpu.m_faultAddress = passes % 0x400;
+        cpu.m_faultMask    = (passes & 1) ? (1 << (passes % 8)) : 0;
+
+        error = ramCheck.check();
+
+        if (FAILED(error))
+        {
+            failures++;
+            snprintf(lastError, sizeof(lastError), "%s", (PCSTR) error->description);
+        }
+
+        simulatedMicros += (unsigned long) (g_stubMicros - before);
+        passes++;
+    }
+
+    allocations = s_allocations - allocations;
+
+    printf("%.1f simulated hours, %lu passes, %lu failures, %lu allocations, last \"%s\", %.0fs\n",
+           (double) simulatedMicros / 3600e6,
+           passes,
+           failures,
+           allocations,
+           lastError,
+           (double) (clock() - start) / CLOCKS_PER_SEC);
+
+    return (allocations == 0) && (failures == (passes / 2)) ? 0 : 1;
+}
@@ -0,0 +1,348 @@
+//
+// Copyright (c) 2021, Paul R. Swan
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+// OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR
+// TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+// EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//
+// Host test of the CToneCheck block analysis, e.g.
+//
+//   make -C libraries/InCircuitTester/test
+//
+// Synthetic blocks are always checked. Recorded blocks can be added on the
+// command line as pairs of the expected frequency and a text file of raw ADC
+// readings (0 -> 1023) taken at the tone check sample rate:
+//
+//   CToneBlockTest 1100 ay2-b.txt
+//
+// A recorded block is measured against the AY-3-8910 audio check bank with
+// the expected frequency added if it's not already in it.
+//
+#include "CToneBlock.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+//
+// These match CToneCheck (s_sampleRateHz, s_samples, s_passPercent and
+// s_rejectPercent).
+//
+static const UINT16 s_sampleRateHz  = 5000;
+static const UINT16 s_samples       = 200;
+static const UINT8  s_passPercent   = 50;
+static const UINT8  s_rejectPercent = 10;
+
+//
+// The AY-3-8910 audio check and Phoenix sound board tone banks.
+//
+static const UINT16 s_ayBankHz[]      = {800, 1100, 1500};
+static const UINT16 s_phoenixBankHz[] = {350, 500, 700, 1000, 1400, 2000};
+
+#define ARRAYSIZE(x) (sizeof(x) / sizeof(x[0]))
+
+typedef enum {
+    WAVE_SINE,
+    WAVE_SQUARE,
+    WAVE_SILENCE
+} Wave;
+
+static int s_failures = 0;
+
+
+//
+// The conversion from an ADC reading made by CToneCheck::measure().
+//
+static
+INT16
+fromAdc(
+    int adc
+)
+{
+    return (INT16) (adc - 512) >> 1;
+}
+
+
+//
+// An ADC reading of the wave biased to mid-rail with a small offset and a
+// little noise, as seen through the AUX1 divider.
+//
+static
+int
+syntheticAdc(
+    Wave   wave,
+    double frequencyHz,
+    int    amplitude,
+    UINT16 sample
+)
+{
+    double phase = (2.0 * M_PI * frequencyHz * sample) / s_sampleRateHz;
+    double value = 0.0;
+
+    if (wave == WAVE_SINE)
+    {
+        value = amplitude * sin(phase);
+    }
+    else if (wave == WAVE_SQUARE)
+    {
+        value = (sin(phase) >= 0.0) ? amplitude : -amplitude;
+    }
+
+    return 520 + (int) floor(value + 0.5) + ((rand() % 3) - 1);
+}
+
+
+static
+void
+measure(
+    CToneBlock   *block,
+    const UINT16 *bankHz,
+    UINT8        count,
+    Wave         wave,
+    double       frequencyHz,
+    int          amplitude
+)
+{
+    block->begin(bankHz, count, s_sampleRateHz);
+
+    for (UINT16 sample = 0 ; sample < s_samples ; sample++)
+    {
+        block->sample(fromAdc(syntheticAdc(wave, frequencyHz, amplitude, sample)));
+    }
+
+    block->end();
+}
+
+
+//
+// The same pass criteria as CToneCheck::check().
+//
+static
+bool
+passes(
+    CToneBlock *block,
+    UINT8      expected
+)
+{
+    if (block->quiet())
+    {
+        return false;
+    }
+
+    for (UINT8 index = 0 ; index < block->count() ; index++)
+    {
+        UINT8 measured = block->percent(index);
+
+        if (( (index == expected) && (measured < s_passPercent))   ||
+            ( (index != expected) && (measured > s_rejectPercent)))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+
+static
+void
+report(
+    const char   *name,
+    const UINT16 *bankHz,
+    CToneBlock   *block,
+    bool         ok
+)
+{
+    printf("%s %s:", ok ? "PASS" : "FAIL", name);
+
+    for (UINT8 index = 0 ; index < block->count() ; index++)
+    {
+        printf(" %u=%u%%", bankHz[index], block->percent(index));
+    }
+
+    printf("%s\n", block->quiet() ? " quiet" : "");
+
+    if (!ok)
+    {
+        s_failures++;
+    }
+}
+
+
+//
+// Each bank frequency played alone, as a sine and as the square wave
+// generated by the sound chips, must be the peak. If strict it must also
+// pass CToneCheck::check() with the others rejected. The Phoenix bank only
+// reports the peak as its square wave harmonics alias onto other bins, e.g.
+// the 3rd harmonic of 2000Hz (6000Hz) is seen at 1000Hz.
+//
+static
+void
+testBank(
+    const char   *bankName,
+    const UINT16 *bankHz,
+    UINT8        count,
+    bool         strict
+)
+{
+    static const Wave waves[] = {WAVE_SINE, WAVE_SQUARE};
+
+    for (UINT8 w = 0 ; w < ARRAYSIZE(waves) ; w++)
+    {
+        for (UINT8 expected = 0 ; expected < count ; expected++)
+        {
+            CToneBlock block;
+            char name[64];
+
+            measure(&block, bankHz, count, waves[w], bankHz[expected], 100);
+
+            snprintf(name, sizeof(name), "%s %s %u",
+                     bankName, (waves[w] == WAVE_SINE) ? "sine" : "square", bankHz[expected]);
+
+            report(name, bankHz, &block,
+                   (!strict || passes(&block, expected)) &&
+                   !block.quiet() && (block.peak() == expected));
+        }
+    }
+}
+
+
+//
+// A tone that's 10% off must not be mistaken for the bank frequency, which
+// is what a sound chip with a wrong divider looks like.
+//
+static
+void
+testDetuned(
+)
+{
+    CToneBlock block;
+
+    measure(&block, s_ayBankHz, ARRAYSIZE(s_ayBankHz), WAVE_SQUARE, s_ayBankHz[1] * 1.1, 100);
+
+    report("ay detuned 1210", s_ayBankHz, &block, !passes(&block, 1));
+}
+
+
+//
+// No signal (the amplifier off or the input disconnected) is quiet and a
+// full scale signal mustn't overflow the fixed-point state.
+//
+static
+void
+testLevels(
+)
+{
+    CToneBlock block;
+
+    measure(&block, s_ayBankHz, ARRAYSIZE(s_ayBankHz), WAVE_SILENCE, 0, 0);
+
+    report("ay silence", s_ayBankHz, &block, block.quiet());
+
+    measure(&block, s_phoenixBankHz, ARRAYSIZE(s_phoenixBankHz), WAVE_SQUARE, s_phoenixBankHz[0], 500);
+
+    report("phoenix full scale 350", s_phoenixBankHz, &block,
+           !block.quiet() && (block.peak() == 0) && (block.percent(0) >= s_passPercent));
+}
+
+
+static
+void
+testRecorded(
+    UINT16     expectedHz,
+    const char *path
+)
+{
+    UINT16 bankHz[CToneBlock::s_maxFrequencies];
+    UINT8  count    = 0;
+    UINT8  expected = 0xFF;
+    FILE   *file    = fopen(path, "r");
+    int    adc;
+
+    if (file == NULL)
+    {
+        printf("FAIL %s: can't open\n", path);
+        s_failures++;
+        return;
+    }
+
+    for (UINT8 index = 0 ; index < ARRAYSIZE(s_ayBankHz) ; index++)
+    {
+        if (s_ayBankHz[index] == expectedHz)
+        {
+            expected = count;
+        }
+
+        bankHz[count++] = s_ayBankHz[index];
+    }
+
+    if (expected == 0xFF)
+    {
+        expected = count;
+        bankHz[count++] = expectedHz;
+    }
+
+    CToneBlock block;
+    UINT16 samples = 0;
+
+    block.begin(bankHz, count, s_sampleRateHz);
+
+    while ((samples < s_samples) && (fscanf(file, "%d", &adc) == 1))
+    {
+        block.sample(fromAdc(adc));
+        samples++;
+    }
+
+    block.end();
+    fclose(file);
+
+    if (samples < s_samples)
+    {
+        printf("FAIL %s: only %u samples\n", path, samples);
+        s_failures++;
+        return;
+    }
+
+    report(path, bankHz, &block, passes(&block, expected));
+}
+
+
+int
+main(
+    int  argc,
+    char *argv[]
+)
+{
+    srand(1);
+
+    testBank("ay", s_ayBankHz, ARRAYSIZE(s_ayBankHz), true);
+    testBank("phoenix", s_phoenixBankHz, ARRAYSIZE(s_phoenixBankHz), false);
+    testDetuned();
+    testLevels();
+
+    for (int arg = 1 ; (arg + 1) < argc ; arg += 2)
+    {
+        testRecorded((UINT16) atoi(argv[arg]), argv[arg + 1]);
+    }
+
+    printf("%d failure(s)\n", s_failures);
+
+    return (s_failures == 0) ? 0 : 1;
+}
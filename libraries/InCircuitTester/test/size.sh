@@ -0,0 +1,76 @@
+#!/bin/bash
+#
+# Copyright (c) 2021, Paul R. Swan
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without modification,
+# are permitted provided that the following conditions are met:
+#
+# 1. Redistributions of source code must retain the above copyright notice,
+#    this list of conditions and the following disclaimer.
+#
+# 2. Redistributions in binary form must reproduce the above copyright notice,
+#    this list of conditions and the following disclaimer in the documentation
+#    and/or other materials provided with the distribution.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+# OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+# MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+# COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+# EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+# SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+# HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR
+# TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+# EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#
+#
+# Proxy flash size of each library, built for the host with g++ -Os against
+# the Arduino stubs in stub/ and summed from the text (code & constants) of each object, e.g.
+#
+#   ./size.sh                    - this tree
+#   ./size.sh /tmp/before        - another checkout, e.g. a git worktree
+#
+# The figures are only good for comparing two trees, the Mega image is built
+# by the IDE and measured with avr-size.
+#
+
+STUB=$(cd "$(dirname "$0")/stub" && pwd)
+ROOT=${1:-$(cd "$(dirname "$0")/../../.." && pwd)}
+LIBS=$ROOT/libraries
+OUT=$(mktemp -d)
+
+trap 'rm -rf "$OUT"' EXIT
+
+INCLUDES="-I$STUB"
+for lib in "$LIBS"/*/ ; do
+    INCLUDES="$INCLUDES -I$lib"
+done
+
+FLAGS="-Os -w -std=gnu++11 -fpermissive -DARDUINO=10813 $INCLUDES -include $STUB/Arduino.h"
+
+TOTAL=0
+
+for lib in "$LIBS"/*/ ; do
+    name=$(basename "$lib")
+
+    # Third party code that the series doesn't touch.
+    case $name in
+        DFR_Key|MemoryFree|crc32) continue ;;
+    esac
+
+    size=0
+    for source in "$lib"*.cpp ; do
+        object=$OUT/$(basename "$source" .cpp).o
+        if g++ $FLAGS -c -o "$object" "$source" 2> /dev/null ; then
+            text=$(size "$object" | awk 'NR == 2 { print $1 }')
+            size=$((size + text))
+        else
+            echo "$name: $(basename "$source") didn't build" >&2
+        fi
+    done
+
+    printf "%-16s %8d\n" "$name" "$size"
+    TOTAL=$((TOTAL + size))
+done
+
+printf "%-16s %8d\n" "total" "$TOTAL"
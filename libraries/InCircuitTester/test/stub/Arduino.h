@@ -0,0 +1,115 @@
+//
+// Copyright (c) 2021, Paul R. Swan
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+// OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR
+// TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+// EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//
+// Host stand-in for the Arduino core, just enough for the tester libraries to
+// compile and for the host tests to link with ArduinoStub.cpp. The AVR port
+// and ADC registers are plain variables.
+//
+#ifndef Arduino_h
+#define Arduino_h
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include <stdlib.h>
+#include <math.h>
+#include <ctype.h>
+#include "avr/pgmspace.h"
+#include "avr/interrupt.h"
+typedef uint8_t byte; typedef bool boolean;
+#define HIGH 1
+#define LOW 0
+#define INPUT 0
+#define OUTPUT 1
+#define INPUT_PULLUP 2
+#define DEC 10
+#define HEX 16
+#define BIN 2
+#define A0 54
+#define A8 62
+#define LED_BUILTIN 13
+#define NOT_A_PIN 0
+#define _BV(b) (1U<<(b))
+extern volatile uint8_t PINA,PINB,PINC,PIND,PINE,PINF,PING,PINH,PINJ,PINK,PINL;
+extern volatile uint8_t PORTA,PORTB,PORTC,PORTD,PORTE,PORTF,PORTG,PORTH,PORTJ,PORTK,PORTL;
+extern volatile uint8_t DDRA,DDRB,DDRC,DDRD,DDRE,DDRF,DDRG,DDRH,DDRJ,DDRK,DDRL;
+extern volatile uint8_t ADCSRA,ADCSRB,ADMUX,ADCL,ADCH,SREG,DIDR0,DIDR2,TIMSK0,TIFR0,TCCR0A,TCCR0B;
+extern volatile uint16_t ADC;
+#define ADEN 7
+#define ADSC 6
+#define ADATE 5
+#define ADIF 4
+#define ADIE 3
+#define ADPS2 2
+#define ADPS1 1
+#define ADPS0 0
+#define ADTS2 2
+#define ADTS1 1
+#define ADTS0 0
+#define MUX5 3
+#define REFS1 7
+#define REFS0 6
+#define ADLAR 5
+void pinMode(uint8_t,uint8_t); int digitalRead(uint8_t); void digitalWrite(uint8_t,uint8_t);
+int analogRead(uint8_t); unsigned long millis(); unsigned long micros(); void delay(unsigned long); void delayMicroseconds(unsigned int);
+long random(long); long random(long,long); void randomSeed(unsigned long);
+void noInterrupts(); void interrupts();
+uint8_t digitalPinToPort(uint8_t); uint8_t digitalPinToBitMask(uint8_t);
+volatile uint8_t* portOutputRegister(uint8_t); volatile uint8_t* portInputRegister(uint8_t); volatile uint8_t* portModeRegister(uint8_t);
+class __FlashStringHelper;
+#define F(s) (reinterpret_cast<const __FlashStringHelper*>(s))
+class String {
+ public:
+  String(const char* s=""); String(const String&); String(char c); String(const __FlashStringHelper*);
+  String(int,unsigned char base=10); String(unsigned int,unsigned char base=10); String(long,unsigned char base=10); String(unsigned long,unsigned char base=10);
+  String(unsigned char,unsigned char base=10);
+  ~String();
+  String& operator=(const String&); String& operator=(const char*);
+  String& operator+=(const String&); String& operator+=(const char*); String& operator+=(char);
+  String& operator+=(unsigned char); String& operator+=(int); String& operator+=(unsigned int); String& operator+=(long); String& operator+=(unsigned long);
+  String& operator+=(const __FlashStringHelper*);
+  friend String operator+(const String&, const String&);
+  friend String operator+(const String&, const char*);
+  friend String operator+(const String&, char);
+  friend String operator+(const String&, int);
+  friend String operator+(const String&, unsigned int);
+  friend String operator+(const String&, long);
+  friend String operator+(const String&, unsigned long);
+  friend String operator+(const String&, unsigned char);
+  unsigned int length() const; const char* c_str() const; char charAt(unsigned) const; char operator[](unsigned) const; char& operator[](unsigned);
+  void toCharArray(char*, unsigned) const; String substring(unsigned) const; String substring(unsigned,unsigned) const;
+  int indexOf(char) const; void trim(); void toUpperCase(); bool equals(const String&) const; bool operator==(const String&) const; bool operator==(const char*) const;
+  void reserve(unsigned); long toInt() const; bool startsWith(const String&) const;
+ private: char* b;
+};
+class Print { public:
+  size_t print(const char*); size_t print(const String&); size_t print(char); size_t print(int,int=DEC); size_t print(unsigned int,int=DEC); size_t print(long,int=DEC); size_t print(unsigned long,int=DEC); size_t print(unsigned char,int=DEC); size_t print(double,int=2); size_t print(const __FlashStringHelper*);
+  size_t println(const char*); size_t println(const String&); size_t println(char); size_t println(int,int=DEC); size_t println(unsigned int,int=DEC); size_t println(long,int=DEC); size_t println(unsigned long,int=DEC); size_t println(unsigned char,int=DEC); size_t println(const __FlashStringHelper*); size_t println();
+  virtual size_t write(uint8_t); size_t write(const char*); size_t write(const uint8_t*, size_t);
+};
+class Stream : public Print { public: int available(); int read(); int peek(); };
+class HardwareSerial : public Stream { public: void begin(unsigned long); void end(); int availableForWrite(); void flush(); operator bool(); };
+extern HardwareSerial Serial;
+#endif
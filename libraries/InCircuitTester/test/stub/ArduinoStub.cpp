@@ -0,0 +1,59 @@
+//
+// Copyright (c) 2021, Paul R. Swan
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+// OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR
+// TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+// EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//
+// Host stand-in for the parts of the Arduino core used by the host tests.
+// Time is simulated, it only moves when a test advances g_stubMicros, so
+// time based code sees the board's time rather than the host's.
+//
+#include "Arduino.h"
+
+HardwareSerial Serial;
+
+unsigned long g_stubMicros;
+
+unsigned long millis() { return g_stubMicros / 1000; }
+unsigned long micros() { return g_stubMicros; }
+void delay(unsigned long ms) { g_stubMicros += ms * 1000; }
+void delayMicroseconds(unsigned int us) { g_stubMicros += us; }
+
+static unsigned long s_random = 1;
+
+void randomSeed(unsigned long seed) { s_random = seed; }
+
+long random(long howBig)
+{
+    s_random = s_random * 1103515245UL + 12345UL;
+    return (howBig == 0) ? 0 : (long) ((s_random >> 8) % (unsigned long) howBig);
+}
+
+long random(long howSmall, long howBig) { return howSmall + random(howBig - howSmall); }
+
+void noInterrupts() {}
+void interrupts() {}
+
+size_t Print::write(uint8_t) { return 1; }
+size_t Print::write(const uint8_t *, size_t size) { return size; }
+
+const char *String::c_str() const { return ""; }
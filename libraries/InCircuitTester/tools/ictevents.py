@@ -0,0 +1,160 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) 2021, Paul R. Swan
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without modification,
+# are permitted provided that the following conditions are met:
+#
+# 1. Redistributions of source code must retain the above copyright notice,
+#    this list of conditions and the following disclaimer.
+#
+# 2. Redistributions in binary form must reproduce the above copyright notice,
+#    this list of conditions and the following disclaimer in the documentation
+#    and/or other materials provided with the distribution.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+# OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+# MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+# COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+# EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+# SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+# HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR
+# TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+# EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#
+"""
+Turn serial captures of the tester's event stream into one CSV file.
+
+The event lines (see CEventStream.h for the columns) are picked out of the
+captures, which may also hold remote control replies, soak statistics or
+partial lines from a reset. Each capture can be tagged with a bench name so
+the results of several benches can be combined, e.g.
+
+    ictevents.py -o results.csv bench1=monday.log bench2=monday2.log
+    ictevents.py --port /dev/ttyACM0 --bench bench1 -o live.csv
+
+Dropped events still use up a sequence number so they're counted from the
+gaps in the sequence, and a per test summary of runs & failures is written
+to stderr.
+"""
+
+import argparse
+import csv
+import os
+import sys
+
+COLUMNS = ["event", "seq", "ms", "test", "durationMs", "cycles", "code",
+           "location", "address", "expected", "received", "description"]
+EVENTS = "SED"
+
+
+def events(lines):
+    """The event lines of a capture as lists of the columns."""
+    for line in lines:
+        fields = line.rstrip("\r\n").split(",")
+        if (len(fields) != len(COLUMNS)) or (fields[0] not in EVENTS):
+            continue
+        try:
+            int(fields[1])
+            int(fields[2])
+        except ValueError:
+            continue
+        yield fields
+
+
+def port_lines(name, baud):
+    """The lines received on a serial port until interrupted."""
+    sys.path.insert(0, os.path.dirname(os.path.abspath(__file__)))
+    from ictremote import Port
+
+    port = Port(name, baud)
+    try:
+        while True:
+            line = port.readline(1.0)
+            if line is not None:
+                yield line
+    except KeyboardInterrupt:
+        pass
+    finally:
+        port.close()
+
+
+class Summary(object):
+
+    def __init__(self):
+        self.tests = {}
+        self.lost = 0
+
+    def add(self, bench, fields, previous):
+        seq = int(fields[1])
+        if (previous is not None) and (seq > previous + 1):
+            self.lost += seq - previous - 1
+        if fields[0] == "E":
+            runs, failures = self.tests.get((bench, fields[3]), (0, 0))
+            failed = fields[6] not in ("", "0")
+            self.tests[(bench, fields[3])] = (runs + 1, failures + (1 if failed else 0))
+        return seq
+
+    def write(self, out):
+        for (bench, test), (runs, failures) in sorted(self.tests.items()):
+            out.write("%s%s: %d runs, %d failed\n" %
+                      (bench + " " if bench else "", test, runs, failures))
+        if self.lost:
+            out.write("%d events lost\n" % self.lost)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.strip().splitlines()[0])
+    parser.add_argument("captures", nargs="*",
+                        help="capture files as [bench=]file, '-' for stdin")
+    parser.add_argument("--port", help="read live from a serial port instead")
+    parser.add_argument("--baud", type=int, default=115200)
+    parser.add_argument("--bench", default="", help="bench name for --port")
+    parser.add_argument("-o", "--output", help="CSV file (default stdout)")
+    args = parser.parse_args()
+
+    if not args.captures and not args.port:
+        parser.error("no captures or --port given")
+
+    out = open(args.output, "w", newline="") if args.output else sys.stdout
+    writer = csv.writer(out, lineterminator="\n")
+    writer.writerow(["bench"] + COLUMNS)
+    summary = Summary()
+
+    try:
+        sources = []
+        if args.port:
+            sources.append((args.bench, None))
+        for capture in args.captures:
+            bench, _, path = capture.rpartition("=")
+            sources.append((bench, path))
+
+        for bench, path in sources:
+            if path is None:
+                lines = port_lines(args.port, args.baud)
+            elif path == "-":
+                lines = sys.stdin
+            else:
+                lines = open(path, errors="replace")
+
+            previous = None
+            for fields in events(lines):
+                previous = summary.add(bench, fields, previous)
+                writer.writerow([bench] + fields)
+                out.flush()
+
+    except (IOError, OSError) as error:
+        sys.stderr.write("%s\n" % error)
+        return 2
+
+    finally:
+        if out is not sys.stdout:
+            out.close()
+
+    summary.write(sys.stderr)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,278 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) 2021, Paul R. Swan
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without modification,
+# are permitted provided that the following conditions are met:
+#
+# 1. Redistributions of source code must retain the above copyright notice,
+#    this list of conditions and the following disclaimer.
+#
+# 2. Redistributions in binary form must reproduce the above copyright notice,
+#    this list of conditions and the following disclaimer in the documentation
+#    and/or other materials provided with the distribution.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+# OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+# MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+# COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+# EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+# SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+# HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR
+# TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+# EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#
+"""
+Run a bench script against a tester with "Remote Ctrl" turned on.
+
+The script is one remote command per line (see CRemote.h), with '#'
+comments and blank lines ignored, e.g.
+
+    G 1f            # select game 0x1f of the game list
+    T 2             # run the 3rd selection of the game's menu
+    F 4000 400 55   # fill the RAM...
+    V 4000 400 55   # ...and verify it
+
+Commands are packed into packets of up to 127 characters and the next packet
+is only sent once the "." that ends the previous one is received, as the
+tester only has its 63 character receive buffer to hold what's sent while a
+packet runs. Each reply is matched to its command and the failures are
+listed. Any other lines, e.g. the event stream, are written to --log.
+
+Uses pyserial if it's installed, otherwise the port is opened directly
+(POSIX only). Opening the port resets most Megas so the script waits for
+the tester to answer, i.e. for "Remote Ctrl" to be turned on.
+
+Exit status is 0 if every command passed, 1 if any failed and 2 on a
+serial or script error.
+"""
+
+import argparse
+import os
+import re
+import sys
+import time
+
+MAX_PACKET = 127
+REPLY = re.compile(r"^([0-9A-Fa-f]+) ([0-9A-Fa-f]+)(?: (.*))?$")
+
+
+class Port(object):
+    """A line based serial port with a read timeout."""
+
+    def __init__(self, name, baud):
+        self.buffer = b""
+
+        try:
+            import serial
+            self.serial = serial.Serial(name, baud, timeout=0.1)
+            self.fd = None
+        except ImportError:
+            import termios
+            import tty
+            self.serial = None
+            self.fd = os.open(name, os.O_RDWR | os.O_NOCTTY)
+            tty.setraw(self.fd)
+            attrs = termios.tcgetattr(self.fd)
+            speed = getattr(termios, "B%d" % baud)
+            attrs[4] = attrs[5] = speed
+            termios.tcsetattr(self.fd, termios.TCSANOW, attrs)
+
+    def write(self, text):
+        data = text.encode("ascii")
+        if self.serial is not None:
+            self.serial.write(data)
+            self.serial.flush()
+        else:
+            while data:
+                data = data[os.write(self.fd, data):]
+
+    def _read(self, timeout):
+        if self.serial is not None:
+            self.serial.timeout = timeout
+            return self.serial.read(self.serial.in_waiting or 1)
+
+        import select
+        ready, _, _ = select.select([self.fd], [], [], timeout)
+        return os.read(self.fd, 256) if ready else b""
+
+    def readline(self, timeout):
+        """The next line without its line ending or None on a timeout."""
+        deadline = time.time() + timeout
+        while b"\n" not in self.buffer:
+            remaining = deadline - time.time()
+            if remaining <= 0:
+                return None
+            self.buffer += self._read(min(remaining, 0.1))
+        line, self.buffer = self.buffer.split(b"\n", 1)
+        return line.rstrip(b"\r").decode("ascii", "replace")
+
+    def close(self):
+        if self.serial is not None:
+            self.serial.close()
+        else:
+            os.close(self.fd)
+
+
+def load(path):
+    """The commands of a bench script as (line number, command) pairs."""
+    commands = []
+    with open(path) as script:
+        for number, line in enumerate(script, 1):
+            command = line.split("#", 1)[0].strip()
+            if not command:
+                continue
+            if ";" in command or len(command) > MAX_PACKET:
+                raise ValueError("%s:%d: bad command '%s'" % (path, number, command))
+            commands.append((number, command))
+    return commands
+
+
+def packets(commands):
+    """Pack the commands into packets of at most MAX_PACKET characters."""
+    packet = []
+    length = 0
+    for command in commands:
+        extra = len(command[1]) + (1 if packet else 0)
+        if packet and (length + extra > MAX_PACKET):
+            yield packet
+            packet = []
+            extra = len(command[1])
+            length = 0
+        packet.append(command)
+        length += extra
+    if packet:
+        yield packet
+
+
+class Bench(object):
+
+    def __init__(self, port, log, timeout):
+        self.port = port
+        self.log = log
+        self.timeout = timeout
+
+    def other(self, line):
+        if self.log is not None:
+            self.log.write(line + "\n")
+            self.log.flush()
+
+    def run(self, text):
+        """Send a packet and return its replies as (index, code, rest)."""
+        self.port.write(text + "\n")
+        replies = []
+        while True:
+            line = self.port.readline(self.timeout)
+            if line is None:
+                raise IOError("no reply to '%s'" % text)
+            if line == ".":
+                return replies
+            match = REPLY.match(line)
+            if match:
+                replies.append((int(match.group(1), 16),
+                                int(match.group(2), 16),
+                                match.group(3) or ""))
+            else:
+                self.other(line)
+
+    def sync(self, wait):
+        """Wait for the tester to answer & drain any queued probe replies."""
+        deadline = time.time() + wait
+        announced = False
+        while True:
+            self.port.write("X\n")
+            line = self.port.readline(1.0)
+            while line is not None and line != ".":
+                line = self.port.readline(0.2)
+            if line == ".":
+                break
+            if time.time() > deadline:
+                raise IOError("the tester didn't answer, is Remote Ctrl on?")
+            if not announced:
+                sys.stderr.write("Waiting for the tester, turn on Remote Ctrl...\n")
+                announced = True
+        while self.port.readline(0.5) is not None:
+            pass
+        self.run("X")
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.strip().splitlines()[0])
+    parser.add_argument("port", help="serial port, e.g. /dev/ttyACM0 or COM3")
+    parser.add_argument("script", help="bench script, one command per line")
+    parser.add_argument("--baud", type=int, default=115200)
+    parser.add_argument("--timeout", type=float, default=600.0,
+                        help="seconds to wait for a reply (default 600)")
+    parser.add_argument("--wait", type=float, default=60.0,
+                        help="seconds to wait for the tester to answer (default 60)")
+    parser.add_argument("--log", help="file for any other lines received")
+    parser.add_argument("--stop", action="store_true",
+                        help="stop at the first failing packet")
+    parser.add_argument("-v", "--verbose", action="store_true",
+                        help="show every reply, not just the failures")
+    args = parser.parse_args()
+
+    try:
+        commands = load(args.script)
+    except (IOError, ValueError) as error:
+        sys.stderr.write("%s\n" % error)
+        return 2
+
+    log = open(args.log, "a") if args.log else None
+    port = None
+    failures = 0
+    count = 0
+
+    try:
+        port = Port(args.port, args.baud)
+        bench = Bench(port, log, args.timeout)
+        bench.sync(args.wait)
+
+        start = time.time()
+
+        for packet in packets(commands):
+            replies = bench.run(";".join(command for _, command in packet))
+            answered = set()
+
+            for index, code, rest in replies:
+                if index >= len(packet):
+                    # e.g. "0 1 E:Overrun" for a packet with lost characters.
+                    index = 0
+                number, command = packet[index]
+                answered.add(index)
+                if code != 0:
+                    failures += 1
+                    print("%d: %s -> FAIL %s" % (number, command, rest))
+                elif args.verbose:
+                    print("%d: %s -> %s" % (number, command, rest))
+
+            for index, (number, command) in enumerate(packet):
+                if index not in answered:
+                    failures += 1
+                    print("%d: %s -> FAIL no reply" % (number, command))
+
+            count += len(packet)
+
+            if failures and args.stop:
+                break
+
+        elapsed = time.time() - start
+        print("%d commands, %d failed, %.1fs, %.0f commands/s" %
+              (count, failures, elapsed, count / elapsed if elapsed else 0))
+
+    except (IOError, OSError) as error:
+        sys.stderr.write("%s\n" % error)
+        return 2
+
+    finally:
+        if port is not None:
+            port.close()
+        if log is not None:
+            log.close()
+
+    return 1 if failures else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())